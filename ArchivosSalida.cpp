@@ -0,0 +1,145 @@
+#include "ArchivosSalida.h"
+#include "Etiquetas.h"
+#include "SalidaColumnar.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+/*
+  Crea la carpeta 'output' si no existe
+ */
+void crearCarpetaSalida() {
+    #ifdef _WIN32
+        system("mkdir output 2>nul || echo."); 
+    #else
+        system("mkdir -p output");
+    #endif
+}
+
+/*
+  Genera el nombre del archivo de salida
+  
+  Genera el nombre del archivo de salida basado en el archivo de entrada,
+  agregando el sufijo (si hay) y '_out' antes de la extension. No toca el
+  sistema de archivos, asi que se puede llamar desde cualquier hilo.
+ */
+std::string nombreArchivoSalida(const std::string& archivoEntrada, const std::string& sufijo) {
+    // Extraer solo el nombre del archivo sin directorio
+    std::string nombreArchivo = archivoEntrada;
+    size_t pos = nombreArchivo.find_last_of("\\/");
+    if (pos != std::string::npos) {
+        nombreArchivo = nombreArchivo.substr(pos + 1);
+    }
+    
+    // Cambiar la extension a _out.txt
+    std::string nombreSalida = "output/";
+    pos = nombreArchivo.find_last_of('.');
+    if (pos != std::string::npos) {
+        nombreSalida += nombreArchivo.substr(0, pos) + sufijo + "_out.txt";
+    } else {
+        nombreSalida += nombreArchivo + sufijo + "_out.txt";
+    }
+    
+    return nombreSalida;
+}
+
+/*
+  Genera el nombre del archivo de salida
+  
+  Crea la carpeta 'output' si no existe y genera el nombre del archivo
+  de salida basado en el archivo de entrada, agregando '_out' antes
+  de la extension.
+ */
+std::string generarNombreArchivoSalida(const std::string& archivoEntrada) {
+    crearCarpetaSalida();
+    return nombreArchivoSalida(archivoEntrada);
+}
+
+void escribirEncabezadoSalida(EscritorTexto& salida) {
+    salida.texto("# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n");
+}
+
+// WT=..;CT=..;RT=..;TAT=..; con un decimal
+void escribirPromediosSalida(EscritorTexto& salida, const AgregadorMetricas& metricas) {
+    double promWT, promCT, promRT, promTAT;
+    metricas.calcularPromedios(promWT, promCT, promRT, promTAT);
+    
+    salida.texto("WT=");
+    salida.decimal(promWT, 1);
+    salida.texto(";CT=");
+    salida.decimal(promCT, 1);
+    salida.texto(";RT=");
+    salida.decimal(promRT, 1);
+    salida.texto(";TAT=");
+    salida.decimal(promTAT, 1);
+    salida.texto(";\n");
+}
+
+/*
+  Escribe los resultados de una simulacion
+
+  Genera un archivo con el formato requerido:
+  - Header con los nombres de las columnas
+  - Una linea por cada proceso con sus metricas
+  - Linea final con los promedios
+  
+  Los procesos se ordenan alfabeticamente por etiqueta en el archivo.
+  Las etiquetas se internan y solo las distintas se ordenan como texto;
+  las filas se reparten despues por el rango de su etiqueta (ordenamiento
+  por conteo, estable), asi no se comparan textos por cada fila.
+ */
+bool escribirArchivoSalida(const std::string& rutaArchivo, const TablaProcesos& tabla,
+                           const std::pmr::vector<IdProceso>& finalizados, const AgregadorMetricas& metricas) {
+    std::ofstream archivo(rutaArchivo);
+    
+    if (!archivo.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << rutaArchivo << std::endl;
+        return false;
+    }
+    
+    // Id de la etiqueta de cada fila y rango alfabetico de cada id
+    TablaEtiquetas etiquetas;
+    std::vector<IdEtiqueta> etiquetaFila(finalizados.size());
+    for (std::size_t i = 0; i < finalizados.size(); i++) {
+        etiquetaFila[i] = etiquetas.internar(tabla.getEtiqueta(finalizados[i]));
+    }
+    std::vector<std::uint32_t> rangos = etiquetas.calcularRangos();
+    
+    // Donde empieza cada rango en la salida
+    std::vector<std::size_t> inicioRango(etiquetas.tamano() + 1, 0);
+    for (IdEtiqueta id : etiquetaFila) {
+        inicioRango[rangos[id] + 1]++;
+    }
+    for (std::size_t r = 1; r < inicioRango.size(); r++) {
+        inicioRango[r] += inicioRango[r - 1];
+    }
+    std::vector<IdProceso> procesosOrdenados(finalizados.size());
+    for (std::size_t i = 0; i < finalizados.size(); i++) {
+        procesosOrdenados[inicioRango[rangos[etiquetaFila[i]]]++] = finalizados[i];
+    }
+    
+    EscritorTexto salida(archivo);
+    escribirEncabezadoSalida(salida);
+    for (IdProceso id : procesosOrdenados) {
+        tabla.escribirLinea(salida, id);
+    }
+    escribirPromediosSalida(salida, metricas);
+    return true;
+}
+
+bool escribirArchivoColumnar(const std::string& rutaArchivo, const TablaProcesos& tabla,
+                             const std::pmr::vector<IdProceso>& finalizados) {
+    EscritorColumnar columnas(rutaArchivo);
+    if (!columnas.abierto()) {
+        std::cerr << "Error al abrir el archivo columnar: " << rutaArchivo << std::endl;
+        return false;
+    }
+    for (IdProceso id : finalizados) {
+        columnas.agregar(tabla, id);
+    }
+    if (!columnas.terminar()) {
+        std::cerr << "Error al escribir el archivo columnar: " << rutaArchivo << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef ARCHIVOSSALIDA_H
+#define ARCHIVOSSALIDA_H
+
+#include "TablaProcesos.h"
+#include "Metricas.h"
+#include "EscritorTexto.h"
+#include <string>
+#include <memory_resource>
+#include <vector>
+
+// Crea la carpeta 'output' si no existe
+void crearCarpetaSalida();
+
+// Nombre del archivo de salida en 'output/' para un archivo de entrada:
+// output/<nombre><sufijo>_out.txt (no crea la carpeta)
+std::string nombreArchivoSalida(const std::string& archivoEntrada, const std::string& sufijo = "");
+
+// Crea la carpeta 'output' y retorna output/<nombre>_out.txt
+std::string generarNombreArchivoSalida(const std::string& archivoEntrada);
+
+// Primera y ultima linea del archivo de salida (el modo en linea las
+// escribe por su cuenta alrededor de las filas)
+void escribirEncabezadoSalida(EscritorTexto& salida);
+void escribirPromediosSalida(EscritorTexto& salida, const AgregadorMetricas& metricas);
+
+// Escribe el archivo de salida de una simulacion: encabezado, una linea
+// por proceso terminado (ordenadas por etiqueta; las repetidas en orden
+// de finalizacion) y la linea de promedios.
+// Retorna false (y avisa por std::cerr) si no se pudo abrir el archivo.
+bool escribirArchivoSalida(const std::string& rutaArchivo, const TablaProcesos& tabla,
+                           const std::pmr::vector<IdProceso>& finalizados, const AgregadorMetricas& metricas);
+
+// Escribe las mismas filas en el formato columnar (ver SalidaColumnar.h),
+// en orden de finalizacion. Retorna false (y avisa por std::cerr) si el
+// archivo no se pudo escribir.
+bool escribirArchivoColumnar(const std::string& rutaArchivo, const TablaProcesos& tabla,
+                             const std::pmr::vector<IdProceso>& finalizados);
+
+#endif
@@ -0,0 +1,77 @@
+#include "Arena.h"
+#include <new>
+#include <cstdint>
+
+/*
+  Constructor
+  
+  No pide memoria todavia; el primer bloque se crea con la primera asignacion.
+ */
+Arena::Arena(std::size_t tamBloque) : bloqueActual(0), usado(0), tamanoBloque(tamBloque) {
+}
+
+/*
+  Destructor
+  
+  Libera todos los bloques de una vez. Los objetos que vivian en la arena
+  ya deben haberse destruido (los contenedores que la usan se declaran
+  despues de ella, asi se destruyen antes).
+ */
+Arena::~Arena() {
+    for (const Bloque& bloque : bloques) {
+        ::operator delete(bloque.datos);
+    }
+}
+
+/*
+  Reparte memoria del bloque actual
+  
+  Alinea el puntero, y si la asignacion no cabe pasa al siguiente bloque
+  conservado de una corrida anterior. Solo si ya no quedan bloques pide uno
+  nuevo al sistema, del tamano por defecto o mas grande si la asignacion
+  lo necesita.
+ */
+void* Arena::do_allocate(std::size_t bytes, std::size_t alineacion) {
+    while (bloqueActual < bloques.size()) {
+        Bloque& bloque = bloques[bloqueActual];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(bloque.datos);
+        std::uintptr_t inicio = (base + usado + alineacion - 1) & ~(std::uintptr_t)(alineacion - 1);
+        std::size_t desplazamiento = inicio - base;
+        
+        if (desplazamiento + bytes <= bloque.tamano) {
+            usado = desplazamiento + bytes;
+            return reinterpret_cast<void*>(inicio);
+        }
+        
+        // No cabe: seguir con el siguiente bloque
+        bloqueActual++;
+        usado = 0;
+    }
+    
+    // Pedir un bloque nuevo al sistema
+    std::size_t tamano = bytes + alineacion > tamanoBloque ? bytes + alineacion : tamanoBloque;
+    Bloque nuevo{static_cast<char*>(::operator new(tamano)), tamano};
+    bloques.push_back(nuevo);
+    bloqueActual = bloques.size() - 1;
+    usado = 0;
+    return do_allocate(bytes, alineacion);
+}
+
+/*
+  Reinicia la arena
+  
+  Vuelve al inicio del primer bloque. Todo lo que se habia repartido queda
+  invalido, pero ningun bloque se devuelve al sistema.
+ */
+void Arena::reiniciar() {
+    bloqueActual = 0;
+    usado = 0;
+}
+
+std::size_t Arena::getBytesReservados() const {
+    std::size_t total = 0;
+    for (const Bloque& bloque : bloques) {
+        total += bloque.tamano;
+    }
+    return total;
+}
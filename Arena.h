@@ -0,0 +1,57 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+/*
+  Clase Arena
+  
+  Recurso de memoria monotono para una simulacion completa. Reparte memoria
+  de bloques grandes avanzando un puntero, y liberar una asignacion
+  individual no hace nada: toda la memoria se devuelve de una sola vez
+  al destruir la arena.
+  
+  reiniciar() deja la arena vacia pero conserva los bloques ya pedidos al
+  sistema, asi una corrida siguiente reutiliza la misma memoria sin volver
+  a llamar al allocator del sistema.
+  
+  Se usa como std::pmr::memory_resource, de modo que los contenedores pmr
+  (tabla de procesos, colas, llegadas) toman su memoria de aqui.
+ */
+class Arena : public std::pmr::memory_resource {
+private:
+    struct Bloque {
+        char* datos;
+        std::size_t tamano;
+    };
+    
+    std::vector<Bloque> bloques;    // Bloques pedidos al sistema (se conservan al reiniciar)
+    std::size_t bloqueActual;       // Bloque del que se esta repartiendo
+    std::size_t usado;              // Bytes usados en el bloque actual
+    std::size_t tamanoBloque;       // Tamano minimo de cada bloque nuevo
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alineacion) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& otro) const noexcept override { return this == &otro; }
+
+public:
+    // Crea la arena vacia; los bloques se piden cuando hacen falta
+    explicit Arena(std::size_t tamBloque = 64 * 1024);
+    
+    // Devuelve todos los bloques al sistema
+    ~Arena();
+    
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    
+    // Olvida todas las asignaciones pero conserva los bloques para reutilizarlos
+    void reiniciar();
+    
+    // Bytes pedidos al sistema (suma del tamano de los bloques)
+    std::size_t getBytesReservados() const;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include "Balanceo.h"
+#include "MLFQMultinucleo.h"
+
+int BalanceoCircular::nucleoParaLlegada(const MLFQMultinucleo& simulador, IdProceso) {
+    int nucleo = siguiente;
+    siguiente = (siguiente + 1) % simulador.getCantidadNucleos();
+    return nucleo;
+}
+
+/*
+  Llegada: el menos cargado de dos nucleos al azar
+  
+  La carga es la cantidad de procesos listos mas el que esta ejecutando,
+  asi un nucleo ocioso siempre gana contra uno ocupado.
+ */
+int BalanceoDosOpciones::nucleoParaLlegada(const MLFQMultinucleo& simulador, IdProceso) {
+    std::uniform_int_distribution<int> nucleos(0, simulador.getCantidadNucleos() - 1);
+    int a = nucleos(aleatorio);
+    int b = nucleos(aleatorio);
+    return simulador.getCarga(b) < simulador.getCarga(a) ? b : a;
+}
+
+// Robo: el que tenga mas procesos listos de dos nucleos al azar
+int BalanceoDosOpciones::victimaParaRobo(const MLFQMultinucleo& simulador, int) {
+    std::uniform_int_distribution<int> nucleos(0, simulador.getCantidadNucleos() - 1);
+    int a = nucleos(aleatorio);
+    int b = nucleos(aleatorio);
+    return simulador.getListos(b) > simulador.getListos(a) ? b : a;
+}
+
+std::unique_ptr<PoliticaBalanceo> crearBalanceo(const std::string& nombre) {
+    if (nombre == "circular") {
+        return std::unique_ptr<PoliticaBalanceo>(new BalanceoCircular());
+    }
+    if (nombre == "dos") {
+        return std::unique_ptr<PoliticaBalanceo>(new BalanceoDosOpciones());
+    }
+    return nullptr;
+}
@@ -0,0 +1,79 @@
+#ifndef BALANCEO_H
+#define BALANCEO_H
+
+#include "TablaProcesos.h"
+#include <memory>
+#include <random>
+#include <string>
+
+class MLFQMultinucleo;
+
+/*
+  Clase PoliticaBalanceo
+  
+  Decide como se reparten los procesos entre los nucleos de un
+  MLFQMultinucleo: a que nucleo va cada proceso que llega y a que nucleo
+  le roba trabajo un nucleo que se quedo sin procesos.
+  
+  Las decisiones deben ser O(1) o parecido (se toman una vez por llegada
+  y una vez por robo). Si la victima escogida no tiene procesos listos, el
+  simulador roba del primer nucleo que si tenga, asi que una politica
+  nunca deja un nucleo ocioso mientras haya trabajo esperando.
+ */
+class PoliticaBalanceo {
+public:
+    virtual ~PoliticaBalanceo() {}
+    
+    // Nucleo donde se encola un proceso que acaba de llegar
+    virtual int nucleoParaLlegada(const MLFQMultinucleo& simulador, IdProceso id) = 0;
+    
+    // Nucleo al que le roba el nucleo 'ladron', que esta ocioso
+    // (-1 deja la eleccion al simulador)
+    virtual int victimaParaRobo(const MLFQMultinucleo& simulador, int ladron) = 0;
+    
+    // Nombre para mostrar
+    virtual std::string getNombre() const = 0;
+};
+
+/*
+  Balanceo circular
+  
+  Las llegadas se reparten en orden (nucleo 0, 1, 2, ...) y el robo queda
+  en manos del simulador (el primer nucleo con procesos listos).
+ */
+class BalanceoCircular : public PoliticaBalanceo {
+private:
+    int siguiente;      // Nucleo de la proxima llegada
+
+public:
+    BalanceoCircular() : siguiente(0) {}
+    
+    int nucleoParaLlegada(const MLFQMultinucleo& simulador, IdProceso id) override;
+    int victimaParaRobo(const MLFQMultinucleo&, int) override { return -1; }
+    std::string getNombre() const override { return "circular"; }
+};
+
+/*
+  Balanceo por dos opciones al azar
+  
+  Cada llegada compara la carga de dos nucleos al azar y va al menos
+  cargado; cada robo compara dos nucleos al azar y le roba al mas cargado.
+  Con solo dos muestras la carga queda casi tan pareja como buscando el
+  minimo entre todos, sin recorrer los nucleos.
+ */
+class BalanceoDosOpciones : public PoliticaBalanceo {
+private:
+    std::mt19937 aleatorio;
+
+public:
+    explicit BalanceoDosOpciones(unsigned semilla = 1) : aleatorio(semilla) {}
+    
+    int nucleoParaLlegada(const MLFQMultinucleo& simulador, IdProceso id) override;
+    int victimaParaRobo(const MLFQMultinucleo& simulador, int ladron) override;
+    std::string getNombre() const override { return "dos"; }
+};
+
+// Crea la politica por nombre ("circular" o "dos"); nullptr si no existe
+std::unique_ptr<PoliticaBalanceo> crearBalanceo(const std::string& nombre);
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef BINARIO_H
+#define BINARIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/*
+  Clases EscritorBinario y LectorBinario
+  
+  Lectura y escritura de valores sin formato para los checkpoints: los
+  numeros se copian tal como estan en memoria (el archivo solo se puede
+  leer en una maquina con el mismo orden de bytes) y los vectores se
+  guardan como su tamano seguido de sus elementos. Solo se aceptan
+  numeros (o arreglos de numeros, como las marcas de los archivos): una
+  estructura se escribe campo por campo, porque copiarla entera copiaria
+  tambien su relleno, que no tiene un valor fijo.
+  
+  El lector no lanza excepciones: despues del primer error (archivo
+  cortado o un tamano imposible) todas las lecturas fallan y bien()
+  retorna false, asi basta revisar una vez al final.
+ */
+template <typename T>
+constexpr bool esValorBinario = std::is_arithmetic<typename std::remove_all_extents<T>::type>::value;
+
+class EscritorBinario {
+private:
+    std::ostream& salida;
+
+public:
+    explicit EscritorBinario(std::ostream& s) : salida(s) {}
+    
+    template <typename T>
+    void escribir(const T& valor) {
+        static_assert(esValorBinario<T>, "Solo numeros; las estructuras se escriben campo por campo");
+        salida.write(reinterpret_cast<const char*>(&valor), sizeof(T));
+    }
+    
+    // Tamano y elementos de un vector (o cualquier contenedor contiguo)
+    template <typename Vector>
+    void escribirVector(const Vector& valores) {
+        static_assert(esValorBinario<typename Vector::value_type>, "Solo vectores de numeros");
+        escribir((std::uint64_t)valores.size());
+        if (!valores.empty()) {
+            salida.write(reinterpret_cast<const char*>(valores.data()),
+                         (std::streamsize)(valores.size() * sizeof(valores[0])));
+        }
+    }
+    
+    void escribirTexto(std::string_view texto) {
+        escribir((std::uint64_t)texto.size());
+        salida.write(texto.data(), (std::streamsize)texto.size());
+    }
+    
+    bool bien() const { return (bool)salida; }
+};
+
+class LectorBinario {
+private:
+    std::istream& entrada;
+    bool ok;
+
+public:
+    explicit LectorBinario(std::istream& e) : entrada(e), ok(true) {}
+    
+    template <typename T>
+    bool leer(T& valor) {
+        static_assert(esValorBinario<T>, "Solo numeros; las estructuras se leen campo por campo");
+        ok = ok && entrada.read(reinterpret_cast<char*>(&valor), sizeof(T));
+        return ok;
+    }
+    
+    // Lee un tamano que no puede pasar de 'maximo' (para no reservar
+    // memoria de mas con un archivo corrupto)
+    bool leerTamano(std::uint64_t& tamano, std::uint64_t maximo) {
+        if (leer(tamano) && tamano > maximo) {
+            ok = false;
+        }
+        return ok;
+    }
+    
+    template <typename Vector>
+    bool leerVector(Vector& valores, std::uint64_t maximo) {
+        static_assert(esValorBinario<typename Vector::value_type>, "Solo vectores de numeros");
+        std::uint64_t tamano = 0;
+        if (!leerTamano(tamano, maximo)) {
+            return false;
+        }
+        valores.resize((std::size_t)tamano);
+        if (tamano > 0) {
+            ok = (bool)entrada.read(reinterpret_cast<char*>(valores.data()),
+                                    (std::streamsize)(tamano * sizeof(valores[0])));
+        }
+        return ok;
+    }
+    
+    bool leerTexto(std::string& texto, std::uint64_t maximo) {
+        std::uint64_t tamano = 0;
+        if (!leerTamano(tamano, maximo)) {
+            return false;
+        }
+        texto.resize((std::size_t)tamano);
+        ok = (bool)entrada.read(&texto[0], (std::streamsize)tamano);
+        return ok;
+    }
+    
+    void fallar() { ok = false; }
+    bool bien() const { return ok; }
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "ColaEnvios.h"
+#include <utility>
+
+/*
+  Constructor
+  
+  La cola siempre tiene un nodo vacio al frente: al principio cabeza y
+  cola apuntan a el, y cada vez que se saca un proceso el nodo que lo
+  traia pasa a ser el nuevo nodo vacio.
+ */
+ColaEnvios::ColaEnvios() : version(0), cerrada(false) {
+    Nodo* vacio = new Nodo();
+    vacio->siguiente.store(nullptr, std::memory_order_relaxed);
+    cabeza.store(vacio, std::memory_order_relaxed);
+    cola = vacio;
+}
+
+ColaEnvios::~ColaEnvios() {
+    while (cola != nullptr) {
+        Nodo* siguiente = cola->siguiente.load(std::memory_order_relaxed);
+        delete cola;
+        cola = siguiente;
+    }
+}
+
+/*
+  Envia un proceso
+  
+  El exchange publica el nodo como nueva cabeza; el store con release
+  lo enlaza detras de la cabeza anterior y hace visible su contenido al
+  consumidor que lo lea con acquire.
+ */
+bool ColaEnvios::enviar(ProcesoEnviado proceso) {
+    if (cerrada.load(std::memory_order_acquire)) {
+        return false;
+    }
+    
+    Nodo* nodo = new Nodo();
+    nodo->siguiente.store(nullptr, std::memory_order_relaxed);
+    nodo->proceso = std::move(proceso);
+    
+    Nodo* anterior = cabeza.exchange(nodo, std::memory_order_acq_rel);
+    anterior->siguiente.store(nodo, std::memory_order_release);
+    
+    version.fetch_add(1, std::memory_order_release);
+    version.notify_one();
+    return true;
+}
+
+void ColaEnvios::cerrar() {
+    cerrada.store(true, std::memory_order_release);
+    version.fetch_add(1, std::memory_order_release);
+    version.notify_one();
+}
+
+bool ColaEnvios::sacar(ProcesoEnviado& proceso) {
+    Nodo* siguiente = cola->siguiente.load(std::memory_order_acquire);
+    if (siguiente == nullptr) {
+        return false;
+    }
+    
+    proceso = std::move(siguiente->proceso);
+    delete cola;
+    cola = siguiente;
+    return true;
+}
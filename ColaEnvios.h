@@ -0,0 +1,74 @@
+#ifndef COLAENVIOS_H
+#define COLAENVIOS_H
+
+#include "TablaProcesos.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Un proceso enviado por otro hilo, con copia propia de su texto
+struct ProcesoEnviado {
+    std::string etiqueta;
+    std::string rafagas;        // Pares E/S,CPU (vacio si no hay)
+    int tiempoRafaga = 0;
+    int tiempoLlegada = 0;
+    int cola = 0;
+    int prioridad = 0;
+};
+
+/*
+  Clase ColaEnvios
+  
+  Cola de procesos enviados desde varios hilos productores hacia el hilo
+  de la simulacion (un solo consumidor), sin locks: es la cola MPSC de
+  nodos enlazados de Vyukov. Enviar es un exchange sobre la cabeza y un
+  store al siguiente del nodo anterior, asi ningun productor espera a
+  otro ni al consumidor; sacar solo lo hace el consumidor y no usa
+  operaciones atomicas de lectura-escritura.
+  
+  Entre el exchange y el enlace de un productor la cola puede verse vacia
+  aunque el nodo ya este adentro; el consumidor lo vera en la siguiente
+  vuelta. Para no girar mientras espera, cada envio (y el cierre) suma 1
+  a una version con notify, y el consumidor duerme con atomic::wait
+  sobre la ultima version que vio antes de vaciar la cola.
+  
+  cerrar() marca que no vendran mas envios; debe llamarse cuando todos
+  los productores terminaron (por ejemplo, despues de su join). enviar()
+  despues del cierre es un error de uso y retorna false.
+ */
+class ColaEnvios {
+private:
+    struct Nodo {
+        std::atomic<Nodo*> siguiente;
+        ProcesoEnviado proceso;
+    };
+    
+    std::atomic<Nodo*> cabeza;              // Ultimo nodo enviado (lado de los productores)
+    Nodo* cola;                             // Nodo ya consumido; su siguiente es el primero pendiente
+    std::atomic<std::uint64_t> version;     // Envios y cierres, para esperar sin girar
+    std::atomic<bool> cerrada;
+
+public:
+    ColaEnvios();
+    ~ColaEnvios();
+    
+    ColaEnvios(const ColaEnvios&) = delete;
+    ColaEnvios& operator=(const ColaEnvios&) = delete;
+    
+    // Productores (cualquier hilo)
+    bool enviar(ProcesoEnviado proceso);
+    void cerrar();
+    
+    // Consumidor (un solo hilo): saca el siguiente proceso si ya esta enlazado
+    bool sacar(ProcesoEnviado& proceso);
+    
+    // Version actual; leerla antes de vaciar la cola y pasarla a esperar()
+    std::uint64_t getVersion() const { return version.load(std::memory_order_acquire); }
+    
+    // Duerme hasta que la version cambie respecto a 'vista'
+    void esperar(std::uint64_t vista) const { version.wait(vista, std::memory_order_acquire); }
+    
+    bool estaCerrada() const { return cerrada.load(std::memory_order_acquire); }
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "ColaLlegadas.h"
+#include <algorithm>
+
+ColaLlegadas::ColaLlegadas(const TablaProcesos& t, std::pmr::memory_resource* memoria)
+    : tabla(&t), ids(memoria), siguiente(0), ordenada(true) {
+}
+
+void ColaLlegadas::agregar(IdProceso id) {
+    if (ordenada && hayPendientes() && tabla->getTiempoLlegada(id) < tabla->getTiempoLlegada(ids.back())) {
+        ordenada = false;
+    }
+    ids.push_back(id);
+}
+
+void ColaLlegadas::ordenar() {
+    if (ordenada) {
+        return;
+    }
+    std::stable_sort(ids.begin() + siguiente, ids.end(),
+                     [this](IdProceso a, IdProceso b) {
+                         return tabla->getTiempoLlegada(a) < tabla->getTiempoLlegada(b);
+                     });
+    ordenada = true;
+}
+
+void ColaLlegadas::compactar() {
+    if (!hayPendientes()) {
+        ids.clear();
+        siguiente = 0;
+    } else if (siguiente >= 1024 && 2 * siguiente >= ids.size()) {
+        ids.erase(ids.begin(), ids.begin() + siguiente);
+        siguiente = 0;
+    }
+}
+
+void ColaLlegadas::guardar(EscritorBinario& escritor) const {
+    std::vector<IdProceso> pendientes(begin(), end());
+    escritor.escribirVector(pendientes);
+    escritor.escribir((std::uint8_t)ordenada);
+}
+
+/*
+  Carga una cola guardada con guardar
+  
+  Los pendientes quedan desde el principio del vector. Se rechazan ids
+  fuera de la tabla.
+ */
+bool ColaLlegadas::cargar(LectorBinario& lector, std::size_t maxId) {
+    std::uint8_t estabaOrdenada = 1;
+    siguiente = 0;
+    lector.leerVector(ids, maxId);
+    lector.leer(estabaOrdenada);
+    ordenada = estabaOrdenada != 0;
+    for (IdProceso id : ids) {
+        if (id >= maxId) {
+            lector.fallar();
+        }
+    }
+    return lector.bien();
+}
@@ -0,0 +1,111 @@
+#ifndef COLALLEGADAS_H
+#define COLALLEGADAS_H
+
+#include "TablaProcesos.h"
+#include "Binario.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+/*
+  Clase ColaLlegadas
+  
+  Procesos registrados en la tabla que aun no llegan, por tiempo de
+  llegada. Es la misma para MLFQScheduler, MLFQ<Niveles...> y
+  MLFQMultinucleo.
+  
+  Los ids se agregan al final sin ordenar. Si llegan en orden de tiempo
+  de llegada (el caso comun en las trazas) no hace falta ordenar nunca;
+  si no, la cola se marca y la parte pendiente se ordena una sola vez,
+  en O(n log n), antes de liberar la siguiente llegada. El orden es
+  estable: los que llegan en el mismo instante salen en el orden en que
+  se agregaron (la version original usaba std::sort, que con mas de 16
+  procesos no conservaba ese orden).
+  
+  Liberar un proceso es O(1): se avanza un cursor y el vector nunca se
+  desplaza; cuando ya salieron todos se vacia. En modo en linea casi
+  nunca se vacia (siempre hay una llegada conocida por delante), asi que
+  cuando la parte ya liberada es mas de la mitad se descarta de una vez,
+  en O(1) amortizado por proceso.
+ */
+class ColaLlegadas {
+private:
+    const TablaProcesos* tabla;      // De donde salen los tiempos de llegada
+    std::pmr::vector<IdProceso> ids;  // Procesos por tiempo de llegada (los pendientes desde 'siguiente')
+    std::size_t siguiente;           // Cursor al primero que aun no llega
+    bool ordenada;                   // false si hay que ordenar antes de liberar
+    
+    // Descarta la parte ya liberada si ya salieron todos o si es mas de la mitad
+    void compactar();
+
+public:
+    ColaLlegadas(const TablaProcesos& tabla, std::pmr::memory_resource* memoria);
+    
+    // Reserva lugar para 'cantidad' procesos mas
+    void reservar(std::size_t cantidad) { ids.reserve(ids.size() + cantidad); }
+    
+    // Agrega un proceso ya registrado al final; si llega antes que el
+    // ultimo pendiente, la cola se marca para ordenarla
+    void agregar(IdProceso id);
+    
+    // Registra cada proceso del rango con registrar(proceso), que lo copia
+    // a 'destino' y retorna su id, y lo agrega. Si se conoce la cantidad,
+    // reserva de una vez en la tabla y en la cola
+    template <typename Iterador, typename Registrar>
+    void agregarRango(Iterador inicio, Iterador fin, TablaProcesos& destino, Registrar registrar);
+    
+    // Ordena la parte pendiente si hace falta (liberarHasta lo hace solo;
+    // antes de consultar proxima() sin liberar hay que llamarlo)
+    void ordenar();
+    
+    // Pasa a encolar(id), en orden, los procesos que llegan hasta 'tiempo'
+    template <typename Encolar>
+    void liberarHasta(int tiempo, Encolar encolar);
+    
+    bool hayPendientes() const { return siguiente < ids.size(); }
+    std::size_t pendientes() const { return ids.size() - siguiente; }
+    
+    // Tiempo de llegada del primero pendiente (la cola no debe estar vacia)
+    int proxima() const { return tabla->getTiempoLlegada(ids[siguiente]); }
+    
+    // El ultimo agregado (la cola no debe estar vacia)
+    IdProceso ultimo() const { return ids.back(); }
+    
+    // Los pendientes en orden (solo si ya esta ordenada)
+    const IdProceso* begin() const { return ids.data() + siguiente; }
+    const IdProceso* end() const { return ids.data() + ids.size(); }
+    
+    // Checkpoint: los pendientes y si estan ordenados
+    void guardar(EscritorBinario& escritor) const;
+    bool cargar(LectorBinario& lector, std::size_t maxId);
+};
+
+template <typename Iterador, typename Registrar>
+void ColaLlegadas::agregarRango(Iterador inicio, Iterador fin, TablaProcesos& destino, Registrar registrar) {
+    typedef typename std::iterator_traits<Iterador>::iterator_category Categoria;
+    if constexpr (std::is_base_of<std::random_access_iterator_tag, Categoria>::value) {
+        std::size_t cantidad = (std::size_t)(fin - inicio);
+        if (cantidad > 1) {
+            destino.reservar(destino.tamano() + cantidad);
+            reservar(cantidad);
+        }
+    }
+    
+    for (; inicio != fin; ++inicio) {
+        agregar(registrar(*inicio));
+    }
+}
+
+template <typename Encolar>
+void ColaLlegadas::liberarHasta(int tiempo, Encolar encolar) {
+    ordenar();
+    while (hayPendientes() && proxima() <= tiempo) {
+        encolar(ids[siguiente++]);
+    }
+    compactar();
+}
+
+#endif
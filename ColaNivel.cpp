@@ -0,0 +1,382 @@
+#include "ColaNivel.h"
+
+/*
+  Constructor
+  
+  Las colas de SJF y STCF usan ColaPorRestante; Round Robin usa la cola
+  FIFO.
+  Ambas estructuras reservan su memoria del recurso indicado.
+ */
+ColaNivel::ColaNivel(TipoPolitica politica, std::pmr::memory_resource* memoria)
+    : porTiempoRestante(politica != TipoPolitica::ROUND_ROBIN), fifo(memoria), porRestante(memoria) {
+}
+
+/*
+  Agrega un proceso a la cola
+  
+  En Round Robin va al final de la cola. En SJF/STCF tambien va al final,
+  con su tiempo restante actual como clave, en O(log n).
+ */
+void ColaNivel::agregarProceso(IdProceso id, const TablaProcesos& tabla) {
+    if (porTiempoRestante) {
+        porRestante.agregarProceso(id, tabla);
+    } else {
+        fifo.agregarProceso(id, tabla);
+    }
+}
+
+/*
+  Obtiene el siguiente proceso a ejecutar
+  
+  Round Robin: el primero de la cola. SJF/STCF: el de menor tiempo
+  restante, desempatando por menor tiempo de llegada y despues por lugar
+  en la cola (ver ColaPorRestante).
+ */
+IdProceso ColaNivel::obtenerSiguienteProceso() {
+    return porTiempoRestante ? porRestante.obtenerSiguienteProceso() : fifo.obtenerSiguienteProceso();
+}
+
+ColaPorRestante::ColaPorRestante(std::pmr::memory_resource* memoria)
+    : clases(memoria), clasesLibres(memoria), miembros(memoria), miembrosLibres(memoria),
+      raiz(NINGUNA), despachos(0), cantidad(0), semilla(0x9E3779B9u) {
+}
+
+// Clase con esa clave (o NINGUNA) y cuantos procesos tienen menor clave
+std::uint32_t ColaPorRestante::buscar(Clave clave, std::size_t& menores) const {
+    menores = 0;
+    std::uint32_t nodo = raiz;
+    while (nodo != NINGUNA) {
+        const Clase& c = clases[nodo];
+        if (clave < c.clave) {
+            nodo = c.izquierda;
+        } else {
+            menores += total(c.izquierda);
+            if (c.clave == clave) {
+                return nodo;
+            }
+            menores += c.tamano();
+            nodo = c.derecha;
+        }
+    }
+    return NINGUNA;
+}
+
+// Suma 'cambio' al total de la clase y de los nodos sobre ella
+void ColaPorRestante::sumar(Clave clave, long long cambio) {
+    std::uint32_t nodo = raiz;
+    while (nodo != NINGUNA) {
+        clases[nodo].total += cambio;
+        if (clases[nodo].clave == clave) {
+            break;
+        }
+        nodo = clave < clases[nodo].clave ? clases[nodo].izquierda : clases[nodo].derecha;
+    }
+}
+
+// Parte el subarbol en las claves menores a 'clave' y el resto
+void ColaPorRestante::separar(std::uint32_t nodo, Clave clave, std::uint32_t& menores, std::uint32_t& resto) {
+    if (nodo == NINGUNA) {
+        menores = resto = NINGUNA;
+        return;
+    }
+    if (clases[nodo].clave < clave) {
+        separar(clases[nodo].derecha, clave, clases[nodo].derecha, resto);
+        menores = nodo;
+    } else {
+        separar(clases[nodo].izquierda, clave, menores, clases[nodo].izquierda);
+        resto = nodo;
+    }
+    recalcular(nodo);
+}
+
+// Une dos subarboles (todas las claves de 'a' son menores que las de 'b')
+std::uint32_t ColaPorRestante::unir(std::uint32_t a, std::uint32_t b) {
+    if (a == NINGUNA) return b;
+    if (b == NINGUNA) return a;
+    if (clases[a].prioridad > clases[b].prioridad) {
+        clases[a].derecha = unir(clases[a].derecha, b);
+        recalcular(a);
+        return a;
+    }
+    clases[b].izquierda = unir(a, clases[b].izquierda);
+    recalcular(b);
+    return b;
+}
+
+std::uint32_t ColaPorRestante::crearClase(Clave clave) {
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    
+    Clase clase{clave, semilla, NINGUNA, NINGUNA, NINGUNA, NINGUNA, NINGUNA, 0, 0, despachos, 0};
+    std::uint32_t nodo;
+    if (!clasesLibres.empty()) {
+        nodo = clasesLibres.back();
+        clasesLibres.pop_back();
+        clases[nodo] = clase;
+    } else {
+        nodo = (std::uint32_t)clases.size();
+        clases.push_back(clase);
+    }
+    
+    std::uint32_t menores, resto;
+    separar(raiz, clave, menores, resto);
+    raiz = unir(unir(menores, nodo), resto);
+    return nodo;
+}
+
+// Saca del treap la clase (vacia) con esa clave
+void ColaPorRestante::quitarClase(Clave clave) {
+    std::uint32_t padre = NINGUNA;
+    std::uint32_t nodo = raiz;
+    while (!(clases[nodo].clave == clave)) {
+        padre = nodo;
+        nodo = clave < clases[nodo].clave ? clases[nodo].izquierda : clases[nodo].derecha;
+    }
+    
+    std::uint32_t reemplazo = unir(clases[nodo].izquierda, clases[nodo].derecha);
+    if (padre == NINGUNA) raiz = reemplazo;
+    else if (clases[padre].izquierda == nodo) clases[padre].izquierda = reemplazo;
+    else clases[padre].derecha = reemplazo;
+    clasesLibres.push_back(nodo);
+}
+
+std::uint32_t ColaPorRestante::crearMiembro(IdProceso id, std::uint64_t despacho) {
+    Miembro miembro{id, NINGUNA, NINGUNA, despacho};
+    if (!miembrosLibres.empty()) {
+        std::uint32_t indice = miembrosLibres.back();
+        miembrosLibres.pop_back();
+        miembros[indice] = miembro;
+        return indice;
+    }
+    miembros.push_back(miembro);
+    return (std::uint32_t)(miembros.size() - 1);
+}
+
+// Agrega al final del anillo de visibles
+void ColaPorRestante::agregarVisible(Clase& clase, std::uint32_t miembro) {
+    if (clase.ultimoVisible == NINGUNA) {
+        miembros[miembro].siguiente = miembros[miembro].anterior = miembro;
+    } else {
+        std::uint32_t primero = miembros[clase.ultimoVisible].siguiente;
+        miembros[miembro].anterior = clase.ultimoVisible;
+        miembros[miembro].siguiente = primero;
+        miembros[clase.ultimoVisible].siguiente = miembro;
+        miembros[primero].anterior = miembro;
+    }
+    clase.ultimoVisible = miembro;
+    clase.visibles++;
+}
+
+void ColaPorRestante::agregarTapado(Clase& clase, std::uint32_t miembro) {
+    if (clase.ultimoTapado == NINGUNA) {
+        clase.primerTapado = miembro;
+    } else {
+        miembros[clase.ultimoTapado].siguiente = miembro;
+    }
+    clase.ultimoTapado = miembro;
+    clase.tapados++;
+}
+
+// El primer visible pasa al final 'pasos' veces, por el lado mas corto
+void ColaPorRestante::rotar(Clase& clase, std::uint64_t pasos) {
+    if (clase.visibles < 2) {
+        return;
+    }
+    pasos %= clase.visibles;
+    if (pasos <= clase.visibles / 2) {
+        for (std::uint64_t i = 0; i < pasos; i++) {
+            clase.ultimoVisible = miembros[clase.ultimoVisible].siguiente;
+        }
+    } else {
+        for (std::uint64_t i = pasos; i < clase.visibles; i++) {
+            clase.ultimoVisible = miembros[clase.ultimoVisible].anterior;
+        }
+    }
+}
+
+/*
+  Pone al dia una clase
+  
+  En cada despacho que no es de su clase, el primer visible pasa al final
+  de los visibles, y los tapados que se destapan en ese despacho quedan
+  detras. Todo eso se acumula y se aplica aqui, en orden.
+ */
+void ColaPorRestante::ponerAlDia(Clase& clase, std::uint64_t despacho) {
+    while (clase.primerTapado != NINGUNA && miembros[clase.primerTapado].despacho <= despacho) {
+        std::uint32_t miembro = clase.primerTapado;
+        std::uint64_t destapado = miembros[miembro].despacho;
+        clase.primerTapado = miembros[miembro].siguiente;
+        if (clase.primerTapado == NINGUNA) {
+            clase.ultimoTapado = NINGUNA;
+        }
+        clase.tapados--;
+        
+        if (destapado > clase.rotadoHasta) {
+            rotar(clase, destapado - clase.rotadoHasta);
+            clase.rotadoHasta = destapado;
+        }
+        agregarVisible(clase, miembro);
+    }
+    if (despacho > clase.rotadoHasta) {
+        rotar(clase, despacho - clase.rotadoHasta);
+        clase.rotadoHasta = despacho;
+    }
+}
+
+/*
+  Inserta un proceso al final de la cola
+  
+  Si no hay procesos con menor clave queda visible, al final de los de su
+  clase; si no, queda tapado hasta que pasen tantos despachos como
+  procesos de menor clave hay ahora.
+ */
+void ColaPorRestante::insertar(IdProceso id, Clave clave) {
+    std::size_t menores = 0;
+    std::uint32_t nodo = buscar(clave, menores);
+    if (nodo == NINGUNA) {
+        nodo = crearClase(clave);
+    }
+    
+    std::uint32_t miembro = crearMiembro(id, despachos + menores);
+    Clase& clase = clases[nodo];
+    if (menores == 0) {
+        ponerAlDia(clase, despachos);
+        agregarVisible(clase, miembro);
+    } else {
+        agregarTapado(clase, miembro);
+    }
+    sumar(clave, 1);
+    cantidad++;
+}
+
+/*
+  Saca el siguiente proceso
+  
+  Es el primer visible de la clase de menor clave (todos los de esa clase
+  ya son visibles). Esa clase no rota en su propio despacho; las demas si.
+ */
+IdProceso ColaPorRestante::obtenerSiguienteProceso() {
+    std::uint32_t nodo = raiz;
+    while (clases[nodo].izquierda != NINGUNA) {
+        nodo = clases[nodo].izquierda;
+    }
+    
+    Clase& clase = clases[nodo];
+    ponerAlDia(clase, despachos);
+    std::uint32_t primero = miembros[clase.ultimoVisible].siguiente;
+    if (primero == clase.ultimoVisible) {
+        clase.ultimoVisible = NINGUNA;
+    } else {
+        miembros[clase.ultimoVisible].siguiente = miembros[primero].siguiente;
+        miembros[miembros[primero].siguiente].anterior = clase.ultimoVisible;
+    }
+    clase.visibles--;
+    miembrosLibres.push_back(primero);
+    
+    despachos++;
+    clase.rotadoHasta = despachos;
+    cantidad--;
+    
+    Clave clave = clase.clave;
+    sumar(clave, -1);
+    if (clase.tamano() == 0) {
+        quitarClase(clave);
+    }
+    return miembros[primero].id;
+}
+
+/*
+  Checkpoint
+  
+  Cada clase se escribe campo por campo, en orden de clave: la clave, el
+  despacho hasta el que esta al dia, los visibles desde el primero y los
+  tapados con el despacho en que se destapan. Asi el archivo no depende
+  de donde quedo cada nodo en memoria.
+ */
+void ColaPorRestante::guardar(EscritorBinario& escritor) const {
+    escritor.escribir(despachos);
+    escritor.escribir((std::uint64_t)(clases.size() - clasesLibres.size()));
+    
+    std::vector<std::uint32_t> pila;
+    std::uint32_t nodo = raiz;
+    while (nodo != NINGUNA || !pila.empty()) {
+        while (nodo != NINGUNA) {
+            pila.push_back(nodo);
+            nodo = clases[nodo].izquierda;
+        }
+        nodo = pila.back();
+        pila.pop_back();
+        
+        const Clase& clase = clases[nodo];
+        escritor.escribir(clase.clave.tiempoRestante);
+        escritor.escribir(clase.clave.tiempoLlegada);
+        escritor.escribir(clase.rotadoHasta);
+        escritor.escribir((std::uint64_t)clase.visibles);
+        std::uint32_t miembro = clase.ultimoVisible;
+        for (std::uint32_t i = 0; i < clase.visibles; i++) {
+            miembro = miembros[miembro].siguiente;
+            escritor.escribir(miembros[miembro].id);
+        }
+        escritor.escribir((std::uint64_t)clase.tapados);
+        for (miembro = clase.primerTapado; miembro != NINGUNA; miembro = miembros[miembro].siguiente) {
+            escritor.escribir(miembros[miembro].id);
+            escritor.escribir(miembros[miembro].despacho);
+        }
+        
+        nodo = clase.derecha;
+    }
+}
+
+bool ColaPorRestante::cargar(LectorBinario& lector, std::size_t maxId) {
+    clases.clear();
+    clasesLibres.clear();
+    miembros.clear();
+    miembrosLibres.clear();
+    raiz = NINGUNA;
+    cantidad = 0;
+    
+    std::uint64_t cantidadClases = 0;
+    lector.leer(despachos);
+    lector.leerTamano(cantidadClases, maxId);
+    for (std::uint64_t k = 0; k < cantidadClases && lector.bien(); k++) {
+        Clave clave{0, 0};
+        std::uint64_t rotadoHasta = 0, visibles = 0, tapados = 0;
+        std::size_t menores = 0;
+        lector.leer(clave.tiempoRestante);
+        lector.leer(clave.tiempoLlegada);
+        lector.leer(rotadoHasta);
+        if (!lector.leerTamano(visibles, maxId) || rotadoHasta > despachos || buscar(clave, menores) != NINGUNA) {
+            lector.fallar();
+            break;
+        }
+        
+        std::uint32_t nodo = crearClase(clave);
+        clases[nodo].rotadoHasta = rotadoHasta;
+        for (std::uint64_t i = 0; i < visibles && lector.bien(); i++) {
+            IdProceso id = 0;
+            if (lector.leer(id) && id >= maxId) {
+                lector.fallar();
+            }
+            std::uint32_t miembro = crearMiembro(id, 0);
+            agregarVisible(clases[nodo], miembro);
+        }
+        lector.leerTamano(tapados, maxId);
+        for (std::uint64_t i = 0; i < tapados && lector.bien(); i++) {
+            IdProceso id = 0;
+            std::uint64_t despacho = 0;
+            lector.leer(id);
+            if (lector.leer(despacho) && (id >= maxId || despacho < rotadoHasta)) {
+                lector.fallar();
+            }
+            std::uint32_t miembro = crearMiembro(id, despacho);
+            agregarTapado(clases[nodo], miembro);
+        }
+        if (clases[nodo].tamano() == 0) {
+            lector.fallar();
+        }
+        sumar(clave, (long long)clases[nodo].tamano());
+        cantidad += clases[nodo].tamano();
+    }
+    return lector.bien();
+}
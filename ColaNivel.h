@@ -0,0 +1,303 @@
+#ifndef COLANIVEL_H
+#define COLANIVEL_H
+
+#include "TablaProcesos.h"
+#include "Binario.h"
+#include <deque>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include <memory_resource>
+
+/*
+  Enumeracion para los tipos de algoritmos de scheduling
+  que pueden usarse en cada cola del MLFQ
+ */
+enum class TipoPolitica {
+    ROUND_ROBIN,    // Round Robin con quantum
+    SJF,           // Shortest Job First
+    STCF           // Shortest Time-to-Completion First
+};
+
+/*
+  Clase ColaFIFO
+  
+  Procesos listos en orden de llegada a la cola (Round Robin): el
+  siguiente es el que lleva mas tiempo esperando.
+ */
+class ColaFIFO {
+private:
+    std::pmr::deque<IdProceso> fifo;
+
+public:
+    explicit ColaFIFO(std::pmr::memory_resource* memoria = std::pmr::get_default_resource())
+        : fifo(memoria) {}
+    
+    void agregarProceso(IdProceso id, const TablaProcesos&) { fifo.push_back(id); }
+    
+    // Saca el primero (la cola no debe estar vacia)
+    IdProceso obtenerSiguienteProceso() {
+        IdProceso id = fifo.front();
+        fifo.pop_front();
+        return id;
+    }
+    
+    bool estaVacia() const { return fifo.empty(); }
+    std::size_t tamano() const { return fifo.size(); }
+    
+    // Checkpoint: los ids en orden
+    void guardar(EscritorBinario& escritor) const {
+        escritor.escribir((std::uint64_t)fifo.size());
+        for (IdProceso id : fifo) {
+            escritor.escribir(id);
+        }
+    }
+    
+    bool cargar(LectorBinario& lector, std::size_t maxId) {
+        std::uint64_t cantidad = 0;
+        lector.leerTamano(cantidad, maxId);
+        fifo.clear();
+        for (std::uint64_t i = 0; i < cantidad && lector.bien(); i++) {
+            IdProceso id;
+            if (lector.leer(id) && id >= maxId) {
+                lector.fallar();
+            }
+            fifo.push_back(id);
+        }
+        return lector.bien();
+    }
+};
+
+/*
+  Clase ColaPorRestante
+  
+  Procesos listos ordenados por (tiempo restante, tiempo de llegada) (SJF y
+  STCF), con el mismo orden que la cola original. Alla los procesos
+  estaban en una cola FIFO y, para despachar, se sacaban todos buscando el
+  primero con la menor clave; cada vez que aparecia uno mejor, el mejor
+  anterior volvia a la cola en ese punto. Eso reordena la cola en cada
+  despacho, y el orden importa cuando dos procesos tienen la misma clave.
+  El resultado es el mismo si los procesos entran a la cola en el mismo
+  orden; las llegadas simultaneas ahora entran en el orden de la entrada
+  (ver ColaLlegadas), que con mas de 16 procesos puede no ser el de la
+  version original.
+  
+  Solo hace falta el orden entre procesos de la misma clave (una clase), y
+  ese orden se puede llevar sin la cola completa:
+  - Un proceso esta tapado mientras haya uno de menor clave delante. Al
+    entrar queda detras de todos, asi que lo tapan los g de menor clave que
+    hay en la cola, y cada despacho pasa exactamente uno de ellos por
+    delante: se destapa despues de g despachos.
+  - Los visibles (no tapados) de una clase son los primeros de ella. En
+    cada despacho que no es de su clase, el primero pasa detras de los
+    demas visibles; los que se destapan en ese despacho quedan detras.
+  
+  Las clases van en un treap por clave con la cantidad de procesos de cada
+  subarbol, para sacar la menor y contar los de menor clave en O(log n).
+  Cada clase guarda sus visibles como un anillo y sus tapados en orden,
+  con el despacho en que se destapan. Las rotaciones y los destapados se
+  aplican de forma perezosa, solo cuando se toca la clase.
+ */
+class ColaPorRestante {
+private:
+    static constexpr std::uint32_t NINGUNA = ~std::uint32_t(0);
+    
+    // La clave se copia al insertar porque el tiempo restante de un
+    // proceso no cambia mientras espera en la cola
+    struct Clave {
+        int tiempoRestante;
+        int tiempoLlegada;
+        
+        bool operator<(const Clave& otra) const {
+            if (tiempoRestante != otra.tiempoRestante) return tiempoRestante < otra.tiempoRestante;
+            return tiempoLlegada < otra.tiempoLlegada;
+        }
+        bool operator==(const Clave& otra) const {
+            return tiempoRestante == otra.tiempoRestante && tiempoLlegada == otra.tiempoLlegada;
+        }
+    };
+    
+    // Proceso de una clase. Los visibles forman un anillo doblemente
+    // enlazado; los tapados, una lista en orden de cola
+    struct Miembro {
+        IdProceso id;
+        std::uint32_t siguiente;
+        std::uint32_t anterior;
+        std::uint64_t despacho;                   // Tapado: despacho despues del cual queda visible
+    };
+    
+    // Nodo del treap: una clase
+    struct Clase {
+        Clave clave;
+        std::uint32_t prioridad;
+        std::uint32_t izquierda;
+        std::uint32_t derecha;
+        std::uint32_t ultimoVisible;              // Fin del anillo (su siguiente es el primero)
+        std::uint32_t primerTapado;
+        std::uint32_t ultimoTapado;
+        std::uint32_t visibles;
+        std::uint32_t tapados;
+        std::uint64_t rotadoHasta;                // Despacho hasta el que el anillo esta al dia
+        std::size_t total;                        // Procesos en el subarbol
+        
+        std::size_t tamano() const { return (std::size_t)visibles + tapados; }
+    };
+    
+    std::pmr::vector<Clase> clases;               // Nodos del treap (con huecos reutilizables)
+    std::pmr::vector<std::uint32_t> clasesLibres;
+    std::pmr::vector<Miembro> miembros;
+    std::pmr::vector<std::uint32_t> miembrosLibres;
+    std::uint32_t raiz;
+    std::uint64_t despachos;                      // Despachos hechos
+    std::size_t cantidad;
+    std::uint32_t semilla;                        // Prioridades del treap (xorshift)
+    
+    std::size_t total(std::uint32_t nodo) const { return nodo == NINGUNA ? 0 : clases[nodo].total; }
+    void recalcular(std::uint32_t nodo) {
+        Clase& c = clases[nodo];
+        c.total = c.tamano() + total(c.izquierda) + total(c.derecha);
+    }
+    
+    std::uint32_t buscar(Clave clave, std::size_t& menores) const;
+    std::uint32_t crearClase(Clave clave);
+    void quitarClase(Clave clave);
+    void sumar(Clave clave, long long cambio);
+    std::uint32_t unir(std::uint32_t a, std::uint32_t b);
+    void separar(std::uint32_t nodo, Clave clave, std::uint32_t& menores, std::uint32_t& resto);
+    
+    std::uint32_t crearMiembro(IdProceso id, std::uint64_t despacho);
+    void agregarVisible(Clase& clase, std::uint32_t miembro);
+    void agregarTapado(Clase& clase, std::uint32_t miembro);
+    
+    // Aplica las rotaciones y los destapados de los despachos hasta
+    // 'despacho' (los tapados se destapan en orden, detras de los visibles)
+    void ponerAlDia(Clase& clase, std::uint64_t despacho);
+    void rotar(Clase& clase, std::uint64_t pasos);
+    
+    void insertar(IdProceso id, Clave clave);
+
+public:
+    explicit ColaPorRestante(std::pmr::memory_resource* memoria = std::pmr::get_default_resource());
+    
+    // Inserta al final con el tiempo restante actual como clave
+    void agregarProceso(IdProceso id, const TablaProcesos& tabla) {
+        insertar(id, Clave{tabla.getTiempoRestante(id), tabla.getTiempoLlegada(id)});
+    }
+    
+    // Saca el de menor tiempo restante (la cola no debe estar vacia)
+    IdProceso obtenerSiguienteProceso();
+    
+    // Lo que le pasa a la cola cuando se corta la rebanada de un proceso
+    // que sigue siendo el mejor (su clave es menor que todas): entra al
+    // final y se vuelve a sacar. Es un despacho que no saca a nadie
+    void repetirCorte() { despachos++; }
+    
+    bool estaVacia() const { return cantidad == 0; }
+    std::size_t tamano() const { return cantidad; }
+    
+    // Checkpoint: el contador de despachos y cada clase campo por campo,
+    // con sus visibles y sus tapados en orden
+    void guardar(EscritorBinario& escritor) const;
+    bool cargar(LectorBinario& lector, std::size_t maxId);
+};
+
+/*
+  Clase ColaNivel
+  
+  Almacenamiento de los procesos listos de un nivel del MLFQ configurado
+  en tiempo de ejecucion, guardados como ids de la TablaProcesos. La
+  estructura interna depende de la politica del nivel:
+  - Round Robin: ColaFIFO.
+  - SJF / STCF: ColaPorRestante.
+  
+  Los nodos de la cola y los arreglos de ColaPorRestante toman memoria del recurso
+  que se pasa al construirla (la Arena del scheduler).
+ */
+class ColaNivel {
+private:
+    bool porTiempoRestante;                       // true para SJF y STCF
+    ColaFIFO fifo;                                // Procesos listos (RR)
+    ColaPorRestante porRestante;                  // Procesos listos (SJF/STCF)
+
+public:
+    // Crea la cola vacia con la estructura adecuada para la politica
+    explicit ColaNivel(TipoPolitica politica = TipoPolitica::ROUND_ROBIN,
+                       std::pmr::memory_resource* memoria = std::pmr::get_default_resource());
+    
+    // Agrega un proceso listo a la cola (la tabla da la clave para SJF/STCF)
+    void agregarProceso(IdProceso id, const TablaProcesos& tabla);
+    
+    // Saca el siguiente proceso segun la politica (la cola no debe estar vacia)
+    IdProceso obtenerSiguienteProceso();
+    
+    // Ver ColaPorRestante::repetirCorte (solo SJF/STCF)
+    void repetirCorte() { porRestante.repetirCorte(); }
+    
+    bool estaVacia() const { return porTiempoRestante ? porRestante.estaVacia() : fifo.estaVacia(); }
+    std::size_t tamano() const { return porTiempoRestante ? porRestante.tamano() : fifo.tamano(); }
+    
+    // Checkpoint del contenido (ids menores a maxId); la politica no se
+    // guarda, la da el esquema
+    void guardar(EscritorBinario& escritor) const {
+        if (porTiempoRestante) porRestante.guardar(escritor);
+        else fifo.guardar(escritor);
+    }
+    
+    bool cargar(LectorBinario& lector, std::size_t maxId) {
+        return porTiempoRestante ? porRestante.cargar(lector, maxId) : fifo.cargar(lector, maxId);
+    }
+};
+
+/*
+  Clase MapaOcupacion
+  
+  Un bit por nivel, prendido mientras la cola de ese nivel tenga procesos.
+  Ademas guarda una palabra de resumen con un bit por cada grupo de 64
+  niveles que tenga alguno prendido, asi encontrar el nivel de mayor
+  prioridad con procesos son dos count-trailing-zeros (std::countr_zero)
+  sin importar cuantos niveles haya. Soporta hasta MAX_NIVELES niveles.
+ */
+class MapaOcupacion {
+public:
+    static constexpr int MAX_NIVELES = 64 * 64;
+
+private:
+    std::uint64_t resumen;                        // Bit w: palabras[w] no es cero
+    std::vector<std::uint64_t> palabras;          // Bit i de la palabra w: nivel 64*w + i
+
+public:
+    explicit MapaOcupacion(int niveles = 0) : resumen(0), palabras((niveles + 63) / 64, 0) {}
+    
+    void marcar(int nivel) {
+        palabras[nivel >> 6] |= std::uint64_t(1) << (nivel & 63);
+        resumen |= std::uint64_t(1) << (nivel >> 6);
+    }
+    
+    void desmarcar(int nivel) {
+        std::uint64_t& palabra = palabras[nivel >> 6];
+        palabra &= ~(std::uint64_t(1) << (nivel & 63));
+        if (palabra == 0) {
+            resumen &= ~(std::uint64_t(1) << (nivel >> 6));
+        }
+    }
+    
+    bool vacio() const { return resumen == 0; }
+    
+    // Nivel de mayor prioridad (menor indice) marcado, o -1 si no hay
+    int primero() const {
+        if (resumen == 0) {
+            return -1;
+        }
+        int palabra = std::countr_zero(resumen);
+        return palabra * 64 + std::countr_zero(palabras[palabra]);
+    }
+    
+    void limpiar() {
+        resumen = 0;
+        std::fill(palabras.begin(), palabras.end(), 0);
+    }
+};
+
+#endif
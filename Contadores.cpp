@@ -0,0 +1,191 @@
+#include "Contadores.h"
+#include <iomanip>
+
+void ContadoresScheduler::reiniciar(std::size_t cantidadNiveles) {
+    niveles.assign(cantidadNiveles, ContadoresNivel());
+    saltosOciosos = 0;
+    tiempoOcioso = 0;
+    boosts = 0;
+    promovidosBoost = 0;
+    despertares = 0;
+    enviosRecibidos = 0;
+    enviosTardios = 0;
+}
+
+/*
+  Guarda los contadores para un checkpoint
+  
+  Cada nivel se escribe campo por campo, en el orden en que estan
+  declarados.
+ */
+void ContadoresScheduler::guardar(EscritorBinario& escritor) const {
+    escritor.escribir((std::uint64_t)niveles.size());
+    for (const ContadoresNivel& n : niveles) {
+        escritor.escribir(n.despachos);
+        escritor.escribir(n.tiempoEjecutado);
+        escritor.escribir(n.terminados);
+        escritor.escribir(n.degradaciones);
+        escritor.escribir(n.reencolados);
+        escritor.escribir(n.rebanadasUnitarias);
+        escritor.escribir(n.bloqueos);
+        escritor.escribir(n.encolados);
+        escritor.escribir(n.sumaProfundidad);
+        escritor.escribir(n.profundidadMaxima);
+    }
+    escritor.escribir(saltosOciosos);
+    escritor.escribir(tiempoOcioso);
+    escritor.escribir(boosts);
+    escritor.escribir(promovidosBoost);
+    escritor.escribir(despertares);
+    escritor.escribir(enviosRecibidos);
+    escritor.escribir(enviosTardios);
+}
+
+/*
+  Carga contadores guardados con guardar
+  
+  La cantidad de niveles tiene que ser la misma que ya tenian (el
+  scheduler los crea con su esquema antes de cargar).
+ */
+bool ContadoresScheduler::cargar(LectorBinario& lector) {
+    std::uint64_t cantidadNiveles = 0;
+    lector.leer(cantidadNiveles);
+    if (cantidadNiveles != niveles.size()) {
+        lector.fallar();
+    }
+    for (ContadoresNivel& n : niveles) {
+        lector.leer(n.despachos);
+        lector.leer(n.tiempoEjecutado);
+        lector.leer(n.terminados);
+        lector.leer(n.degradaciones);
+        lector.leer(n.reencolados);
+        lector.leer(n.rebanadasUnitarias);
+        lector.leer(n.bloqueos);
+        lector.leer(n.encolados);
+        lector.leer(n.sumaProfundidad);
+        lector.leer(n.profundidadMaxima);
+    }
+    lector.leer(saltosOciosos);
+    lector.leer(tiempoOcioso);
+    lector.leer(boosts);
+    lector.leer(promovidosBoost);
+    lector.leer(despertares);
+    lector.leer(enviosRecibidos);
+    lector.leer(enviosTardios);
+    return lector.bien();
+}
+
+// Largo promedio de la cola al encolar
+static double profundidadPromedio(const ContadoresNivel& n) {
+    return n.encolados > 0 ? (double)n.sumaProfundidad / n.encolados : 0.0;
+}
+
+/*
+  Escribe los contadores como un objeto JSON
+  
+  Los totales van arriba y los niveles en un arreglo, en orden de
+  prioridad. Los nombres de politica no llevan comillas ni barras, asi
+  que se escriben tal cual.
+ */
+void ContadoresScheduler::escribirJSON(std::ostream& salida, const std::vector<std::string>& nombres, int tiempoTotal) const {
+    std::uint64_t despachos = 0;
+    for (const ContadoresNivel& n : niveles) despachos += n.despachos;
+    
+    salida << "{\n";
+    salida << "  \"tiempoTotal\": " << tiempoTotal << ",\n";
+    salida << "  \"despachos\": " << despachos << ",\n";
+    salida << "  \"saltosOciosos\": " << saltosOciosos << ",\n";
+    salida << "  \"tiempoOcioso\": " << tiempoOcioso << ",\n";
+    salida << "  \"boosts\": " << boosts << ",\n";
+    salida << "  \"promovidosBoost\": " << promovidosBoost << ",\n";
+    salida << "  \"despertares\": " << despertares << ",\n";
+    salida << "  \"enviosRecibidos\": " << enviosRecibidos << ",\n";
+    salida << "  \"enviosTardios\": " << enviosTardios << ",\n";
+    salida << "  \"niveles\": [";
+    for (std::size_t i = 0; i < niveles.size(); i++) {
+        const ContadoresNivel& n = niveles[i];
+        salida << (i == 0 ? "\n" : ",\n");
+        salida << "    {\"nivel\": " << i + 1
+               << ", \"politica\": \"" << (i < nombres.size() ? nombres[i] : "") << "\""
+               << ", \"despachos\": " << n.despachos
+               << ", \"tiempoEjecutado\": " << n.tiempoEjecutado
+               << ", \"terminados\": " << n.terminados
+               << ", \"degradaciones\": " << n.degradaciones
+               << ", \"reencolados\": " << n.reencolados
+               << ", \"rebanadasUnitarias\": " << n.rebanadasUnitarias
+               << ", \"bloqueos\": " << n.bloqueos
+               << ", \"encolados\": " << n.encolados
+               << ", \"profundidadPromedio\": " << std::fixed << std::setprecision(2) << profundidadPromedio(n)
+               << ", \"profundidadMaxima\": " << n.profundidadMaxima << "}";
+    }
+    salida << (niveles.empty() ? "]\n" : "\n  ]\n");
+    salida << "}\n";
+}
+
+/*
+  Escribe los contadores en el formato de texto de Prometheus
+  
+  Cada contador por nivel es una metrica con las etiquetas nivel y
+  politica; los totales van sin etiquetas. Todo lleva el prefijo mlfq_.
+ */
+void ContadoresScheduler::escribirPrometheus(std::ostream& salida, const std::vector<std::string>& nombres, int tiempoTotal) const {
+    struct Serie {
+        const char* nombre;
+        const char* tipo;
+        const char* ayuda;
+        std::uint64_t ContadoresNivel::* campo;
+    };
+    static const Serie SERIES[] = {
+        {"mlfq_despachos_total", "counter", "Rebanadas ejecutadas desde el nivel", &ContadoresNivel::despachos},
+        {"mlfq_tiempo_ejecutado_total", "counter", "Unidades de CPU ejecutadas en el nivel", &ContadoresNivel::tiempoEjecutado},
+        {"mlfq_terminados_total", "counter", "Procesos que terminaron en el nivel", &ContadoresNivel::terminados},
+        {"mlfq_degradaciones_total", "counter", "Procesos que bajaron del nivel al siguiente", &ContadoresNivel::degradaciones},
+        {"mlfq_reencolados_total", "counter", "Procesos que volvieron al mismo nivel sin terminar", &ContadoresNivel::reencolados},
+        {"mlfq_rebanadas_unitarias_total", "counter", "Rebanadas STCF de una unidad", &ContadoresNivel::rebanadasUnitarias},
+        {"mlfq_bloqueos_total", "counter", "Procesos que se bloquearon en E/S desde el nivel", &ContadoresNivel::bloqueos},
+        {"mlfq_encolados_total", "counter", "Veces que un proceso entro a la cola", &ContadoresNivel::encolados},
+        {"mlfq_profundidad_maxima", "gauge", "Largo maximo de la cola", &ContadoresNivel::profundidadMaxima},
+    };
+    
+    for (const Serie& serie : SERIES) {
+        salida << "# HELP " << serie.nombre << " " << serie.ayuda << "\n";
+        salida << "# TYPE " << serie.nombre << " " << serie.tipo << "\n";
+        for (std::size_t i = 0; i < niveles.size(); i++) {
+            salida << serie.nombre << "{nivel=\"" << i + 1 << "\",politica=\""
+                   << (i < nombres.size() ? nombres[i] : "") << "\"} " << niveles[i].*serie.campo << "\n";
+        }
+    }
+    
+    salida << "# HELP mlfq_profundidad_promedio Largo promedio de la cola al encolar\n";
+    salida << "# TYPE mlfq_profundidad_promedio gauge\n";
+    for (std::size_t i = 0; i < niveles.size(); i++) {
+        salida << "mlfq_profundidad_promedio{nivel=\"" << i + 1 << "\",politica=\""
+               << (i < nombres.size() ? nombres[i] : "") << "\"} "
+               << std::fixed << std::setprecision(2) << profundidadPromedio(niveles[i]) << "\n";
+    }
+    
+    salida << "# HELP mlfq_tiempo_total Tiempo de simulacion al terminar\n";
+    salida << "# TYPE mlfq_tiempo_total gauge\n";
+    salida << "mlfq_tiempo_total " << tiempoTotal << "\n";
+    salida << "# HELP mlfq_saltos_ociosos_total Veces que la CPU quedo ociosa hasta la siguiente llegada\n";
+    salida << "# TYPE mlfq_saltos_ociosos_total counter\n";
+    salida << "mlfq_saltos_ociosos_total " << saltosOciosos << "\n";
+    salida << "# HELP mlfq_tiempo_ocioso_total Unidades de tiempo sin nada que ejecutar\n";
+    salida << "# TYPE mlfq_tiempo_ocioso_total counter\n";
+    salida << "mlfq_tiempo_ocioso_total " << tiempoOcioso << "\n";
+    salida << "# HELP mlfq_boosts_total Boosts aplicados\n";
+    salida << "# TYPE mlfq_boosts_total counter\n";
+    salida << "mlfq_boosts_total " << boosts << "\n";
+    salida << "# HELP mlfq_promovidos_boost_total Procesos devueltos al nivel 0 por un boost\n";
+    salida << "# TYPE mlfq_promovidos_boost_total counter\n";
+    salida << "mlfq_promovidos_boost_total " << promovidosBoost << "\n";
+    salida << "# HELP mlfq_despertares_total Procesos que volvieron a una cola al terminar su E/S\n";
+    salida << "# TYPE mlfq_despertares_total counter\n";
+    salida << "mlfq_despertares_total " << despertares << "\n";
+    salida << "# HELP mlfq_envios_recibidos_total Procesos recibidos de otros hilos\n";
+    salida << "# TYPE mlfq_envios_recibidos_total counter\n";
+    salida << "mlfq_envios_recibidos_total " << enviosRecibidos << "\n";
+    salida << "# HELP mlfq_envios_tardios_total Procesos recibidos despues de su tiempo de llegada\n";
+    salida << "# TYPE mlfq_envios_tardios_total counter\n";
+    salida << "mlfq_envios_tardios_total " << enviosTardios << "\n";
+}
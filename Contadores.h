@@ -0,0 +1,83 @@
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include "Binario.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Formato del reporte de contadores
+enum class FormatoContadores {
+    JSON,
+    PROMETHEUS
+};
+
+// Lo que hizo el scheduler en un nivel
+struct ContadoresNivel {
+    std::uint64_t despachos = 0;           // Rebanadas ejecutadas desde este nivel
+    std::uint64_t tiempoEjecutado = 0;     // Unidades de CPU de esas rebanadas
+    std::uint64_t terminados = 0;          // Procesos que terminaron en este nivel
+    std::uint64_t degradaciones = 0;       // RR que no termino y bajo al siguiente nivel
+    std::uint64_t reencolados = 0;         // Volvieron a este mismo nivel sin terminar
+                                           // (STCF expropiado o RR en el ultimo nivel)
+    std::uint64_t rebanadasUnitarias = 0;  // Rebanadas STCF de una sola unidad
+    std::uint64_t bloqueos = 0;            // Terminaron una rafaga de CPU y se bloquearon en E/S
+    std::uint64_t encolados = 0;           // Veces que un proceso entro a la cola
+    std::uint64_t sumaProfundidad = 0;     // Suma del largo de la cola al encolar
+    std::uint64_t profundidadMaxima = 0;   // Largo maximo que tuvo la cola
+};
+
+/*
+  Clase ContadoresScheduler
+  
+  Contadores de lo que hace el motor de simulacion, pensados para dejarse
+  siempre activos: cada evento solo suma a un entero del nivel, sin
+  reservar memoria ni tomar tiempos. La profundidad de cada cola se mide
+  cuando un proceso entra a ella (despues de agregarlo), asi el promedio
+  es el largo que encuentra un proceso al llegar a ese nivel.
+  
+  Al final se pueden escribir como JSON o en el formato de texto de
+  Prometheus; los niveles se identifican por su numero (desde 1) y su
+  politica.
+ */
+class ContadoresScheduler {
+private:
+    std::vector<ContadoresNivel> niveles;
+
+public:
+    std::uint64_t saltosOciosos = 0;     // Veces que la CPU quedo ociosa y el tiempo salto a una llegada
+    std::uint64_t tiempoOcioso = 0;      // Unidades de tiempo saltadas sin nada que ejecutar
+    std::uint64_t boosts = 0;            // Boosts aplicados (con algun proceso en las colas)
+    std::uint64_t promovidosBoost = 0;   // Procesos que un boost devolvio al nivel 0
+    std::uint64_t despertares = 0;       // Procesos que volvieron a una cola al terminar su E/S
+    std::uint64_t enviosRecibidos = 0;   // Procesos recibidos de otros hilos con enviarProceso
+    std::uint64_t enviosTardios = 0;     // De esos, los que llegaron despues de su tiempo de llegada
+    
+    explicit ContadoresScheduler(std::size_t cantidadNiveles = 0) : niveles(cantidadNiveles) {}
+    
+    // Vuelve todo a 0 con la cantidad de niveles dada
+    void reiniciar(std::size_t cantidadNiveles);
+    
+    ContadoresNivel& nivel(std::size_t i) { return niveles[i]; }
+    const std::vector<ContadoresNivel>& getNiveles() const { return niveles; }
+    
+    // Registra que un proceso entro a la cola i, que ahora tiene 'profundidad' procesos
+    void encolado(std::size_t i, std::size_t profundidad) {
+        ContadoresNivel& n = niveles[i];
+        n.encolados++;
+        n.sumaProfundidad += profundidad;
+        if (profundidad > n.profundidadMaxima) n.profundidadMaxima = profundidad;
+    }
+    
+    // Checkpoint de todos los contadores
+    void guardar(EscritorBinario& escritor) const;
+    bool cargar(LectorBinario& lector);
+    
+    // Reportes; 'nombres' tiene la politica de cada nivel (por ejemplo "RR-2")
+    void escribirJSON(std::ostream& salida, const std::vector<std::string>& nombres, int tiempoTotal) const;
+    void escribirPrometheus(std::ostream& salida, const std::vector<std::string>& nombres, int tiempoTotal) const;
+};
+
+#endif
@@ -0,0 +1,294 @@
+#include "EjecutorTareas.h"
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+
+/*
+  Constructor
+  
+  Arma una cola por nivel segun su politica (FIFO para Round Robin, heap
+  por tiempo restante para SJF y STCF) y crea los hilos trabajadores. Si
+  no se indica cantidad se usa la que reporta el sistema (al menos uno).
+ */
+EjecutorTareas::EjecutorTareas(const std::vector<EsquemaCola>& esquemas, const ConfiguracionEjecutor& config)
+    : esquemas(esquemas), config(config), origen(Reloj::now()),
+      fifos(esquemas.size()), heaps(esquemas.size()), ocupadas((int)esquemas.size()),
+      siguienteSecuencia(0), lanzamientos(0), pendientes(0), cerrando(false),
+      contadores(esquemas.size()) {
+    std::size_t hilos = config.hilos;
+    if (hilos == 0) {
+        hilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    trabajadores.reserve(hilos);
+    for (std::size_t i = 0; i < hilos; i++) {
+        trabajadores.emplace_back(&EjecutorTareas::trabajar, this);
+    }
+}
+
+/*
+  Destructor
+  
+  Deja terminar las tareas lanzadas (sin relanzar sus errores) y luego
+  despierta a todos los hilos para que salgan.
+ */
+EjecutorTareas::~EjecutorTareas() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        esperarPendientes(lock);
+        cerrando = true;
+    }
+    hayTarea.notify_all();
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+long long EjecutorTareas::ahora() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Reloj::now() - origen).count();
+}
+
+bool EjecutorTareas::lanzar(std::string etiqueta, Tarea tarea, int cola, long long estimacion) {
+    if (!tarea.esValida() || tarea.termino()) {
+        return false;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EstadoTarea* libre = nullptr;
+        if (!estadosLibres.empty()) {
+            libre = estadosLibres.back();
+            estadosLibres.pop_back();
+        }
+        EstadoTarea& estado = libre ? *libre : tareas.emplace_back();
+        estado.tarea = std::move(tarea);
+        estado.resultado = ResultadoTarea{std::move(etiqueta), std::max(0LL, estimacion), cola, 0,
+                                          ahora(), 0, 0, 0, 0, 0, false};
+        estado.restante = std::max(0LL, estimacion);
+        estado.haIniciado = false;
+        pendientes++;
+        lanzamientos.fetch_add(1, std::memory_order_relaxed);
+        
+        // Igual que las llegadas del simulador: la cola viene desde 1 y si
+        // el esquema tiene menos colas la tarea entra a la ultima
+        int nivel = std::max(0, std::min(cola, (int)esquemas.size()) - 1);
+        encolar(&estado, nivel);
+    }
+    hayTarea.notify_one();
+    return true;
+}
+
+void EjecutorTareas::esperar() {
+    std::unique_lock<std::mutex> lock(mutex);
+    esperarPendientes(lock);
+    if (primerError) {
+        std::exception_ptr error = primerError;
+        primerError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void EjecutorTareas::esperarPendientes(std::unique_lock<std::mutex>& lock) {
+    terminado.wait(lock, [this] { return pendientes == 0; });
+}
+
+void EjecutorTareas::encolar(EstadoTarea* estado, int nivel) {
+    estado->nivel = nivel;
+    std::size_t profundidad;
+    if (esquemas[nivel].politica == TipoPolitica::ROUND_ROBIN) {
+        fifos[nivel].push_back(estado);
+        profundidad = fifos[nivel].size();
+    } else {
+        std::vector<EntradaRestante>& heap = heaps[nivel];
+        heap.push_back(EntradaRestante{estado->restante, siguienteSecuencia++, estado});
+        std::push_heap(heap.begin(), heap.end(), std::greater<EntradaRestante>());
+        profundidad = heap.size();
+    }
+    ocupadas.marcar(nivel);
+    contadores.encolado(nivel, profundidad);
+}
+
+// Saca la siguiente tarea del nivel de mayor prioridad (debe haber alguna)
+EjecutorTareas::EstadoTarea* EjecutorTareas::sacarSiguiente() {
+    int nivel = ocupadas.primero();
+    EstadoTarea* estado;
+    bool vacia;
+    if (esquemas[nivel].politica == TipoPolitica::ROUND_ROBIN) {
+        estado = fifos[nivel].front();
+        fifos[nivel].pop_front();
+        vacia = fifos[nivel].empty();
+    } else {
+        std::vector<EntradaRestante>& heap = heaps[nivel];
+        std::pop_heap(heap.begin(), heap.end(), std::greater<EntradaRestante>());
+        estado = heap.back().estado;
+        heap.pop_back();
+        vacia = heap.empty();
+    }
+    if (vacia) {
+        ocupadas.desmarcar(nivel);
+    }
+    return estado;
+}
+
+/*
+  Bucle de un hilo trabajador
+  
+  Saca la tarea de mayor prioridad y ejecuta su rebanada fuera del
+  mutex. Sale cuando el ejecutor se destruye y no quedan tareas listas.
+ */
+void EjecutorTareas::trabajar() {
+    while (true) {
+        EstadoTarea* estado;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hayTarea.wait(lock, [this] { return cerrando || !ocupadas.vacio(); });
+            if (ocupadas.vacio()) {
+                return;
+            }
+            estado = sacarSiguiente();
+        }
+        ejecutarRebanada(*estado);
+    }
+}
+
+/*
+  Ejecuta una rebanada de una tarea
+  
+  Reanuda la tarea hasta que termina o hasta que la rebanada se acaba en
+  alguno de sus ceder(): Round Robin al agotar el quantum, STCF cuando se
+  lanzo otra tarea desde que empezo la rebanada y SJF nunca. Lo
+  consumido se cuenta en la medida del quantum (cedidas o unidades de
+  tiempo) y se descuenta de la estimacion. Despues, con el mutex, la
+  tarea se finaliza o se reencola como en MLFQScheduler::ejecutarRebanada:
+  Round Robin la degrada a la siguiente cola y STCF la devuelve a la
+  misma.
+ */
+void EjecutorTareas::ejecutarRebanada(EstadoTarea& estado) {
+    const int nivel = estado.nivel;
+    const EsquemaCola& esquema = esquemas[nivel];
+    const std::uint64_t lanzadasAlInicio = lanzamientos.load(std::memory_order_relaxed);
+    const Reloj::time_point inicio = Reloj::now();
+    const Reloj::duration limiteTiempo = config.unidad * std::max(1, esquema.quantum);
+    
+    if (!estado.haIniciado) {
+        estado.resultado.inicio = std::chrono::duration_cast<std::chrono::microseconds>(inicio - origen).count();
+        estado.haIniciado = true;
+    }
+    
+    std::uint64_t cedidas = 0;
+    while (true) {
+        estado.tarea.reanudar();
+        if (estado.tarea.termino()) {
+            break;
+        }
+        cedidas++;
+        
+        bool finRebanada = false;
+        switch (esquema.politica) {
+            case TipoPolitica::ROUND_ROBIN:
+                finRebanada = config.medida == MedidaQuantum::CEDIDAS
+                            ? cedidas >= (std::uint64_t)std::max(1, esquema.quantum)
+                            : Reloj::now() - inicio >= limiteTiempo;
+                break;
+            case TipoPolitica::SJF:
+                break;
+            case TipoPolitica::STCF:
+                finRebanada = lanzamientos.load(std::memory_order_relaxed) != lanzadasAlInicio;
+                break;
+        }
+        if (finRebanada) {
+            break;
+        }
+    }
+    
+    const Reloj::time_point fin = Reloj::now();
+    const long long duracion = std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count();
+    const long long consumido = config.medida == MedidaQuantum::CEDIDAS
+                              ? (long long)cedidas : duracion / std::max<long long>(1, config.unidad.count());
+    const bool termino = estado.tarea.termino();
+    
+    estado.resultado.cpu += duracion;
+    estado.resultado.cedidas += cedidas;
+    estado.resultado.rebanadas++;
+    estado.restante = std::max(0LL, estado.restante - consumido);
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ContadoresNivel& contador = contadores.nivel(nivel);
+        contador.despachos++;
+        contador.tiempoEjecutado += consumido;
+        
+        if (termino) {
+            // La tarea termino
+            ResultadoTarea& resultado = estado.resultado;
+            resultado.fin = std::chrono::duration_cast<std::chrono::microseconds>(fin - origen).count();
+            resultado.nivelFinal = nivel;
+            std::exception_ptr error = estado.tarea.getError();
+            resultado.fallo = error != nullptr;
+            if (error && !primerError) {
+                primerError = error;
+            }
+            estado.tarea = Tarea();
+            
+            contador.terminados++;
+            metricas.agregar(resultado.cpu, resultado.getWT(), resultado.fin, resultado.getRT(), resultado.getTAT());
+            
+            // Con el resultado guardado el estado ya no se necesita: queda
+            // libre para la siguiente tarea que se lance
+            finalizadas.push_back(std::move(resultado));
+            estadosLibres.push_back(&estado);
+            if (--pendientes == 0) {
+                terminado.notify_all();
+            }
+            return;
+        }
+        
+        if (esquema.politica == TipoPolitica::ROUND_ROBIN) {
+            // No termino su quantum: degradarla a la siguiente cola
+            int nuevaCola = std::min(nivel + 1, (int)esquemas.size() - 1);
+            if (nuevaCola != nivel) {
+                contador.degradaciones++;
+            } else {
+                contador.reencolados++;
+            }
+            encolar(&estado, nuevaCola);
+        } else {
+            // Expropiada: vuelve a la misma cola
+            contador.reencolados++;
+            encolar(&estado, nivel);
+        }
+    }
+    hayTarea.notify_one();
+}
+
+std::vector<ResultadoTarea> EjecutorTareas::getResultados() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return finalizadas;
+}
+
+void EjecutorTareas::calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const {
+    metricas.calcularPromedios(promWT, promCT, promRT, promTAT);
+}
+
+/*
+  Escribe los resultados
+  
+  Una linea por tarea en orden de finalizacion, con los tiempos en
+  microsegundos, y al final los promedios con el mismo formato del
+  archivo de salida del simulador.
+ */
+void EjecutorTareas::escribirResultados(std::ostream& salida) {
+    salida << "# etiqueta; estimacion; Q; nivel final; cedidas; rebanadas; CPU; AT; WT; CT; RT; TAT\n";
+    for (const ResultadoTarea& r : getResultados()) {
+        salida << r.etiqueta << ";" << r.estimacion << ";" << r.colaInicial << ";" << r.nivelFinal + 1 << ";"
+               << r.cedidas << ";" << r.rebanadas << ";" << r.cpu << ";" << r.llegada << ";"
+               << r.getWT() << ";" << r.fin << ";" << r.getRT() << ";" << r.getTAT()
+               << (r.fallo ? ";error" : "") << "\n";
+    }
+    
+    double promWT, promCT, promRT, promTAT;
+    calcularPromedios(promWT, promCT, promRT, promTAT);
+    salida << std::fixed << std::setprecision(1);
+    salida << "WT=" << promWT << ";CT=" << promCT
+           << ";RT=" << promRT << ";TAT=" << promTAT << ";" << std::endl;
+}
@@ -0,0 +1,247 @@
+#ifndef EJECUTORTAREAS_H
+#define EJECUTORTAREAS_H
+
+#include "MLFQScheduler.h"
+#include "Contadores.h"
+#include "Metricas.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+  Clase Tarea
+  
+  Corrutina de C++20 que ejecuta trabajo real dentro de un EjecutorTareas.
+  Se crea suspendida y solo avanza cuando un hilo del ejecutor la
+  reanuda; cada co_await ceder() devuelve el control al ejecutor, que
+  decide si la rebanada sigue o si la tarea vuelve a su cola. Una
+  excepcion que se escape de la tarea se guarda en la promesa.
+      
+      Tarea trabajo(int pasos) {
+          for (int i = 0; i < pasos; i++) {
+              calcular(i);
+              co_await ceder();
+          }
+      }
+ */
+class Tarea {
+public:
+    struct promise_type {
+        std::exception_ptr error;
+        
+        Tarea get_return_object() { return Tarea(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+    
+    Tarea() = default;
+    Tarea(Tarea&& otra) noexcept : manejador(otra.manejador) { otra.manejador = nullptr; }
+    Tarea& operator=(Tarea&& otra) noexcept {
+        if (this != &otra) {
+            destruir();
+            manejador = otra.manejador;
+            otra.manejador = nullptr;
+        }
+        return *this;
+    }
+    ~Tarea() { destruir(); }
+    
+    Tarea(const Tarea&) = delete;
+    Tarea& operator=(const Tarea&) = delete;
+    
+    bool esValida() const { return manejador != nullptr; }
+    bool termino() const { return manejador.done(); }
+    
+    // Ejecuta hasta el siguiente ceder() o hasta terminar
+    void reanudar() { manejador.resume(); }
+    
+    std::exception_ptr getError() const { return manejador.promise().error; }
+
+private:
+    std::coroutine_handle<promise_type> manejador;
+    
+    explicit Tarea(std::coroutine_handle<promise_type> h) : manejador(h) {}
+    
+    void destruir() {
+        if (manejador) {
+            manejador.destroy();
+            manejador = nullptr;
+        }
+    }
+};
+
+// Punto donde una tarea cede el control al ejecutor: co_await ceder();
+inline std::suspend_always ceder() { return {}; }
+
+/*
+  Como se mide el quantum de los niveles Round Robin
+  CEDIDAS: un quantum de q son q llamadas a ceder()
+  TIEMPO:  un quantum de q son q unidades de tiempo real (ver
+           ConfiguracionEjecutor::unidad); la rebanada se corta en el
+           primer ceder() despues de agotarlo
+ */
+enum class MedidaQuantum {
+    CEDIDAS,
+    TIEMPO
+};
+
+struct ConfiguracionEjecutor {
+    std::size_t hilos = 0;                          // 0 = un hilo por nucleo
+    MedidaQuantum medida = MedidaQuantum::CEDIDAS;
+    std::chrono::microseconds unidad{1000};         // Duracion de una unidad con TIEMPO
+};
+
+// Resultado de una tarea terminada; los tiempos son microsegundos desde
+// que se creo el ejecutor
+struct ResultadoTarea {
+    std::string etiqueta;
+    long long estimacion;       // Unidades declaradas al lanzarla (0 = sin estimacion)
+    int colaInicial;            // Cola pedida (desde 1, como en los archivos)
+    int nivelFinal;             // Nivel en que termino (desde 0)
+    long long llegada;          // Cuando se lanzo
+    long long inicio;           // Primera vez que se ejecuto
+    long long fin;              // Cuando termino
+    long long cpu;              // Tiempo real ejecutando (suma de sus rebanadas)
+    std::uint64_t cedidas;      // Veces que llamo a ceder()
+    std::uint64_t rebanadas;    // Veces que se despacho
+    bool fallo;                 // Termino por una excepcion
+    
+    long long getTAT() const { return fin - llegada; }
+    long long getWT() const { return getTAT() - cpu; }
+    long long getRT() const { return inicio - llegada; }
+};
+
+/*
+  Clase EjecutorTareas
+  
+  Ejecuta corrutinas de verdad con la politica del MLFQ: las colas salen
+  del mismo esquema que usa MLFQScheduler y un pool de hilos saca
+  siempre la tarea del nivel de mayor prioridad con tareas listas
+  (MapaOcupacion). Como las tareas son cooperativas, una rebanada solo
+  se puede cortar en un ceder(); la tarea corre sin interrupciones entre
+  dos cesiones.
+  
+  Cada nivel se comporta como en MLFQScheduler::ejecutarRebanada:
+  - Round Robin: corre hasta agotar su quantum (en cedidas o en tiempo)
+    y, si no termino, baja al siguiente nivel (o se queda en el ultimo).
+  - SJF: corre hasta terminar.
+  - STCF: corre hasta terminar o hasta que se lance otra tarea, y en ese
+    caso vuelve a la misma cola para que se elija de nuevo.
+  SJF y STCF ordenan por la estimacion que se da al lanzar la tarea menos
+  lo que ya consumio (en la misma medida del quantum); sin estimacion
+  queda en 0 y el nivel atiende en orden de llegada.
+  
+  Las metricas son las del simulador medidas en tiempo real (WT, RT, TAT
+  y CT en microsegundos desde que se creo el ejecutor): el tiempo de
+  rafaga es lo que la tarea paso ejecutando, asi WT = TAT - CPU incluye
+  tanto la espera en las colas como la espera por un hilo libre.
+  
+  lanzar() se puede llamar desde cualquier hilo, incluso desde dentro de
+  una tarea. No hay boost ni E/S: una tarea que espera algo externo debe
+  ceder y volver a revisar.
+ */
+class EjecutorTareas {
+private:
+    using Reloj = std::chrono::steady_clock;
+    
+    // Una tarea viva; los campos de ejecucion solo los toca el hilo que
+    // la tiene despachada
+    struct EstadoTarea {
+        Tarea tarea;
+        ResultadoTarea resultado;
+        long long restante;             // Estimacion menos lo consumido (SJF/STCF)
+        int nivel;
+        bool haIniciado;
+    };
+    
+    // Entrada de un nivel SJF/STCF: la clave se copia al encolar
+    struct EntradaRestante {
+        long long restante;
+        std::uint64_t secuencia;
+        EstadoTarea* estado;
+        
+        bool operator>(const EntradaRestante& otra) const {
+            if (restante != otra.restante) return restante > otra.restante;
+            return secuencia > otra.secuencia;
+        }
+    };
+    
+    std::vector<EsquemaCola> esquemas;
+    ConfiguracionEjecutor config;
+    Reloj::time_point origen;
+    
+    std::mutex mutex;                                   // Protege todo lo de abajo
+    std::condition_variable hayTarea;                   // Avisa a los trabajadores
+    std::condition_variable terminado;                  // Avisa a quien espera en esperar()
+    std::deque<EstadoTarea> tareas;                     // Estados creados (direcciones estables)
+    std::vector<EstadoTarea*> estadosLibres;            // Estados de tareas ya terminadas, para reutilizar
+    std::vector<std::deque<EstadoTarea*>> fifos;        // Tareas listas de los niveles RR
+    std::vector<std::vector<EntradaRestante>> heaps;    // Tareas listas de los niveles SJF/STCF
+    MapaOcupacion ocupadas;
+    std::uint64_t siguienteSecuencia;
+    std::atomic<std::uint64_t> lanzamientos;            // Tareas lanzadas (corta las rebanadas STCF)
+    std::size_t pendientes;                             // Lanzadas que aun no terminan
+    bool cerrando;
+    std::exception_ptr primerError;
+    
+    std::vector<ResultadoTarea> finalizadas;            // En orden de finalizacion
+    AgregadorMetricas metricas;
+    ContadoresScheduler contadores;
+    
+    std::vector<std::thread> trabajadores;
+    
+    long long ahora() const;
+    
+    // Con el mutex tomado
+    void encolar(EstadoTarea* estado, int nivel);
+    EstadoTarea* sacarSiguiente();
+    void esperarPendientes(std::unique_lock<std::mutex>& lock);
+    
+    // Bucle de cada hilo trabajador y una rebanada de una tarea
+    void trabajar();
+    void ejecutarRebanada(EstadoTarea& estado);
+
+public:
+    EjecutorTareas(const std::vector<EsquemaCola>& esquemas, const ConfiguracionEjecutor& config = {});
+    
+    // Espera que terminen todas las tareas y detiene los hilos
+    ~EjecutorTareas();
+    
+    EjecutorTareas(const EjecutorTareas&) = delete;
+    EjecutorTareas& operator=(const EjecutorTareas&) = delete;
+    
+    // Agrega una tarea lista en su cola inicial (desde 1; si el esquema
+    // tiene menos colas entra a la ultima). 'estimacion' es la duracion
+    // esperada en unidades de quantum, para los niveles SJF y STCF.
+    // Retorna false si la tarea no es valida.
+    bool lanzar(std::string etiqueta, Tarea tarea, int cola = 1, long long estimacion = 0);
+    
+    // Bloquea hasta que terminen todas las tareas lanzadas; si alguna
+    // termino por una excepcion, relanza la primera
+    void esperar();
+    
+    // Resultados y metricas (llamar despues de esperar())
+    std::vector<ResultadoTarea> getResultados();
+    const AgregadorMetricas& getMetricas() const { return metricas; }
+    const ContadoresScheduler& getContadores() const { return contadores; }
+    void calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const;
+    
+    std::size_t getCantidadHilos() const { return trabajadores.size(); }
+    
+    // Una linea por tarea terminada, en orden de finalizacion
+    void escribirResultados(std::ostream& salida);
+};
+
+#endif
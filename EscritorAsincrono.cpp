@@ -0,0 +1,96 @@
+#include "EscritorAsincrono.h"
+#include <charconv>
+
+/*
+  Constructor
+  
+  Reserva el primer buffer y arranca el hilo escritor.
+ */
+EscritorAsincrono::EscritorAsincrono(std::ostream& salida, std::size_t tamBuffer)
+    : destino(salida), tamanoBuffer(tamBuffer), cerrando(false) {
+    actual.reserve(tamanoBuffer + 256);
+    hilo = std::thread(&EscritorAsincrono::trabajar, this);
+}
+
+EscritorAsincrono::~EscritorAsincrono() {
+    terminar();
+}
+
+void EscritorAsincrono::escribir(std::string_view texto) {
+    actual.append(texto.data(), texto.size());
+    if (actual.size() >= tamanoBuffer) {
+        entregar();
+    }
+}
+
+void EscritorAsincrono::escribir(long long valor) {
+    char digitos[24];
+    std::to_chars_result resultado = std::to_chars(digitos, digitos + sizeof(digitos), valor);
+    escribir(std::string_view(digitos, resultado.ptr - digitos));
+}
+
+/*
+  Entrega el buffer actual al escritor
+  
+  El buffer lleno se mueve a la cola de pendientes y se toma uno libre
+  (o uno nuevo si todos siguen pendientes).
+ */
+void EscritorAsincrono::entregar() {
+    if (actual.empty()) return;
+    
+    std::string siguiente;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        llenos.push_back(std::move(actual));
+        if (!libres.empty()) {
+            siguiente = std::move(libres.back());
+            libres.pop_back();
+        }
+    }
+    hayBuffer.notify_one();
+    
+    actual = std::move(siguiente);
+    actual.clear();
+    actual.reserve(tamanoBuffer + 256);
+}
+
+/*
+  Bucle del hilo escritor
+  
+  Saca buffers llenos en orden, los escribe fuera del mutex y los devuelve
+  vacios a la lista de libres. Sale cuando se pidio cerrar y ya no queda
+  nada pendiente.
+ */
+void EscritorAsincrono::trabajar() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        hayBuffer.wait(lock, [this] { return cerrando || !llenos.empty(); });
+        if (llenos.empty()) {
+            break;
+        }
+        
+        std::string buffer = std::move(llenos.front());
+        llenos.pop_front();
+        lock.unlock();
+        
+        destino.write(buffer.data(), (std::streamsize)buffer.size());
+        buffer.clear();
+        
+        lock.lock();
+        libres.push_back(std::move(buffer));
+    }
+    lock.unlock();
+    destino.flush();
+}
+
+void EscritorAsincrono::terminar() {
+    if (!hilo.joinable()) return;
+    
+    entregar();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cerrando = true;
+    }
+    hayBuffer.notify_one();
+    hilo.join();
+}
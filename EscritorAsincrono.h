@@ -0,0 +1,60 @@
+#ifndef ESCRITORASINCRONO_H
+#define ESCRITORASINCRONO_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/*
+  Clase EscritorAsincrono
+  
+  Escribe texto a un flujo (pantalla o archivo) desde un hilo aparte. El
+  hilo que produce el texto solo lo copia a un buffer grande en memoria;
+  cuando el buffer se llena se entrega al hilo escritor y se sigue con
+  otro buffer libre. Si el escritor va atrasado se crea un buffer nuevo en
+  vez de esperar, asi quien produce nunca se bloquea por la pantalla o el
+  disco (solo toma un mutex un instante al entregar el buffer).
+  
+  Solo un hilo puede llamar a escribir(). terminar() entrega lo que falte,
+  espera a que todo quede escrito y detiene el hilo.
+ */
+class EscritorAsincrono {
+private:
+    std::ostream& destino;                  // Donde se escribe al final
+    std::size_t tamanoBuffer;               // Bytes a partir de los cuales se entrega un buffer
+    std::string actual;                     // Buffer que se esta llenando
+    std::deque<std::string> llenos;         // Buffers pendientes de escribir
+    std::vector<std::string> libres;        // Buffers ya escritos, para reutilizar
+    std::mutex mutex;
+    std::condition_variable hayBuffer;
+    bool cerrando;
+    std::thread hilo;
+    
+    // Pasa el buffer actual al escritor y toma uno libre
+    void entregar();
+    
+    // Bucle del hilo escritor
+    void trabajar();
+
+public:
+    explicit EscritorAsincrono(std::ostream& salida, std::size_t tamBuffer = 1 << 20);
+    ~EscritorAsincrono();
+    
+    EscritorAsincrono(const EscritorAsincrono&) = delete;
+    EscritorAsincrono& operator=(const EscritorAsincrono&) = delete;
+    
+    // Agrega texto o un entero en decimal
+    void escribir(std::string_view texto);
+    void escribir(long long valor);
+    
+    // Escribe todo lo pendiente y detiene el hilo (se puede llamar varias veces)
+    void terminar();
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef ESCRITORTEXTO_H
+#define ESCRITORTEXTO_H
+
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/*
+  Clase EscritorTexto
+  
+  Salida de texto con buffer propio: los numeros se escriben con
+  std::to_chars y todo se junta en un buffer que se entrega al flujo de
+  a 1 MB, sin pasar por el formateo de iostream en cada campo. Los
+  decimales salen igual que con std::fixed y std::setprecision.
+  
+  Sin flujo de destino el texto solo se acumula; contenido() lo devuelve
+  y limpiar() lo descarta (asi se arma una linea suelta).
+ */
+class EscritorTexto {
+private:
+    static constexpr std::size_t TAMANO_BUFFER = 1 << 20;
+    
+    std::ostream* destino;      // nullptr = solo acumular
+    std::string buffer;
+    
+    void revisar() {
+        if (destino != nullptr && buffer.size() >= TAMANO_BUFFER) vaciar();
+    }
+
+public:
+    explicit EscritorTexto(std::ostream* salida = nullptr, std::size_t reserva = TAMANO_BUFFER + 256)
+        : destino(salida) { buffer.reserve(reserva); }
+    explicit EscritorTexto(std::ostream& salida) : EscritorTexto(&salida) {}
+    ~EscritorTexto() { vaciar(); }
+    
+    EscritorTexto(const EscritorTexto&) = delete;
+    EscritorTexto& operator=(const EscritorTexto&) = delete;
+    
+    // Entrega lo acumulado al flujo (sin flush del flujo)
+    void vaciar() {
+        if (destino != nullptr && !buffer.empty()) {
+            destino->write(buffer.data(), (std::streamsize)buffer.size());
+            buffer.clear();
+        }
+    }
+    
+    void texto(std::string_view t) {
+        buffer.append(t.data(), t.size());
+        revisar();
+    }
+    
+    void caracter(char c) {
+        buffer.push_back(c);
+        revisar();
+    }
+    
+    void entero(long long valor) {
+        char digitos[24];
+        std::to_chars_result resultado = std::to_chars(digitos, digitos + sizeof(digitos), valor);
+        texto(std::string_view(digitos, resultado.ptr - digitos));
+    }
+    
+    // Numero con 'decimales' cifras despues del punto
+    void decimal(double valor, int decimales) {
+        char digitos[352];
+        std::to_chars_result resultado = std::to_chars(digitos, digitos + sizeof(digitos), valor,
+                                                       std::chars_format::fixed, decimales);
+        texto(std::string_view(digitos, resultado.ptr - digitos));
+    }
+    
+    // Solo sin destino
+    std::string_view contenido() const { return buffer; }
+    void limpiar() { buffer.clear(); }
+};
+
+#endif
@@ -0,0 +1,211 @@
+#include "Esquemas.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/*
+  Define los esquemas de configuracion predefinidos
+  
+  Cada esquema tiene una configuracion diferente de colas y algoritmos:
+  
+  Esquema 1: RR(1), RR(3), RR(4), SJF
+  - Quantums pequenos en las primeras colas para detectar trabajos interactivos
+  - SJF en la ultima cola para trabajos largos
+  
+  Esquema 2: RR(2), RR(3), RR(4), STCF  
+  - Similar al 1 pero con STCF en lugar de SJF
+  
+  Esquema 3: RR(3), RR(5), RR(6), RR(20)
+  - Solo Round Robin con quantums crecientes
+  
+  Con mostrar en false no se anuncia el esquema escogido.
+ */
+std::vector<EsquemaCola> obtenerEsquema(int numeroEsquema, bool mostrar) {
+    std::vector<EsquemaCola> esquemas;
+    
+    switch (numeroEsquema) {
+        case 1:
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 1));
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 3));
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 4));
+            esquemas.push_back(EsquemaCola(TipoPolitica::SJF));
+            if (mostrar) std::cout << "Usando Esquema 1: RR(1), RR(3), RR(4), SJF" << std::endl;
+            break;
+            
+        case 2:
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 2));
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 3));
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 4));
+            esquemas.push_back(EsquemaCola(TipoPolitica::STCF));
+            if (mostrar) std::cout << "Usando Esquema 2: RR(2), RR(3), RR(4), STCF" << std::endl;
+            break;
+            
+        case 3:
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 3));
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 5));
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 6));
+            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 20));
+            if (mostrar) std::cout << "Usando Esquema 3: RR(3), RR(5), RR(6), RR(20)" << std::endl;
+            break;
+            
+        default:
+            std::cerr << "Error: Esquema " << numeroEsquema << " no valido. Use 1, 2 o 3." << std::endl;
+            break;
+    }
+    
+    return esquemas;
+}
+
+/*
+  Describe un esquema en texto
+  
+  Usa la misma notacion que los mensajes de obtenerEsquema: RR(q) para
+  Round Robin y el nombre de la politica para SJF y STCF.
+ */
+std::string describirEsquema(const std::vector<EsquemaCola>& esquemas) {
+    std::string descripcion;
+    
+    for (size_t i = 0; i < esquemas.size(); i++) {
+        if (i > 0) descripcion += ", ";
+        
+        switch (esquemas[i].politica) {
+            case TipoPolitica::ROUND_ROBIN:
+                descripcion += "RR(" + std::to_string(esquemas[i].quantum) + ")";
+                break;
+            case TipoPolitica::SJF:
+                descripcion += "SJF";
+                break;
+            case TipoPolitica::STCF:
+                descripcion += "STCF";
+                break;
+        }
+    }
+    return descripcion;
+}
+
+/*
+  Parsea un nivel del archivo de esquema
+  
+  El nivel es RR(q), SJF o STCF (sin importar mayusculas), seguido
+  opcionalmente de *n para repetirlo n veces. Retorna false si el texto
+  no es un nivel valido o si el quantum no es un entero entre 1 e INT_MAX.
+ */
+static bool parsearNivel(const std::string& texto, std::vector<EsquemaCola>& esquemas) {
+    std::size_t finNombre = texto.find_first_of("(*");
+    std::string nombre = texto.substr(0, finNombre);
+    for (char& c : nombre) {
+        c = (char)std::toupper((unsigned char)c);
+    }
+    
+    std::size_t pos = finNombre == std::string::npos ? texto.size() : finNombre;
+    int quantum = -1;
+    if (pos < texto.size() && texto[pos] == '(') {
+        std::size_t cierre = texto.find(')', pos);
+        if (cierre == std::string::npos) {
+            return false;
+        }
+        // El quantum tiene que caber en un int: fuera de rango se rechaza
+        // en vez de truncarlo
+        char* fin = nullptr;
+        std::string numero = texto.substr(pos + 1, cierre - pos - 1);
+        errno = 0;
+        long valor = std::strtol(numero.c_str(), &fin, 10);
+        if (numero.empty() || *fin != '\0' || errno == ERANGE || valor <= 0 || valor > INT_MAX) {
+            return false;
+        }
+        quantum = (int)valor;
+        pos = cierre + 1;
+    }
+    
+    long repeticiones = 1;
+    if (pos < texto.size()) {
+        if (texto[pos] != '*') {
+            return false;
+        }
+        char* fin = nullptr;
+        repeticiones = std::strtol(texto.c_str() + pos + 1, &fin, 10);
+        if (fin == texto.c_str() + pos + 1 || *fin != '\0' || repeticiones < 1 ||
+            repeticiones > MapaOcupacion::MAX_NIVELES) {
+            return false;
+        }
+    }
+    
+    TipoPolitica politica;
+    if (nombre == "RR" && quantum > 0) politica = TipoPolitica::ROUND_ROBIN;
+    else if (nombre == "SJF" && quantum < 0) politica = TipoPolitica::SJF;
+    else if (nombre == "STCF" && quantum < 0) politica = TipoPolitica::STCF;
+    else return false;
+    
+    esquemas.insert(esquemas.end(), (std::size_t)repeticiones, EsquemaCola(politica, quantum));
+    return true;
+}
+
+/*
+  Carga un esquema de N niveles desde un archivo
+  
+  Cada linea puede tener uno o varios niveles separados por comas o
+  espacios; lo que sigue a un '#' se ignora. El primer nivel del archivo
+  es la cola de mayor prioridad. Un error (nivel mal escrito, archivo sin
+  niveles o con mas de MapaOcupacion::MAX_NIVELES) se reporta con su
+  numero de linea y el esquema queda vacio.
+ */
+std::vector<EsquemaCola> cargarEsquema(const std::string& rutaArchivo, bool mostrar) {
+    std::vector<EsquemaCola> esquemas;
+    std::ifstream archivo(rutaArchivo);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: No se pudo abrir el archivo de esquema " << rutaArchivo << std::endl;
+        return esquemas;
+    }
+    
+    std::string linea;
+    int numeroLinea = 0;
+    while (std::getline(archivo, linea)) {
+        numeroLinea++;
+        linea = linea.substr(0, linea.find('#'));
+        for (char& c : linea) {
+            if (c == ',') c = ' ';
+        }
+        
+        std::istringstream niveles(linea);
+        std::string nivel;
+        while (niveles >> nivel) {
+            if (!parsearNivel(nivel, esquemas)) {
+                std::cerr << "Error: Nivel no valido en " << rutaArchivo << ":" << numeroLinea
+                          << ": " << nivel << std::endl;
+                return std::vector<EsquemaCola>();
+            }
+        }
+        if (esquemas.size() > (std::size_t)MapaOcupacion::MAX_NIVELES) {
+            std::cerr << "Error: El esquema " << rutaArchivo << " tiene mas de "
+                      << MapaOcupacion::MAX_NIVELES << " niveles" << std::endl;
+            return std::vector<EsquemaCola>();
+        }
+    }
+    
+    if (esquemas.empty()) {
+        std::cerr << "Error: El archivo de esquema " << rutaArchivo << " no tiene niveles" << std::endl;
+    } else if (mostrar) {
+        std::cout << "Usando esquema de " << rutaArchivo << ": " << esquemas.size() << " niveles" << std::endl;
+    }
+    return esquemas;
+}
+
+/*
+  Obtiene un esquema por numero o por archivo
+  
+  Si el texto es un numero se usa el esquema predefinido; si no, se lee
+  como ruta de un archivo de esquema.
+ */
+std::vector<EsquemaCola> obtenerEsquema(const std::string& esquema, bool mostrar) {
+    bool esNumero = !esquema.empty() && std::all_of(esquema.begin(), esquema.end(),
+                                                    [](char c) { return std::isdigit((unsigned char)c); });
+    if (esNumero) {
+        return obtenerEsquema(std::atoi(esquema.c_str()), mostrar);
+    }
+    return cargarEsquema(esquema, mostrar);
+}
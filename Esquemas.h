@@ -0,0 +1,25 @@
+#ifndef ESQUEMAS_H
+#define ESQUEMAS_H
+
+#include "MLFQScheduler.h"
+#include <string>
+#include <vector>
+
+// Retorna la configuracion de colas de uno de los esquemas predefinidos
+// (vacia si el numero no es valido)
+std::vector<EsquemaCola> obtenerEsquema(int numeroEsquema, bool mostrar = true);
+
+// Lee un esquema de N niveles de un archivo (vacio si hay algun error).
+// Formato: niveles RR(q), SJF o STCF separados por comas o lineas, en
+// orden de prioridad; "*n" repite un nivel n veces y '#' empieza un
+// comentario. Por ejemplo: "RR(1)*16, RR(2)*16, RR(4)*31, STCF".
+std::vector<EsquemaCola> cargarEsquema(const std::string& rutaArchivo, bool mostrar = true);
+
+// Un numero escoge un esquema predefinido; cualquier otra cosa se lee
+// como archivo de esquema
+std::vector<EsquemaCola> obtenerEsquema(const std::string& esquema, bool mostrar = true);
+
+// Describe un esquema en texto, por ejemplo "RR(1), RR(3), RR(4), SJF"
+std::string describirEsquema(const std::vector<EsquemaCola>& esquemas);
+
+#endif
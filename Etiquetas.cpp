@@ -0,0 +1,83 @@
+#include "Etiquetas.h"
+#include <algorithm>
+#include <numeric>
+
+// Ranuras iniciales de la tabla hash (siempre potencia de 2)
+static const std::size_t RANURAS_INICIALES = 1024;
+
+TablaEtiquetas::TablaEtiquetas(std::pmr::memory_resource* memoria)
+    : texto(memoria), inicios(memoria), hashes(memoria), ranuras(RANURAS_INICIALES, 0, memoria) {
+    inicios.push_back(0);
+}
+
+// FNV-1a de 32 bits
+std::uint32_t TablaEtiquetas::calcularHash(std::string_view etiqueta) {
+    std::uint32_t hash = 2166136261u;
+    for (char c : etiqueta) {
+        hash ^= (unsigned char)c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void TablaEtiquetas::crecer() {
+    ranuras.assign(ranuras.size() * 2, 0);
+    std::size_t mascara = ranuras.size() - 1;
+    for (std::uint32_t id = 0; id < hashes.size(); id++) {
+        std::size_t i = hashes[id] & mascara;
+        while (ranuras[i] != 0) {
+            i = (i + 1) & mascara;
+        }
+        ranuras[i] = id + 1;
+    }
+}
+
+/*
+  Interna una etiqueta
+  
+  Sondeo lineal desde la ranura del hash: cada ranura ocupada se compara
+  primero por hash y solo si coincide por texto. La tabla crece cuando
+  pasa de la mitad de ocupacion.
+ */
+IdEtiqueta TablaEtiquetas::internar(std::string_view etiqueta) {
+    std::uint32_t hash = calcularHash(etiqueta);
+    std::size_t mascara = ranuras.size() - 1;
+    std::size_t i = hash & mascara;
+    while (ranuras[i] != 0) {
+        IdEtiqueta id = ranuras[i] - 1;
+        if (hashes[id] == hash && getTexto(id) == etiqueta) {
+            return id;
+        }
+        i = (i + 1) & mascara;
+    }
+    
+    IdEtiqueta id = (IdEtiqueta)hashes.size();
+    texto.insert(texto.end(), etiqueta.begin(), etiqueta.end());
+    inicios.push_back(texto.size());
+    hashes.push_back(hash);
+    ranuras[i] = id + 1;
+    if (hashes.size() * 2 > ranuras.size()) {
+        crecer();
+    }
+    return id;
+}
+
+std::vector<std::uint32_t> TablaEtiquetas::calcularRangos() const {
+    std::vector<IdEtiqueta> orden(tamano());
+    std::iota(orden.begin(), orden.end(), 0);
+    std::sort(orden.begin(), orden.end(),
+              [this](IdEtiqueta a, IdEtiqueta b) { return getTexto(a) < getTexto(b); });
+    
+    std::vector<std::uint32_t> rangos(tamano());
+    for (std::uint32_t posicion = 0; posicion < orden.size(); posicion++) {
+        rangos[orden[posicion]] = posicion;
+    }
+    return rangos;
+}
+
+void TablaEtiquetas::limpiar() {
+    texto.clear();
+    inicios.assign(1, 0);
+    hashes.clear();
+    std::fill(ranuras.begin(), ranuras.end(), 0);
+}
@@ -0,0 +1,57 @@
+#ifndef ETIQUETAS_H
+#define ETIQUETAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+typedef std::uint32_t IdEtiqueta;
+
+/*
+  Clase TablaEtiquetas
+  
+  Guarda cada etiqueta distinta una sola vez y le da un id entero (en
+  orden de aparicion, desde 0). El texto va seguido en un solo arreglo
+  y la busqueda es una tabla hash de direccionamiento abierto que guarda
+  solo ids, asi internar una etiqueta repetida no pide memoria y una
+  nueva solo agrega sus bytes al final.
+  
+  calcularRangos() da la posicion alfabetica de cada id ordenando solo
+  las etiquetas distintas; con eso las filas se ordenan comparando
+  enteros en vez de textos.
+ */
+class TablaEtiquetas {
+private:
+    std::pmr::vector<char> texto;               // Todas las etiquetas seguidas
+    std::pmr::vector<std::uint64_t> inicios;    // Donde empieza cada id (y uno mas al final)
+    std::pmr::vector<std::uint32_t> hashes;     // Hash de cada id (para crecer sin recalcular)
+    std::pmr::vector<std::uint32_t> ranuras;    // id + 1 por ranura; 0 = libre
+    
+    static std::uint32_t calcularHash(std::string_view etiqueta);
+    
+    // Duplica la tabla hash y vuelve a ubicar todos los ids
+    void crecer();
+
+public:
+    explicit TablaEtiquetas(std::pmr::memory_resource* memoria = std::pmr::get_default_resource());
+    
+    // Id de la etiqueta; si es nueva, la agrega
+    IdEtiqueta internar(std::string_view etiqueta);
+    
+    std::string_view getTexto(IdEtiqueta id) const {
+        return std::string_view(texto.data() + inicios[id], (std::size_t)(inicios[id + 1] - inicios[id]));
+    }
+    
+    std::size_t tamano() const { return inicios.size() - 1; }
+    std::size_t getBytesTexto() const { return texto.size(); }
+    
+    // rangos[id] = posicion de la etiqueta en orden alfabetico
+    std::vector<std::uint32_t> calcularRangos() const;
+    
+    // Olvida todas las etiquetas (conserva la memoria)
+    void limpiar();
+};
+
+#endif
@@ -0,0 +1,227 @@
+#include "Explorador.h"
+#include "Esquemas.h"
+#include "PoolHilos.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+
+namespace {
+
+/*
+  Costo parcial de una simulacion en curso
+  
+  Acumula la metrica de cada proceso que termina y puede decir si el costo
+  final ya es seguro mayor que una cota. Todas las metricas son >= 0, asi
+  que para el promedio basta con suma / total; para un percentil se cuenta
+  cuantos procesos ya superan la cota: si son suficientes, el percentil
+  final tambien la supera.
+ */
+class CostoParcial {
+private:
+    MetricaExploracion metrica;
+    double percentil;
+    std::size_t total;                  // Procesos de la carga
+    std::size_t rango;                  // Posicion (1..total) del percentil
+    double suma;
+    std::vector<int> valores;           // Solo para percentiles
+    double cota;                        // Cota con la que se cuentan los mayores
+    std::size_t mayores;                // Valores > cota
+
+public:
+    CostoParcial(MetricaExploracion m, double p, std::size_t n)
+        : metrica(m), percentil(p), total(n), suma(0),
+          cota(std::numeric_limits<double>::infinity()), mayores(0) {
+        rango = (std::size_t)std::ceil(percentil * total);
+        rango = std::max<std::size_t>(1, std::min(rango, total));
+        if (percentil > 0) valores.reserve(total);
+    }
+    
+    // Agrega el valor de un proceso terminado
+    void agregar(const TablaProcesos& tabla, IdProceso id) {
+        int valor = metrica == MetricaExploracion::WT ? tabla.getTiempoEspera(id)
+                  : metrica == MetricaExploracion::RT ? tabla.getTiempoRespuesta(id)
+                  : tabla.getTiempoRetorno(id);
+        suma += valor;
+        if (percentil > 0) {
+            valores.push_back(valor);
+            if (valor > cota) mayores++;
+        }
+    }
+    
+    // true si el costo final ya es seguro mayor que 'mejor'
+    bool superaCota(double mejor) {
+        if (percentil <= 0) {
+            return suma / total > mejor;
+        }
+        
+        // La cota solo baja; al bajar se recuentan los mayores
+        if (mejor < cota) {
+            cota = mejor;
+            mayores = std::count_if(valores.begin(), valores.end(),
+                                    [this](int v) { return v > cota; });
+        }
+        return mayores >= total - rango + 1;
+    }
+    
+    // Cota inferior del costo con lo que se sabe hasta ahora
+    double cotaInferior() const {
+        return percentil <= 0 ? suma / total : cota;
+    }
+    
+    // Costo final (todos los procesos terminaron)
+    double costoFinal() {
+        if (percentil <= 0) return suma / total;
+        std::nth_element(valores.begin(), valores.begin() + (rango - 1), valores.end());
+        return valores[rango - 1];
+    }
+};
+
+// Agrega a 'salida' todas las secuencias no decrecientes de 'largo' quantums
+void generarQuantums(const std::vector<int>& quantums, std::size_t desde, int largo,
+                     std::vector<int>& actual, std::vector<std::vector<int>>& salida) {
+    if (largo == 0) {
+        salida.push_back(actual);
+        return;
+    }
+    for (std::size_t i = desde; i < quantums.size(); i++) {
+        actual.push_back(quantums[i]);
+        generarQuantums(quantums, i, largo - 1, actual, salida);
+        actual.pop_back();
+    }
+}
+
+// Actualiza el mejor costo global si 'costo' es menor
+void actualizarMejor(std::atomic<double>& mejor, double costo) {
+    double actual = mejor.load();
+    while (costo < actual && !mejor.compare_exchange_weak(actual, costo)) {
+    }
+}
+
+}
+
+/*
+  Genera los esquemas candidatos
+  
+  Para cada cantidad de niveles arma las colas RR superiores con quantums
+  no decrecientes y combina cada una con las politicas permitidas para la
+  ultima cola. Si el total pasa de maxCandidatos se baraja con la semilla
+  dada y se conserva una muestra de ese tamano.
+ */
+std::vector<std::vector<EsquemaCola>> generarCandidatos(const ConfiguracionExploracion& config) {
+    std::vector<std::vector<EsquemaCola>> candidatos;
+    std::vector<int> quantums = config.quantums;
+    std::sort(quantums.begin(), quantums.end());
+    quantums.erase(std::unique(quantums.begin(), quantums.end()), quantums.end());
+    
+    for (int niveles = std::max(1, config.nivelesMin); niveles <= config.nivelesMax; niveles++) {
+        std::vector<std::vector<int>> superiores;
+        std::vector<int> actual;
+        generarQuantums(quantums, 0, niveles - 1, actual, superiores);
+        
+        for (const std::vector<int>& qs : superiores) {
+            std::vector<EsquemaCola> base;
+            for (int q : qs) base.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, q));
+            
+            if (config.incluirSJF) {
+                candidatos.push_back(base);
+                candidatos.back().push_back(EsquemaCola(TipoPolitica::SJF));
+            }
+            if (config.incluirSTCF) {
+                candidatos.push_back(base);
+                candidatos.back().push_back(EsquemaCola(TipoPolitica::STCF));
+            }
+            if (config.incluirRR) {
+                int minimo = qs.empty() ? 0 : qs.back();
+                for (int q : quantums) {
+                    if (q < minimo) continue;
+                    candidatos.push_back(base);
+                    candidatos.back().push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, q));
+                }
+            }
+        }
+    }
+    
+    if (candidatos.size() > config.maxCandidatos) {
+        std::mt19937 generador(config.semilla);
+        std::shuffle(candidatos.begin(), candidatos.end(), generador);
+        candidatos.resize(config.maxCandidatos);
+    }
+    return candidatos;
+}
+
+/*
+  Explora los esquemas candidatos
+  
+  Cada candidato es un trabajo del pool con su propio scheduler sin salida por pantalla.
+  El observador de procesos terminados actualiza el costo parcial y detiene
+  la simulacion si ya no puede mejorar al mejor costo (que se comparte entre
+  hilos como atomico; leer un valor viejo solo hace que se pode menos).
+ */
+std::vector<ResultadoExploracion> explorarEsquemas(const std::vector<RegistroProceso>& procesos,
+                                                   const ConfiguracionExploracion& config) {
+    std::vector<std::vector<EsquemaCola>> candidatos = generarCandidatos(config);
+    std::vector<ResultadoExploracion> resultados(candidatos.size());
+    if (procesos.empty()) {
+        return {};
+    }
+    
+    std::atomic<double> mejor(std::numeric_limits<double>::infinity());
+    {
+        PoolHilos pool(config.hilos);
+        for (std::size_t i = 0; i < candidatos.size(); i++) {
+            pool.encolar([&, i] {
+                ResultadoExploracion& resultado = resultados[i];
+                resultado.esquema = candidatos[i];
+                
+                MLFQScheduler scheduler(candidatos[i]);
+                CostoParcial costo(config.metrica, config.percentil, procesos.size());
+                scheduler.setVerbosidad(Verbosidad::NINGUNA);
+                scheduler.setAlFinalizar([&](IdProceso id) {
+                    costo.agregar(scheduler.getTabla(), id);
+                    return !costo.superaCota(mejor.load(std::memory_order_relaxed));
+                });
+                scheduler.agregarProcesos(procesos);
+                scheduler.ejecutarSimulacion();
+                
+                resultado.podado = scheduler.fueDetenida();
+                if (resultado.podado) {
+                    resultado.costo = costo.cotaInferior();
+                } else {
+                    resultado.costo = costo.costoFinal();
+                    actualizarMejor(mejor, resultado.costo);
+                }
+            });
+        }
+    }
+    
+    std::stable_sort(resultados.begin(), resultados.end(),
+                     [](const ResultadoExploracion& a, const ResultadoExploracion& b) {
+                         if (a.podado != b.podado) return !a.podado;
+                         if (a.costo != b.costo) return a.costo < b.costo;
+                         return a.esquema.size() < b.esquema.size();
+                     });
+    return resultados;
+}
+
+/*
+  Escribe la tabla de resultados
+  
+  Una fila por candidato con su posicion, cantidad de niveles, esquema y
+  costo. Los podados se marcan con '>' antes del costo porque solo se
+  conoce una cota inferior.
+ */
+void escribirRanking(std::ostream& salida, const std::vector<ResultadoExploracion>& resultados,
+                     std::size_t limite) {
+    std::size_t cantidad = limite == 0 ? resultados.size() : std::min(limite, resultados.size());
+    
+    salida << "# posicion; niveles; esquema; costo\n";
+    salida << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < cantidad; i++) {
+        const ResultadoExploracion& r = resultados[i];
+        salida << (i + 1) << ";" << r.esquema.size() << ";" << describirEsquema(r.esquema) << ";"
+               << (r.podado ? ">" : "") << r.costo << "\n";
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef EXPLORADOR_H
+#define EXPLORADOR_H
+
+#include "MLFQScheduler.h"
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Metrica por proceso que se quiere minimizar
+enum class MetricaExploracion {
+    WT,     // Tiempo de espera
+    RT,     // Tiempo de respuesta
+    TAT     // Tiempo de retorno
+};
+
+/*
+  Parametros del explorador de esquemas
+  
+  El espacio de busqueda son esquemas de nivelesMin a nivelesMax colas:
+  todas las colas menos la ultima son Round Robin con quantums tomados de
+  'quantums' en orden no decreciente, y la ultima es SJF, STCF o un RR con
+  quantum al menos igual al de la cola anterior.
+ */
+struct ConfiguracionExploracion {
+    MetricaExploracion metrica = MetricaExploracion::TAT;
+    double percentil = 0.0;             // 0 = promedio; 0.95, 0.99...; 1 = maximo
+    int nivelesMin = 2;
+    int nivelesMax = 4;
+    std::vector<int> quantums = {1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20};
+    bool incluirSJF = true;             // Politicas permitidas en la ultima cola
+    bool incluirSTCF = true;
+    bool incluirRR = true;
+    std::size_t maxCandidatos = 5000;   // Si hay mas, se toma una muestra al azar
+    unsigned semilla = 1;               // Semilla del muestreo
+    std::size_t hilos = 0;              // 0 = un hilo por nucleo
+};
+
+// Resultado de evaluar un esquema candidato
+struct ResultadoExploracion {
+    std::vector<EsquemaCola> esquema;
+    double costo;       // Costo final, o cota inferior si el candidato se podo
+    bool podado;        // true si se detuvo antes de terminar
+};
+
+// Genera los esquemas candidatos (todos, o una muestra si son demasiados)
+std::vector<std::vector<EsquemaCola>> generarCandidatos(const ConfiguracionExploracion& config);
+
+/*
+  Explora el espacio de esquemas para una carga de trabajo
+  
+  Simula cada candidato en un pool de hilos. Mientras simula, cada
+  candidato lleva una cota inferior de su costo y se detiene en cuanto esa
+  cota supera al mejor costo encontrado hasta el momento. Retorna los
+  resultados ordenados: primero los completos por costo y despues los
+  podados por su cota.
+ */
+std::vector<ResultadoExploracion> explorarEsquemas(const std::vector<RegistroProceso>& procesos,
+                                                   const ConfiguracionExploracion& config);
+
+// Escribe la tabla de resultados; limite = 0 escribe todos
+void escribirRanking(std::ostream& salida, const std::vector<ResultadoExploracion>& resultados,
+                     std::size_t limite = 0);
+
+#endif
@@ -0,0 +1,263 @@
+#include "GeneradorCargas.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+/*
+  Constructor
+  
+  Siembra el generador con la semilla de la configuracion y prepara la
+  distribucion de colas iniciales (si no hay pesos, todos van a la cola 1).
+ */
+GeneradorCargas::GeneradorCargas(const ConfiguracionCarga& configuracion)
+    : config(configuracion), aleatorio(configuracion.semilla), generados(0), tiempo(0.0) {
+    if (config.pesosCola.empty()) {
+        config.pesosCola.push_back(1.0);
+    }
+    distribucionCola = std::discrete_distribution<int>(config.pesosCola.begin(), config.pesosCola.end());
+    config.rafagaMin = std::max(1, config.rafagaMin);
+    config.rafagaMax = std::max(config.rafagaMin, config.rafagaMax);
+    config.rafagaMedia = std::clamp(config.rafagaMedia, config.rafagaMin, config.rafagaMax);
+    config.tamanoGrupo = std::max(1, config.tamanoGrupo);
+    config.prioridadMax = std::max(1, config.prioridadMax);
+    config.sigmaRafaga = std::max(0.0, config.sigmaRafaga);
+    config.alfaPareto = std::max(1.01, config.alfaPareto);
+    config.ciclosES = std::max(0, config.ciclosES);
+    config.mediaES = std::max(1, config.mediaES);
+}
+
+/*
+  Avanza el tiempo de llegada
+  
+  Se llama antes de cada proceso menos el primero, que siempre llega en 0.
+  Las llegadas se llevan en double y se redondean hacia abajo al generar,
+  asi que nunca decrecen.
+ */
+void GeneradorCargas::avanzarLlegada() {
+    double tasa = config.tasaLlegada > 0 ? config.tasaLlegada : 1.0;
+    
+    switch (config.llegadas) {
+        case ProcesoLlegadas::SIMULTANEAS:
+            break;
+        case ProcesoLlegadas::UNIFORMES:
+            tiempo = generados / tasa;
+            break;
+        case ProcesoLlegadas::POISSON:
+            tiempo += std::exponential_distribution<double>(tasa)(aleatorio);
+            break;
+        case ProcesoLlegadas::RAFAGAS:
+            // Un grupo nuevo cada tamanoGrupo procesos; la tasa promedio se mantiene
+            if (generados % config.tamanoGrupo == 0) {
+                tiempo += std::exponential_distribution<double>(tasa / config.tamanoGrupo)(aleatorio);
+            }
+            break;
+    }
+}
+
+int GeneradorCargas::sortearRafaga() {
+    switch (config.rafagas) {
+        case DistribucionRafagas::CONSTANTE:
+            return config.rafagaMedia;
+        case DistribucionRafagas::UNIFORME:
+            return std::uniform_int_distribution<int>(config.rafagaMin, config.rafagaMax)(aleatorio);
+        case DistribucionRafagas::EXPONENCIAL: {
+            double valor = std::exponential_distribution<double>(1.0 / config.rafagaMedia)(aleatorio);
+            return std::clamp((int)std::ceil(valor), config.rafagaMin, config.rafagaMax);
+        }
+        case DistribucionRafagas::BIMODAL:
+            if (std::bernoulli_distribution(config.fraccionCortos)(aleatorio)) {
+                return std::uniform_int_distribution<int>(config.rafagaMin, config.rafagaMedia)(aleatorio);
+            }
+            return std::uniform_int_distribution<int>(config.rafagaMedia, config.rafagaMax)(aleatorio);
+        case DistribucionRafagas::LOGNORMAL: {
+            // mu tal que la media de la lognormal sea rafagaMedia
+            double sigma = config.sigmaRafaga;
+            double mu = std::log((double)config.rafagaMedia) - sigma * sigma / 2;
+            double valor = std::lognormal_distribution<double>(mu, sigma)(aleatorio);
+            return (int)std::clamp(std::ceil(valor), (double)config.rafagaMin, (double)config.rafagaMax);
+        }
+        case DistribucionRafagas::PARETO: {
+            // Escala tal que la media alfa*xm/(alfa-1) sea rafagaMedia
+            double alfa = config.alfaPareto;
+            double escala = config.rafagaMedia * (alfa - 1) / alfa;
+            double u = 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(aleatorio);
+            double valor = escala * std::pow(u, -1.0 / alfa);
+            return (int)std::clamp(std::ceil(valor), (double)config.rafagaMin, (double)config.rafagaMax);
+        }
+    }
+    return config.rafagaMedia;
+}
+
+bool GeneradorCargas::siguiente(RegistroProceso& registro) {
+    if (generados >= config.cantidad) {
+        return false;
+    }
+    if (generados > 0) {
+        avanzarLlegada();
+    }
+    generados++;
+    
+    etiqueta = "P" + std::to_string(generados);
+    registro.etiqueta = etiqueta;
+    registro.tiempoRafaga = sortearRafaga();
+    registro.tiempoLlegada = (int)tiempo;
+    registro.cola = distribucionCola(aleatorio) + 1;
+    registro.prioridad = std::uniform_int_distribution<int>(1, config.prioridadMax)(aleatorio);
+    
+    // Los ciclos de E/S se sortean al final, asi una carga sin E/S sale
+    // igual que antes para la misma semilla
+    rafagasES.clear();
+    for (int ciclo = 0; ciclo < config.ciclosES; ciclo++) {
+        double es = std::exponential_distribution<double>(1.0 / config.mediaES)(aleatorio);
+        if (ciclo > 0) rafagasES += ',';
+        rafagasES += std::to_string(std::max(1, (int)std::ceil(es)));
+        rafagasES += ',';
+        rafagasES += std::to_string(sortearRafaga());
+    }
+    registro.rafagas = rafagasES;
+    return true;
+}
+
+// Convierte "1,2,0.5" en {1, 2, 0.5}
+static std::vector<double> leerPesos(const std::string& texto) {
+    std::vector<double> pesos;
+    std::stringstream ss(texto);
+    std::string parte;
+    while (std::getline(ss, parte, ',')) {
+        pesos.push_back(std::atof(parte.c_str()));
+    }
+    return pesos;
+}
+
+bool leerOpcionCarga(const std::string& opcion, const std::string& valor, ConfiguracionCarga& config) {
+    if (opcion == "--llegadas") {
+        if (valor == "simultaneas") config.llegadas = ProcesoLlegadas::SIMULTANEAS;
+        else if (valor == "uniformes") config.llegadas = ProcesoLlegadas::UNIFORMES;
+        else if (valor == "poisson") config.llegadas = ProcesoLlegadas::POISSON;
+        else if (valor == "rafagas") config.llegadas = ProcesoLlegadas::RAFAGAS;
+        else return false;
+    }
+    else if (opcion == "--rafaga") {
+        if (valor == "constante") config.rafagas = DistribucionRafagas::CONSTANTE;
+        else if (valor == "uniforme") config.rafagas = DistribucionRafagas::UNIFORME;
+        else if (valor == "exponencial") config.rafagas = DistribucionRafagas::EXPONENCIAL;
+        else if (valor == "bimodal") config.rafagas = DistribucionRafagas::BIMODAL;
+        else if (valor == "lognormal") config.rafagas = DistribucionRafagas::LOGNORMAL;
+        else if (valor == "pareto") config.rafagas = DistribucionRafagas::PARETO;
+        else return false;
+    }
+    else if (opcion == "--tasa") config.tasaLlegada = std::atof(valor.c_str());
+    else if (opcion == "--grupo") config.tamanoGrupo = std::atoi(valor.c_str());
+    else if (opcion == "--min") config.rafagaMin = std::atoi(valor.c_str());
+    else if (opcion == "--max") config.rafagaMax = std::atoi(valor.c_str());
+    else if (opcion == "--media") config.rafagaMedia = std::atoi(valor.c_str());
+    else if (opcion == "--cortos") config.fraccionCortos = std::atof(valor.c_str());
+    else if (opcion == "--sigma") config.sigmaRafaga = std::atof(valor.c_str());
+    else if (opcion == "--alfa") config.alfaPareto = std::atof(valor.c_str());
+    else if (opcion == "--colas") config.pesosCola = leerPesos(valor);
+    else if (opcion == "--prioridad") config.prioridadMax = std::atoi(valor.c_str());
+    else if (opcion == "--ciclos") config.ciclosES = std::atoi(valor.c_str());
+    else if (opcion == "--es") config.mediaES = std::atoi(valor.c_str());
+    else if (opcion == "--semilla") config.semilla = std::strtoull(valor.c_str(), nullptr, 10);
+    else return false;
+    return true;
+}
+
+/*
+  Semilla de una replica
+  
+  Mezcla la semilla base con el indice de la replica usando el paso de
+  splitmix64 (una suma de la constante de oro y dos multiplicaciones con
+  corrimientos). Semillas consecutivas de mt19937_64 dan flujos muy
+  parecidos al principio; despues de mezclarlas no queda relacion
+  visible entre replicas, y la misma (semilla, replica) da siempre lo mismo.
+ */
+std::uint64_t semillaReplica(std::uint64_t semilla, std::uint64_t replica) {
+    std::uint64_t z = semilla + (replica + 1) * 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/*
+  Escribe la carga en el formato de entrada
+  
+  Las lineas se arman con std::to_chars en un buffer que se vacia cada
+  cierto tamano, para poder generar millones de procesos rapido.
+ */
+void escribirCarga(std::ostream& salida, const ConfiguracionCarga& config) {
+    GeneradorCargas generador(config);
+    RegistroProceso registro;
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    
+    salida << "# etiqueta; burst time (BT); arrival time (AT); Queue (Q); Priority (5 > 1)\n";
+    
+    char numero[16];
+    auto agregarNumero = [&](int valor) {
+        std::to_chars_result resultado = std::to_chars(numero, numero + sizeof(numero), valor);
+        buffer.append(numero, resultado.ptr - numero);
+    };
+    
+    while (generador.siguiente(registro)) {
+        buffer.append(registro.etiqueta);
+        buffer += ';';
+        agregarNumero(registro.tiempoRafaga);
+        buffer += ';';
+        agregarNumero(registro.tiempoLlegada);
+        buffer += ';';
+        agregarNumero(registro.cola);
+        buffer += ';';
+        agregarNumero(registro.prioridad);
+        if (!registro.rafagas.empty()) {
+            buffer += ';';
+            buffer.append(registro.rafagas);
+        }
+        buffer += '\n';
+        
+        if (buffer.size() >= (1 << 20) - 64) {
+            salida.write(buffer.data(), (std::streamsize)buffer.size());
+            buffer.clear();
+        }
+    }
+    salida.write(buffer.data(), (std::streamsize)buffer.size());
+}
+
+/*
+  Genera la carga completa en memoria
+  
+  Primero se generan todos los registros guardando el texto de las
+  etiquetas (y de sus rafagas de E/S, a continuacion) en un solo string;
+  las vistas se asignan al final, cuando ese string ya no va a crecer (y
+  por lo tanto no se va a mover).
+ */
+void generarCarga(const ConfiguracionCarga& config, std::string& etiquetas,
+                  std::vector<RegistroProceso>& registros) {
+    GeneradorCargas generador(config);
+    RegistroProceso registro;
+    std::vector<std::size_t> finEtiqueta;
+    std::vector<std::size_t> finRafagas;
+    
+    etiquetas.clear();
+    registros.clear();
+    registros.reserve(config.cantidad);
+    finEtiqueta.reserve(config.cantidad);
+    finRafagas.reserve(config.cantidad);
+    
+    while (generador.siguiente(registro)) {
+        etiquetas.append(registro.etiqueta);
+        finEtiqueta.push_back(etiquetas.size());
+        etiquetas.append(registro.rafagas);
+        finRafagas.push_back(etiquetas.size());
+        registros.push_back(registro);
+    }
+    
+    std::size_t inicio = 0;
+    for (std::size_t i = 0; i < registros.size(); i++) {
+        registros[i].etiqueta = std::string_view(etiquetas.data() + inicio, finEtiqueta[i] - inicio);
+        registros[i].rafagas = std::string_view(etiquetas.data() + finEtiqueta[i], finRafagas[i] - finEtiqueta[i]);
+        inicio = finRafagas[i];
+    }
+}
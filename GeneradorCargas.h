@@ -0,0 +1,107 @@
+#ifndef GENERADORCARGAS_H
+#define GENERADORCARGAS_H
+
+#include "TablaProcesos.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Como llegan los procesos al sistema
+enum class ProcesoLlegadas {
+    SIMULTANEAS,    // Todos en el tiempo 0
+    UNIFORMES,      // Uno cada 1/tasa unidades
+    POISSON,        // Separaciones exponenciales con media 1/tasa
+    RAFAGAS         // Grupos de tamanoGrupo que llegan juntos (grupos Poisson)
+};
+
+// De donde sale el burst time de cada proceso
+enum class DistribucionRafagas {
+    CONSTANTE,      // Siempre rafagaMedia
+    UNIFORME,       // Entre rafagaMin y rafagaMax
+    EXPONENCIAL,    // Media rafagaMedia, recortada a [rafagaMin, rafagaMax]
+    BIMODAL,        // fraccionCortos en [rafagaMin, rafagaMedia], el resto en [rafagaMedia, rafagaMax]
+    LOGNORMAL,      // Media rafagaMedia y desviacion sigmaRafaga del logaritmo, recortada
+    PARETO          // Cola pesada con forma alfaPareto y media rafagaMedia, recortada
+};
+
+/*
+  Parametros de una carga sintetica
+  
+  pesosCola da la mezcla de colas iniciales: el proceso entra a la cola
+  i+1 con probabilidad proporcional a pesosCola[i]. Con ciclosES > 0 cada
+  proceso trae esa cantidad de pares E/S,CPU despues de su primera
+  rafaga: la E/S es exponencial con media mediaES y cada rafaga de CPU
+  sale de la misma distribucion que el BT.
+ */
+struct ConfiguracionCarga {
+    std::size_t cantidad = 1000;
+    ProcesoLlegadas llegadas = ProcesoLlegadas::POISSON;
+    double tasaLlegada = 0.2;           // Procesos por unidad de tiempo
+    int tamanoGrupo = 10;               // Solo para RAFAGAS
+    DistribucionRafagas rafagas = DistribucionRafagas::EXPONENCIAL;
+    int rafagaMin = 1;
+    int rafagaMax = 100;
+    int rafagaMedia = 10;
+    double fraccionCortos = 0.8;        // Solo para BIMODAL
+    double sigmaRafaga = 1.0;           // Solo para LOGNORMAL
+    double alfaPareto = 1.5;            // Solo para PARETO (mayor que 1 para tener media)
+    std::vector<double> pesosCola = {1, 1, 1, 1};
+    int prioridadMax = 5;               // Prioridad uniforme en [1, prioridadMax]
+    int ciclosES = 0;                   // Pares E/S,CPU por proceso (0 = sin E/S)
+    int mediaES = 20;                   // Duracion media de cada E/S
+    std::uint64_t semilla = 1;
+};
+
+/*
+  Clase GeneradorCargas
+  
+  Genera procesos uno por uno, en orden de llegada, segun una
+  ConfiguracionCarga. Con la misma semilla siempre genera la misma carga.
+  Las etiquetas son P1, P2, ... y la del ultimo registro generado (y el
+  texto de sus rafagas de E/S) vive en el generador, valida hasta la
+  siguiente llamada.
+ */
+class GeneradorCargas {
+private:
+    ConfiguracionCarga config;
+    std::mt19937_64 aleatorio;
+    std::discrete_distribution<int> distribucionCola;
+    std::size_t generados;          // Procesos generados hasta ahora
+    double tiempo;                  // Tiempo de llegada actual (sin redondear)
+    std::string etiqueta;           // Texto de la ultima etiqueta
+    std::string rafagasES;          // Texto de las rafagas de E/S del ultimo proceso
+    
+    // Avanza el tiempo de llegada para el siguiente proceso
+    void avanzarLlegada();
+    
+    // Sortea el burst time de un proceso
+    int sortearRafaga();
+
+public:
+    explicit GeneradorCargas(const ConfiguracionCarga& configuracion);
+    
+    // Genera el siguiente proceso; retorna false cuando ya se generaron todos
+    bool siguiente(RegistroProceso& registro);
+};
+
+// Aplica una opcion de linea de comandos ("--tasa", "0.2") a la
+// configuracion; retorna false si la opcion o su valor no son validos.
+// La comparten el generador y el modo de replicas del simulador.
+bool leerOpcionCarga(const std::string& opcion, const std::string& valor, ConfiguracionCarga& config);
+
+// Semilla de la replica i a partir de una semilla base (splitmix64):
+// replicas vecinas quedan con flujos aleatorios independientes entre si
+std::uint64_t semillaReplica(std::uint64_t semilla, std::uint64_t replica);
+
+// Escribe la carga completa en el formato de entrada (etiqueta;BT;AT;Q;Pr[;E/S,CPU,...])
+void escribirCarga(std::ostream& salida, const ConfiguracionCarga& config);
+
+// Genera la carga completa en memoria. Las etiquetas de los registros
+// apuntan a 'etiquetas', que debe vivir mientras se usen.
+void generarCarga(const ConfiguracionCarga& config, std::string& etiquetas,
+                  std::vector<RegistroProceso>& registros);
+
+#endif
@@ -0,0 +1,252 @@
+#include "LectorTrazas.h"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+// Trozo minimo por hilo: con archivos chicos no vale la pena crear hilos
+const std::size_t TAMANO_MINIMO_TROZO = 1 << 20;
+
+bool esEspacio(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+/*
+  Convierte un campo a entero como lo hacia std::stoi: ignora espacios al
+  inicio, acepta signo y deja de leer en el primer caracter que no sea
+  digito. Retorna false si no hay ningun numero o si se sale del rango.
+ */
+bool parsearEntero(const char* inicio, const char* fin, int& valor) {
+    while (inicio < fin && esEspacio(*inicio)) inicio++;
+    if (inicio < fin && *inicio == '+') inicio++;
+    
+    std::from_chars_result resultado = std::from_chars(inicio, fin, valor);
+    return resultado.ec == std::errc();
+}
+
+}
+
+ArchivoTrazas::ArchivoTrazas() : datos(nullptr), tamano(0), mapeado(false) {
+}
+
+ArchivoTrazas::~ArchivoTrazas() {
+    cerrar();
+}
+
+void ArchivoTrazas::cerrar() {
+#ifndef _WIN32
+    if (mapeado) {
+        munmap(const_cast<char*>(datos), tamano);
+    }
+#endif
+    datos = nullptr;
+    tamano = 0;
+    mapeado = false;
+    buffer.clear();
+    registros.clear();
+    lineasInvalidas.clear();
+}
+
+/*
+  Parsea una linea de la entrada
+  
+  La linea se separa por ';' en etiqueta, BT, AT, Q y Pr, y un sexto
+  campo opcional con las rafagas de E/S (el resto de la linea). Los
+  comentarios, las lineas vacias y las que tienen menos campos se
+  ignoran, como en la lectura con getline.
+ */
+ResultadoLinea parsearLinea(const char* linea, const char* finLinea, RegistroProceso& registro) {
+    // Saltar comentarios y lineas vacias
+    if (linea == finLinea || *linea == '#') {
+        return ResultadoLinea::IGNORADA;
+    }
+    
+    // Separar los cinco campos obligatorios y el de rafagas
+    const char* campos[6];
+    campos[0] = linea;
+    int cantidad = 1;
+    for (const char* c = linea; c < finLinea && cantidad < 6; c++) {
+        if (*c == ';') campos[cantidad++] = c + 1;
+    }
+    if (cantidad < 5 || campos[4] == finLinea) {
+        return ResultadoLinea::IGNORADA;
+    }
+    const char* finPrioridad = cantidad == 6 ? campos[5] - 1 : finLinea;
+    
+    registro.etiqueta = std::string_view(linea, campos[1] - 1 - linea);
+    registro.rafagas = cantidad == 6 ? std::string_view(campos[5], finLinea - campos[5]) : std::string_view();
+    
+    if (parsearEntero(campos[1], campos[2] - 1, registro.tiempoRafaga) &&
+        parsearEntero(campos[2], campos[3] - 1, registro.tiempoLlegada) &&
+        parsearEntero(campos[3], campos[4] - 1, registro.cola) &&
+        parsearEntero(campos[4], finPrioridad, registro.prioridad) &&
+        contarRafagas(registro.rafagas) >= 0) {
+        return ResultadoLinea::VALIDA;
+    }
+    return ResultadoLinea::INVALIDA;
+}
+
+/*
+  Parsea un trozo de lineas completas
+  
+  Las lineas validas se agregan a la salida y las que tienen un numero
+  invalido se guardan aparte para reportarlas.
+ */
+void ArchivoTrazas::parsearTrozo(const char* inicio, const char* fin,
+                                 std::vector<RegistroProceso>& salida,
+                                 std::vector<std::string_view>& invalidas) {
+    const char* p = inicio;
+    RegistroProceso registro;
+    
+    while (p < fin) {
+        const char* finLinea = static_cast<const char*>(std::memchr(p, '\n', fin - p));
+        if (!finLinea) finLinea = fin;
+        const char* linea = p;
+        p = finLinea + 1;
+        
+        switch (parsearLinea(linea, finLinea, registro)) {
+            case ResultadoLinea::VALIDA:
+                salida.push_back(registro);
+                break;
+            case ResultadoLinea::INVALIDA:
+                invalidas.push_back(std::string_view(linea, finLinea - linea));
+                break;
+            case ResultadoLinea::IGNORADA:
+                break;
+        }
+    }
+}
+
+/*
+  Carga el archivo de procesos
+  
+  Mapea el archivo en memoria, lo parte en trozos de lineas completas
+  (uno por hilo) y los parsea en paralelo. Los registros de cada trozo se
+  juntan despues en el orden del archivo; solo se copian los registros,
+  las etiquetas siguen apuntando al mapeo.
+ */
+bool ArchivoTrazas::cargar(const std::string& rutaArchivo, unsigned hilos) {
+    cerrar();
+    
+#ifndef _WIN32
+    int fd = open(rutaArchivo.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    tamano = (std::size_t)info.st_size;
+    if (tamano > 0) {
+        void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            madvise(mapa, tamano, MADV_SEQUENTIAL);
+            datos = static_cast<const char*>(mapa);
+            mapeado = true;
+        }
+    }
+    close(fd);
+#endif
+    
+    // Sin mmap (Windows o si fallo el mapeo) se lee el archivo completo a memoria
+    if (!mapeado) {
+        std::ifstream archivo(rutaArchivo, std::ios::binary);
+        if (!archivo.is_open()) {
+            return false;
+        }
+        std::ostringstream contenido;
+        contenido << archivo.rdbuf();
+        buffer = contenido.str();
+        datos = buffer.data();
+        tamano = buffer.size();
+    }
+    
+    // Decidir cuantos trozos usar
+    if (hilos == 0) {
+        hilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t maxTrozos = std::max<std::size_t>(1, tamano / TAMANO_MINIMO_TROZO);
+    std::size_t cantidadTrozos = std::min<std::size_t>(hilos, maxTrozos);
+    
+    // Cortar en limites de linea
+    std::vector<const char*> cortes;
+    cortes.push_back(datos);
+    for (std::size_t i = 1; i < cantidadTrozos; i++) {
+        const char* corte = datos + i * (tamano / cantidadTrozos);
+        if (corte < cortes.back()) corte = cortes.back();
+        const char* salto = static_cast<const char*>(std::memchr(corte, '\n', datos + tamano - corte));
+        cortes.push_back(salto ? salto + 1 : datos + tamano);
+    }
+    cortes.push_back(datos + tamano);
+    
+    // Parsear cada trozo (el primero en este mismo hilo)
+    std::vector<std::vector<RegistroProceso>> partes(cantidadTrozos);
+    std::vector<std::vector<std::string_view>> invalidas(cantidadTrozos);
+    std::vector<std::thread> trabajadores;
+    for (std::size_t i = 1; i < cantidadTrozos; i++) {
+        trabajadores.emplace_back(parsearTrozo, cortes[i], cortes[i + 1],
+                                  std::ref(partes[i]), std::ref(invalidas[i]));
+    }
+    parsearTrozo(cortes[0], cortes[1], partes[0], invalidas[0]);
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+    
+    // Juntar en orden
+    std::size_t total = 0;
+    for (const auto& parte : partes) total += parte.size();
+    registros.reserve(total);
+    for (std::size_t i = 0; i < cantidadTrozos; i++) {
+        registros.insert(registros.end(), partes[i].begin(), partes[i].end());
+        lineasInvalidas.insert(lineasInvalidas.end(), invalidas[i].begin(), invalidas[i].end());
+    }
+    
+    return true;
+}
+
+bool ArchivoTrazas::tieneRafagasES() const {
+    for (const RegistroProceso& registro : registros) {
+        if (!registro.rafagas.empty()) return true;
+    }
+    return false;
+}
+
+/*
+  Lector de procesos linea por linea
+  
+  Lee de un flujo (normalmente la entrada estandar) sin cargarlo completo.
+  La linea se reutiliza entre llamadas, asi que la etiqueta del registro
+  solo es valida hasta la siguiente llamada a siguiente().
+ */
+LectorFlujo::LectorFlujo(std::istream& flujo) : entrada(flujo), lineasInvalidas(0) {
+}
+
+bool LectorFlujo::siguiente(RegistroProceso& registro) {
+    while (std::getline(entrada, linea)) {
+        ResultadoLinea resultado = parsearLinea(linea.data(), linea.data() + linea.size(), registro);
+        if (resultado == ResultadoLinea::VALIDA) {
+            return true;
+        }
+        if (resultado == ResultadoLinea::INVALIDA) {
+            std::cerr << "Error al parsear linea: " << linea << std::endl;
+            lineasInvalidas++;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,96 @@
+#ifndef LECTORTRAZAS_H
+#define LECTORTRAZAS_H
+
+#include "TablaProcesos.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <istream>
+
+// Resultado de parsear una linea de la entrada
+enum class ResultadoLinea {
+    VALIDA,         // Proceso leido
+    IGNORADA,       // Comentario, linea vacia o con menos de cinco campos
+    INVALIDA        // Algun numero mal formado
+};
+
+// Parsea la linea [linea, finLinea) (sin el salto de linea). La etiqueta
+// y las rafagas del registro quedan apuntando al texto de la linea.
+ResultadoLinea parsearLinea(const char* linea, const char* finLinea, RegistroProceso& registro);
+
+/*
+  Clase ArchivoTrazas
+  
+  Cargador rapido para archivos de procesos en formato etiqueta;BT;AT;Q;Pr.
+  
+  El archivo se mapea a memoria (sin copiarlo) y se divide en trozos que
+  terminan en un salto de linea. Cada trozo se parsea en su propio hilo
+  con std::from_chars y al final se juntan los resultados en orden. Las
+  etiquetas de los registros son vistas al archivo mapeado, asi que ningun
+  texto se copia: el ArchivoTrazas tiene que seguir vivo mientras se usen
+  los registros (o el scheduler al que se agregaron).
+  
+  Igual que la lectura linea por linea, salta lineas vacias y comentarios
+  que empiezan con '#', y acepta espacios alrededor de los numeros.
+ */
+class ArchivoTrazas {
+private:
+    const char* datos;                            // Contenido del archivo
+    std::size_t tamano;                           // Bytes del archivo
+    bool mapeado;                                 // true si datos viene de mmap
+    std::string buffer;                           // Copia del archivo si no se pudo mapear
+    std::vector<RegistroProceso> registros;       // Procesos en orden del archivo
+    std::vector<std::string_view> lineasInvalidas;  // Lineas con numeros mal formados
+    
+    // Parsea las lineas de [inicio, fin) agregando a los vectores dados
+    static void parsearTrozo(const char* inicio, const char* fin,
+                             std::vector<RegistroProceso>& salida,
+                             std::vector<std::string_view>& invalidas);
+    
+    // Libera el mapeo o el buffer actual
+    void cerrar();
+
+public:
+    ArchivoTrazas();
+    ~ArchivoTrazas();
+    
+    ArchivoTrazas(const ArchivoTrazas&) = delete;
+    ArchivoTrazas& operator=(const ArchivoTrazas&) = delete;
+    
+    // Mapea y parsea el archivo; hilos = 0 usa todos los nucleos.
+    // Retorna false si el archivo no se pudo abrir.
+    bool cargar(const std::string& rutaArchivo, unsigned hilos = 0);
+    
+    const std::vector<RegistroProceso>& getRegistros() const { return registros; }
+    const std::vector<std::string_view>& getLineasInvalidas() const { return lineasInvalidas; }
+    
+    // true si algun proceso trae rafagas de E/S
+    bool tieneRafagasES() const;
+};
+
+/*
+  Clase LectorFlujo
+  
+  Lee procesos de un flujo de texto linea por linea, para entradas que no
+  se pueden mapear ni cargar completas (por ejemplo una tuberia). Usa el
+  mismo parseo que ArchivoTrazas; las lineas invalidas se reportan por
+  std::cerr y se saltan.
+ */
+class LectorFlujo {
+private:
+    std::istream& entrada;
+    std::string linea;                  // Ultima linea leida (la etiqueta apunta aqui)
+    std::size_t lineasInvalidas;
+
+public:
+    explicit LectorFlujo(std::istream& flujo);
+    
+    // Lee el siguiente proceso; retorna false al final del flujo. La
+    // etiqueta es valida hasta la siguiente llamada.
+    bool siguiente(RegistroProceso& registro);
+    
+    std::size_t getLineasInvalidas() const { return lineasInvalidas; }
+};
+
+#endif
@@ -0,0 +1,11 @@
+#include "MLFQEstatico.h"
+
+/*
+  Instancias de los esquemas predefinidos
+  
+  Se compilan una sola vez aqui; los demas archivos solo ven la
+  declaracion extern del encabezado.
+ */
+template class MLFQ<NivelRR<1>, NivelRR<3>, NivelRR<4>, NivelSJF>;
+template class MLFQ<NivelRR<2>, NivelRR<3>, NivelRR<4>, NivelSTCF>;
+template class MLFQ<NivelRR<3>, NivelRR<5>, NivelRR<6>, NivelRR<20>>;
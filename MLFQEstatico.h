@@ -0,0 +1,320 @@
+#ifndef MLFQESTATICO_H
+#define MLFQESTATICO_H
+
+#include "Arena.h"
+#include "TablaProcesos.h"
+#include "Metricas.h"
+#include "ArchivosSalida.h"
+#include "ColaLlegadas.h"
+#include "schedulers/PoliticaNivel.h"
+#include "schedulers/NivelRR.h"
+#include "schedulers/NivelSJF.h"
+#include "schedulers/NivelSTCF.h"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <tuple>
+#include <utility>
+
+/*
+  Clase MLFQ<Niveles...>
+  
+  El mismo MLFQ que MLFQScheduler, pero con la politica de cada nivel fija
+  en tiempo de compilacion: MLFQ<NivelRR<1>, NivelRR<3>, NivelRR<4>, NivelSJF>
+  es el esquema 1. Cada nivel guarda su propia estructura de cola (FIFO o
+  por restante) en una tupla, y el despacho se expande nivel por nivel al
+  compilar, asi que no hay switch por politica ni objetos temporales por
+  rebanada: cada rebanada es un calculo en linea sobre la tabla.
+  
+  Da los mismos resultados que MLFQScheduler con el esquema equivalente.
+  Es la version para correr muchas simulaciones rapido, asi que no tiene
+  traza, observador, boost ni modo en linea; para eso esta MLFQScheduler.
+ */
+template <PoliticaNivel... Niveles>
+class MLFQ {
+    static_assert(sizeof...(Niveles) > 0, "El MLFQ necesita al menos un nivel");
+
+public:
+    static constexpr std::size_t NUM_NIVELES = sizeof...(Niveles);
+
+private:
+    template <std::size_t I>
+    using Nivel = std::tuple_element_t<I, std::tuple<Niveles...>>;
+    
+    typedef std::make_index_sequence<NUM_NIVELES> IndicesNiveles;
+    
+    Arena arena;                                       // Memoria de la simulacion
+    std::pmr::unsynchronized_pool_resource piscina;    // Para las colas, que crecen y se vacian
+    TablaProcesos tabla;                               // Estado de todos los procesos
+    std::tuple<typename Niveles::Cola...> colas;       // Una cola por nivel, del tipo de su politica
+    ColaLlegadas colaLlegadas;                         // Procesos que aun no llegan, por tiempo de llegada
+    std::pmr::vector<IdProceso> procesosFinalizados;   // Procesos terminados
+    AgregadorMetricas metricas;                        // Metricas acumuladas al terminar
+    int tiempoGlobal;                                  // Tiempo actual de simulacion
+    
+    // true si algun nivel tiene procesos listos
+    template <std::size_t... I>
+    bool hayListos(std::index_sequence<I...>) const {
+        return (!std::get<I>(colas).estaVacia() || ...);
+    }
+    
+    // Pone el proceso en el nivel dado (conocido solo en tiempo de ejecucion)
+    template <std::size_t... I>
+    void encolarEnNivel(int nivel, IdProceso id, std::index_sequence<I...>) {
+        ((nivel == (int)I ? (std::get<I>(colas).agregarProceso(id, tabla), true) : false) || ...);
+    }
+    
+    // Ejecuta una rebanada del primer nivel con procesos (false si no hay)
+    template <std::size_t... I>
+    bool despachar(std::index_sequence<I...>) {
+        return (intentarNivel<I>() || ...);
+    }
+    
+    template <std::size_t I>
+    bool intentarNivel();
+    
+    template <std::size_t I>
+    void ejecutarRebanada(IdProceso id);
+    
+    void moverProcesosLlegados();
+    
+    template <std::size_t I>
+    int limiteExpropiacion(IdProceso id) const;
+    
+    void finalizarProceso(IdProceso id);
+
+public:
+    MLFQ();
+    
+    MLFQ(const MLFQ&) = delete;
+    MLFQ& operator=(const MLFQ&) = delete;
+    
+    // Descarta todos los procesos reutilizando la memoria de la arena
+    void reiniciar();
+    
+    // Agrega procesos (de RegistroProceso o Proceso) antes de simular
+    template <typename Iterador>
+    void agregarProcesos(Iterador inicio, Iterador fin);
+    
+    template <typename Rango>
+    void agregarProcesos(const Rango& procesos) { agregarProcesos(std::begin(procesos), std::end(procesos)); }
+    
+    // Ejecuta toda la simulacion hasta que terminen todos los procesos
+    void ejecutarSimulacion();
+    
+    // Mismo archivo de salida y de metricas que MLFQScheduler
+    void escribirSalida(const std::string& rutaArchivo) const;
+    void escribirMetricas(const std::string& rutaArchivo) const;
+    
+    void calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const {
+        metricas.calcularPromedios(promWT, promCT, promRT, promTAT);
+    }
+    
+    int getTiempoGlobal() const { return tiempoGlobal; }
+    const TablaProcesos& getTabla() const { return tabla; }
+    const std::pmr::vector<IdProceso>& getProcesosFinalizados() const { return procesosFinalizados; }
+    const AgregadorMetricas& getMetricas() const { return metricas; }
+};
+
+template <PoliticaNivel... Niveles>
+MLFQ<Niveles...>::MLFQ()
+    : piscina(&arena), tabla(arena), colas(typename Niveles::Cola(&piscina)...), colaLlegadas(tabla, &piscina),
+      procesosFinalizados(&arena), tiempoGlobal(0) {
+}
+
+/*
+  Reinicia para otra corrida
+  
+  Igual que MLFQScheduler::reiniciar: primero se reemplazan los
+  contenedores y despues se vacian la piscina y la arena.
+ */
+template <PoliticaNivel... Niveles>
+void MLFQ<Niveles...>::reiniciar() {
+    colas = std::tuple<typename Niveles::Cola...>(typename Niveles::Cola(&piscina)...);
+    colaLlegadas = ColaLlegadas(tabla, &piscina);
+    procesosFinalizados = std::pmr::vector<IdProceso>(&arena);
+    tabla = TablaProcesos(arena);
+    
+    piscina.release();
+    arena.reiniciar();
+    
+    colas = std::tuple<typename Niveles::Cola...>(typename Niveles::Cola(&piscina)...);
+    metricas.reiniciar();
+    tiempoGlobal = 0;
+}
+
+template <PoliticaNivel... Niveles>
+template <typename Iterador>
+void MLFQ<Niveles...>::agregarProcesos(Iterador inicio, Iterador fin) {
+    colaLlegadas.agregarRango(inicio, fin, tabla, [this](const auto& proceso) { return tabla.agregar(proceso); });
+}
+
+/*
+  Mueve los procesos que ya llegaron a su nivel inicial
+  
+  Mismo criterio que MLFQScheduler: la cola del archivo (1-indexed), o el
+  ultimo nivel si el esquema tiene menos.
+ */
+template <PoliticaNivel... Niveles>
+void MLFQ<Niveles...>::moverProcesosLlegados() {
+    colaLlegadas.liberarHasta(tiempoGlobal, [this](IdProceso id) {
+        int nivel = std::max(0, std::min(tabla.getColaOriginal(id), (int)NUM_NIVELES) - 1);
+        tabla.setCola(id, nivel);
+        encolarEnNivel(nivel, id, IndicesNiveles());
+    });
+}
+
+/*
+  Hasta la primera llegada que desplazaria al proceso 'id' del nivel I
+  
+  Mismo criterio que MLFQScheduler::llegadaQueExpropia: la expropia una
+  llegada a un nivel de mayor prioridad o a este con menor tiempo
+  restante (Politica::desplaza); las demas se saltan y entran a su cola
+  en su instante, antes de ejecutar la rebanada. Como aqui no hay E/S ni
+  boosts, la rebanada siempre llega hasta ese punto y cada llegada se
+  revisa una sola vez.
+ */
+template <PoliticaNivel... Niveles>
+template <std::size_t I>
+int MLFQ<Niveles...>::limiteExpropiacion(IdProceso id) const {
+    typedef Nivel<I> Politica;
+    int restante = tabla.getTiempoRestante(id);
+    int llegadaPropia = tabla.getTiempoLlegada(id);
+    
+    for (IdProceso otro : colaLlegadas) {
+        int llegada = tabla.getTiempoLlegada(otro);
+        int unidades = llegada > tiempoGlobal ? llegada - tiempoGlobal : 1;
+        if (unidades >= restante) {
+            break;
+        }
+        
+        int nivel = std::max(0, std::min(tabla.getColaOriginal(otro), (int)NUM_NIVELES) - 1);
+        if (nivel < (int)I ||
+            (nivel == (int)I && Politica::desplaza(tabla.getTiempoRestante(otro), llegada,
+                                                   restante - unidades, llegadaPropia))) {
+            return unidades;
+        }
+    }
+    return INT_MAX;
+}
+
+template <PoliticaNivel... Niveles>
+void MLFQ<Niveles...>::finalizarProceso(IdProceso id) {
+    tabla.setTiempoFinalizacion(id, tiempoGlobal);
+    procesosFinalizados.push_back(id);
+    metricas.agregar(tabla, id);
+}
+
+template <PoliticaNivel... Niveles>
+template <std::size_t I>
+bool MLFQ<Niveles...>::intentarNivel() {
+    typename Nivel<I>::Cola& cola = std::get<I>(colas);
+    if (cola.estaVacia()) {
+        return false;
+    }
+    ejecutarRebanada<I>(cola.obtenerSiguienteProceso());
+    return true;
+}
+
+/*
+  Ejecuta una rebanada en el nivel I
+  
+  Todo lo que depende de la politica se resuelve al compilar: el limite
+  de expropiacion solo se calcula en niveles expropiativos, y el destino
+  de un proceso que no termino es el nivel siguiente (si la politica
+  degrada) o el mismo.
+ */
+template <PoliticaNivel... Niveles>
+template <std::size_t I>
+void MLFQ<Niveles...>::ejecutarRebanada(IdProceso id) {
+    typedef Nivel<I> Politica;
+    
+    if (!tabla.getHaIniciado(id)) {
+        tabla.setTiempoInicio(id, tiempoGlobal);
+    }
+    
+    int limite = 0;
+    if constexpr (Politica::expropiativa) {
+        limite = limiteExpropiacion<I>(id);
+    }
+    int unidades = Politica::rebanada(tabla.getTiempoRestante(id), limite);
+    
+    // Las llegadas saltadas cambian la cola como si se hubiera cortado en
+    // cada una (ver MLFQScheduler::repetirCortesSaltados)
+    if constexpr (Politica::expropiativa) {
+        int inicio = tiempoGlobal;
+        while (colaLlegadas.hayPendientes()) {
+            int corte = std::max(colaLlegadas.proxima(), inicio + 1);
+            if (corte - inicio >= unidades) break;
+            tiempoGlobal = corte;
+            std::get<I>(colas).repetirCorte();
+            moverProcesosLlegados();
+        }
+        tiempoGlobal = inicio;
+    }
+    
+    tabla.ejecutar(id, tiempoGlobal, unidades);
+    tiempoGlobal += unidades;
+    
+    if (tabla.estaCompleto(id)) {
+        finalizarProceso(id);
+    } else if constexpr (Politica::degrada) {
+        constexpr std::size_t siguiente = I + 1 < NUM_NIVELES ? I + 1 : I;
+        tabla.setCola(id, (int)siguiente);
+        std::get<siguiente>(colas).agregarProceso(id, tabla);
+    } else {
+        std::get<I>(colas).agregarProceso(id, tabla);
+    }
+}
+
+/*
+  Ejecuta toda la simulacion
+  
+  El mismo bucle por eventos de MLFQScheduler: mover llegadas, despachar
+  una rebanada del primer nivel con procesos y, si la CPU queda ociosa,
+  saltar a la siguiente llegada.
+ */
+template <PoliticaNivel... Niveles>
+void MLFQ<Niveles...>::ejecutarSimulacion() {
+    colaLlegadas.ordenar();
+    
+    while (colaLlegadas.hayPendientes() || hayListos(IndicesNiveles())) {
+        moverProcesosLlegados();
+        
+        if (!despachar(IndicesNiveles())) {
+            tiempoGlobal = colaLlegadas.proxima();
+        }
+    }
+}
+
+template <PoliticaNivel... Niveles>
+void MLFQ<Niveles...>::escribirSalida(const std::string& rutaArchivo) const {
+    escribirArchivoSalida(rutaArchivo, tabla, procesosFinalizados, metricas);
+}
+
+template <PoliticaNivel... Niveles>
+void MLFQ<Niveles...>::escribirMetricas(const std::string& rutaArchivo) const {
+    std::ofstream archivo(rutaArchivo);
+    if (!archivo.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << rutaArchivo << std::endl;
+        return;
+    }
+    metricas.escribirPercentiles(archivo);
+}
+
+// Los tres esquemas predefinidos (ver obtenerEsquema)
+typedef MLFQ<NivelRR<1>, NivelRR<3>, NivelRR<4>, NivelSJF> MLFQEsquema1;
+typedef MLFQ<NivelRR<2>, NivelRR<3>, NivelRR<4>, NivelSTCF> MLFQEsquema2;
+typedef MLFQ<NivelRR<3>, NivelRR<5>, NivelRR<6>, NivelRR<20>> MLFQEsquema3;
+
+// Ya instanciados en MLFQEstatico.cpp (no se recompilan en cada archivo)
+extern template class MLFQ<NivelRR<1>, NivelRR<3>, NivelRR<4>, NivelSJF>;
+extern template class MLFQ<NivelRR<2>, NivelRR<3>, NivelRR<4>, NivelSTCF>;
+extern template class MLFQ<NivelRR<3>, NivelRR<5>, NivelRR<6>, NivelRR<20>>;
+
+#endif
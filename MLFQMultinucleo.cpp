@@ -0,0 +1,318 @@
+#include "MLFQMultinucleo.h"
+#include "schedulers/NivelSJF.h"
+#include "schedulers/NivelSTCF.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+/*
+  Constructor
+  
+  Crea las colas de cada nucleo (una por esquema, como MLFQScheduler) y
+  marca todos los nucleos como ociosos.
+ */
+MLFQMultinucleo::MLFQMultinucleo(const std::vector<EsquemaCola>& esq, int cantidadNucleos,
+                                 std::unique_ptr<PoliticaBalanceo> politica)
+    : esquemas(esq), piscina(&arena), tabla(arena), ultimoNucleo(&arena), migraciones(&arena),
+      ociosos(cantidadNucleos), conListos(cantidadNucleos), fueTocado(cantidadNucleos, 0),
+      colaLlegadas(tabla, &piscina), procesosFinalizados(&arena),
+      balanceo(politica ? std::move(politica) : std::unique_ptr<PoliticaBalanceo>(new BalanceoDosOpciones())),
+      tiempoGlobal(0) {
+    nucleos.reserve(cantidadNucleos);
+    for (int c = 0; c < cantidadNucleos; c++) {
+        nucleos.emplace_back(&piscina, (int)esquemas.size());
+        std::pmr::vector<ColaNivel>& colas = nucleos.back().colas;
+        colas.reserve(esquemas.size());
+        for (const EsquemaCola& esquema : esquemas) {
+            colas.emplace_back(esquema.politica, &piscina);
+        }
+        ociosos.marcar(c);
+    }
+}
+
+void MLFQMultinucleo::hacerLugar(IdProceso id) {
+    if (ultimoNucleo.size() <= id) {
+        ultimoNucleo.resize(id + 1, -1);
+        migraciones.resize(id + 1, 0);
+    }
+}
+
+void MLFQMultinucleo::encolar(int nucleo, int nivel, IdProceso id) {
+    Nucleo& n = nucleos[nucleo];
+    n.colas[nivel].agregarProceso(id, tabla);
+    n.ocupadas.marcar(nivel);
+    if (n.listos++ == 0) {
+        conListos.marcar(nucleo);
+    }
+}
+
+IdProceso MLFQMultinucleo::sacar(int nucleo, int nivel) {
+    Nucleo& n = nucleos[nucleo];
+    IdProceso id = n.colas[nivel].obtenerSiguienteProceso();
+    if (n.colas[nivel].estaVacia()) {
+        n.ocupadas.desmarcar(nivel);
+    }
+    if (--n.listos == 0) {
+        conListos.desmarcar(nucleo);
+    }
+    return id;
+}
+
+void MLFQMultinucleo::tocar(int nucleo) {
+    if (!fueTocado[nucleo]) {
+        fueTocado[nucleo] = 1;
+        tocados.push_back(nucleo);
+    }
+}
+
+/*
+  Reparte los procesos que ya llegaron
+  
+  Cada uno entra a su cola inicial (mismo criterio que MLFQScheduler) en
+  el nucleo que escoja la politica de balanceo.
+ */
+void MLFQMultinucleo::moverProcesosLlegados() {
+    int cantidad = (int)nucleos.size();
+    colaLlegadas.liberarHasta(tiempoGlobal, [this, cantidad](IdProceso id) {
+        int nivel = std::max(0, std::min(tabla.getColaOriginal(id), (int)esquemas.size()) - 1);
+        tabla.setCola(id, nivel);
+        
+        int nucleo = balanceo->nucleoParaLlegada(*this, id);
+        if (nucleo < 0 || nucleo >= cantidad) {
+            nucleo = ((nucleo % cantidad) + cantidad) % cantidad;
+        }
+        encolar(nucleo, nivel, id);
+        tocar(nucleo);
+    });
+}
+
+// Hasta la siguiente llegada (1 unidad si ya hay una vencida)
+int MLFQMultinucleo::limiteExpropiacion() const {
+    if (!colaLlegadas.hayPendientes()) {
+        return INT_MAX;
+    }
+    int llegada = colaLlegadas.proxima();
+    return llegada > tiempoGlobal ? llegada - tiempoGlobal : 1;
+}
+
+void MLFQMultinucleo::finalizarProceso(IdProceso id) {
+    tabla.setTiempoFinalizacion(id, tiempoGlobal);
+    procesosFinalizados.push_back(id);
+    metricas.agregar(tabla, id);
+}
+
+/*
+  Termina la rebanada del nucleo en el instante actual
+  
+  El proceso termina, vuelve a su cola (STCF) o baja un nivel, siempre
+  en el mismo nucleo; el nucleo queda ocioso hasta despacharOciosos.
+ */
+void MLFQMultinucleo::terminarRebanada(int nucleo) {
+    Nucleo& n = nucleos[nucleo];
+    IdProceso id = n.actual;
+    int nivel = n.nivelActual;
+    n.nivelActual = -1;
+    ociosos.marcar(nucleo);
+    tocar(nucleo);
+    
+    if (tabla.estaCompleto(id)) {
+        finalizarProceso(id);
+    } else if (esquemas[nivel].politica == TipoPolitica::STCF) {
+        encolar(nucleo, nivel, id);
+    } else {
+        int nuevoNivel = std::min(nivel + 1, (int)esquemas.size() - 1);
+        tabla.setCola(id, nuevoNivel);
+        encolar(nucleo, nuevoNivel, id);
+    }
+}
+
+/*
+  Empieza una rebanada en un nucleo ocioso con procesos listos
+  
+  Escoge como MLFQScheduler (la cola de mayor prioridad con procesos) y
+  calcula la rebanada completa de una vez; el proceso queda ejecutado y el
+  fin de la rebanada entra al heap de eventos.
+ */
+void MLFQMultinucleo::despachar(int nucleo) {
+    Nucleo& n = nucleos[nucleo];
+    int nivel = n.ocupadas.primero();
+    IdProceso id = sacar(nucleo, nivel);
+    
+    if (ultimoNucleo[id] >= 0 && ultimoNucleo[id] != nucleo) {
+        migraciones[id]++;
+    }
+    ultimoNucleo[id] = nucleo;
+    
+    const EsquemaCola& esquema = esquemas[nivel];
+    int restante = tabla.getTiempoRestante(id);
+    int unidades = 0;
+    switch (esquema.politica) {
+        case TipoPolitica::ROUND_ROBIN:
+            unidades = std::min(esquema.quantum, restante);
+            break;
+        case TipoPolitica::SJF:
+            unidades = NivelSJF::rebanada(restante, 0);
+            break;
+        case TipoPolitica::STCF:
+            unidades = NivelSTCF::rebanada(restante, limiteExpropiacion());
+            break;
+    }
+    
+    tabla.ejecutar(id, tiempoGlobal, unidades);
+    n.actual = id;
+    n.nivelActual = nivel;
+    n.tiempoOcupado += unidades;
+    n.rebanadas++;
+    ociosos.desmarcar(nucleo);
+    finesRebanada.push(std::make_pair(tiempoGlobal + unidades, nucleo));
+}
+
+/*
+  Roba un proceso listo para el nucleo ocioso 'ladron'
+  
+  La victima la propone la politica; si no tiene procesos listos se usa el
+  primer nucleo que si tenga. Se roba el proceso que la victima iba a
+  ejecutar despues (el de su cola de mayor prioridad), y conserva su cola.
+ */
+bool MLFQMultinucleo::robar(int ladron) {
+    if (conListos.vacio()) {
+        return false;
+    }
+    
+    int victima = balanceo->victimaParaRobo(*this, ladron);
+    if (victima < 0 || victima >= (int)nucleos.size() || nucleos[victima].listos == 0) {
+        victima = conListos.primero();
+    }
+    
+    int nivel = nucleos[victima].ocupadas.primero();
+    IdProceso id = sacar(victima, nivel);
+    encolar(ladron, nivel, id);
+    nucleos[ladron].robos++;
+    return true;
+}
+
+/*
+  Despacha los nucleos libres al final de un instante
+  
+  Primero los nucleos que tuvieron un evento y tienen procesos propios;
+  despues, mientras haya nucleos ociosos y procesos esperando en otros
+  nucleos, los ociosos roban.
+ */
+void MLFQMultinucleo::despacharOciosos() {
+    for (int nucleo : tocados) {
+        fueTocado[nucleo] = 0;
+        if (nucleos[nucleo].nivelActual < 0 && nucleos[nucleo].listos > 0) {
+            despachar(nucleo);
+        }
+    }
+    tocados.clear();
+    
+    while (!ociosos.vacio() && !conListos.vacio()) {
+        int ladron = ociosos.primero();
+        robar(ladron);
+        despachar(ladron);
+    }
+}
+
+/*
+  Ejecuta toda la simulacion
+  
+  En cada iteracion el tiempo salta al siguiente evento: el menor fin de
+  rebanada del heap o, si hay algun nucleo ocioso, la proxima llegada.
+  Terminan todas las rebanadas de ese instante, entran las llegadas y se
+  despachan los nucleos libres. Igual que en MLFQScheduler, un proceso que
+  llega mientras todos los nucleos ejecutan entra a su cola en el
+  siguiente fin de rebanada, detras del proceso que vuelve a la cola.
+  Como ningun nucleo queda ocioso con trabajo esperando, si el heap esta
+  vacio y no hay llegadas no queda nada por hacer.
+ */
+void MLFQMultinucleo::ejecutarSimulacion() {
+    colaLlegadas.ordenar();
+    
+    while (colaLlegadas.hayPendientes() || !finesRebanada.empty()) {
+        // Una llegada solo es un evento si hay un nucleo ocioso que la atienda
+        if (finesRebanada.empty() ||
+            (!ociosos.vacio() && colaLlegadas.hayPendientes() && colaLlegadas.proxima() < finesRebanada.top().first)) {
+            tiempoGlobal = colaLlegadas.proxima();
+        } else {
+            tiempoGlobal = finesRebanada.top().first;
+        }
+        
+        while (!finesRebanada.empty() && finesRebanada.top().first == tiempoGlobal) {
+            int nucleo = finesRebanada.top().second;
+            finesRebanada.pop();
+            terminarRebanada(nucleo);
+        }
+        moverProcesosLlegados();
+        despacharOciosos();
+    }
+}
+
+long long MLFQMultinucleo::getMigracionesTotales() const {
+    long long total = 0;
+    for (IdProceso id : procesosFinalizados) {
+        total += migraciones[id];
+    }
+    return total;
+}
+
+/*
+  Escribe los resultados en un archivo
+  
+  Mismo formato que el archivo de salida de MLFQScheduler (ordenado por
+  etiqueta, con la linea de promedios) mas el ultimo nucleo que ejecuto
+  cada proceso y sus migraciones.
+ */
+bool MLFQMultinucleo::escribirSalida(const std::string& rutaArchivo) const {
+    std::ofstream archivo(rutaArchivo);
+    if (!archivo.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << rutaArchivo << std::endl;
+        return false;
+    }
+    
+    archivo << "# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT; Nucleo; Migraciones\n";
+    
+    std::vector<IdProceso> procesosOrdenados(procesosFinalizados.begin(), procesosFinalizados.end());
+    std::sort(procesosOrdenados.begin(), procesosOrdenados.end(),
+              [this](IdProceso a, IdProceso b) { return tabla.getEtiqueta(a) < tabla.getEtiqueta(b); });
+    
+    for (IdProceso id : procesosOrdenados) {
+        archivo << tabla.getEtiqueta(id) << ";"
+                << tabla.getTiempoRafaga(id) << ";"
+                << tabla.getTiempoLlegada(id) << ";"
+                << (tabla.getCola(id) + 1) << ";"
+                << tabla.getPrioridad(id) << ";"
+                << tabla.getTiempoEspera(id) << ";"
+                << tabla.getTiempoFinalizacion(id) << ";"
+                << tabla.getTiempoRespuesta(id) << ";"
+                << tabla.getTiempoRetorno(id) << ";"
+                << ultimoNucleo[id] << ";"
+                << migraciones[id] << "\n";
+    }
+    
+    double promWT, promCT, promRT, promTAT;
+    metricas.calcularPromedios(promWT, promCT, promRT, promTAT);
+    archivo << std::fixed << std::setprecision(1);
+    archivo << "WT=" << promWT << ";CT=" << promCT
+            << ";RT=" << promRT << ";TAT=" << promTAT << ";" << std::endl;
+    return true;
+}
+
+/*
+  Escribe el resumen por nucleo
+  
+  La utilizacion es el tiempo ocupado sobre el tiempo total de la
+  simulacion. Al final van las migraciones de todos los procesos.
+ */
+void MLFQMultinucleo::escribirResumenNucleos(std::ostream& salida) const {
+    salida << "# nucleo; ocupado; utilizacion; rebanadas; robos\n";
+    for (std::size_t c = 0; c < nucleos.size(); c++) {
+        const Nucleo& n = nucleos[c];
+        double utilizacion = tiempoGlobal > 0 ? (double)n.tiempoOcupado / tiempoGlobal : 0.0;
+        salida << c << ";" << n.tiempoOcupado << ";" << std::fixed << std::setprecision(3) << utilizacion
+               << ";" << n.rebanadas << ";" << n.robos << "\n";
+    }
+    salida << "migraciones;" << getMigracionesTotales() << "\n";
+}
@@ -0,0 +1,156 @@
+#ifndef MLFQMULTINUCLEO_H
+#define MLFQMULTINUCLEO_H
+
+#include "MLFQScheduler.h"
+#include "Balanceo.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+  Clase MLFQMultinucleo
+  
+  Simula K CPUs, cada una con su propio MLFQ (mismas colas y politicas
+  para todas, con su propio mapa de ocupacion). Los procesos se reparten
+  al llegar segun una PoliticaBalanceo, y un nucleo que se queda sin
+  procesos le roba el siguiente proceso listo a otro nucleo, asi ningun
+  nucleo esta ocioso mientras haya trabajo esperando.
+  
+  La simulacion es por eventos, igual que MLFQScheduler, pero con un reloj
+  por nucleo: un heap guarda cuando termina la rebanada de cada nucleo
+  ocupado y el tiempo salta al siguiente evento (fin de rebanada o
+  llegada). En cada instante solo se tocan los nucleos que tienen un
+  evento; los ociosos y los que tienen procesos listos se ubican con
+  mapas de bits, asi que nada recorre los K nucleos.
+  
+  En cada instante primero terminan las rebanadas, despues entran las
+  llegadas y al final se despachan los nucleos libres; con un solo
+  nucleo da los mismos resultados que MLFQScheduler. Por proceso se
+  guarda el ultimo nucleo que lo ejecuto y cuantas veces migro (se
+  ejecuto en un nucleo distinto al anterior).
+  
+  No tiene traza por rebanada, boost ni modo en linea.
+ */
+class MLFQMultinucleo {
+private:
+    // Estado de una CPU
+    struct Nucleo {
+        std::pmr::vector<ColaNivel> colas;    // Colas de listos de este nucleo
+        MapaOcupacion ocupadas;               // Que colas tienen procesos
+        int listos;                           // Procesos en sus colas
+        IdProceso actual;                     // Proceso en ejecucion (si ocupado)
+        int nivelActual;                      // Cola del proceso en ejecucion (-1 = ocioso)
+        long long tiempoOcupado;              // Unidades de tiempo ejecutando
+        long long rebanadas;                  // Rebanadas ejecutadas
+        long long robos;                      // Procesos que le robo a otros nucleos
+        
+        Nucleo(std::pmr::memory_resource* memoria, int niveles)
+            : colas(memoria), ocupadas(niveles), listos(0), actual(0), nivelActual(-1),
+              tiempoOcupado(0), rebanadas(0), robos(0) {}
+    };
+    
+    std::vector<EsquemaCola> esquemas;              // Configuracion de las colas (igual en todos)
+    Arena arena;                                   // Memoria de la simulacion
+    std::pmr::unsynchronized_pool_resource piscina;  // Para las colas, que crecen y se vacian
+    TablaProcesos tabla;                           // Estado de todos los procesos
+    std::pmr::vector<int> ultimoNucleo;            // Por proceso: ultimo nucleo que lo ejecuto (-1 = ninguno)
+    std::pmr::vector<int> migraciones;             // Por proceso: veces que cambio de nucleo
+    std::vector<Nucleo> nucleos;                   // Las K CPUs
+    MapaOcupacion ociosos;                         // Nucleos sin proceso en ejecucion
+    MapaOcupacion conListos;                       // Nucleos con procesos en sus colas
+    std::vector<int> tocados;                      // Nucleos con algun evento en el instante actual
+    std::vector<char> fueTocado;                   // Para no repetir un nucleo en 'tocados'
+    
+    // Fin de rebanada de cada nucleo ocupado: (tiempo, nucleo), el menor arriba
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                        std::greater<std::pair<int, int>>> finesRebanada;
+    
+    ColaLlegadas colaLlegadas;                     // Procesos que aun no llegan, por tiempo de llegada
+    std::pmr::vector<IdProceso> procesosFinalizados;  // Procesos terminados
+    AgregadorMetricas metricas;                    // Metricas acumuladas al terminar
+    std::unique_ptr<PoliticaBalanceo> balanceo;    // Reparto de llegadas y robos
+    int tiempoGlobal;                              // Instante del ultimo evento
+    
+    // Agrega un proceso a la tabla y le hace lugar en ultimoNucleo y migraciones
+    IdProceso registrarProceso(const RegistroProceso& registro) { return tabla.agregar(registro); }
+    IdProceso registrarProceso(const Proceso& proceso) { return tabla.agregar(proceso); }
+    void hacerLugar(IdProceso id);
+    
+    // Pone un proceso listo en una cola de un nucleo / saca el siguiente
+    void encolar(int nucleo, int nivel, IdProceso id);
+    IdProceso sacar(int nucleo, int nivel);
+    
+    // Anota un nucleo para despacharlo al final del instante actual
+    void tocar(int nucleo);
+    
+    void moverProcesosLlegados();
+    void terminarRebanada(int nucleo);
+    void despachar(int nucleo);
+    bool robar(int ladron);
+    void despacharOciosos();
+    int limiteExpropiacion() const;
+    void finalizarProceso(IdProceso id);
+
+public:
+    // K nucleos con la misma configuracion de colas; sin politica se usa
+    // BalanceoDosOpciones
+    MLFQMultinucleo(const std::vector<EsquemaCola>& esq, int cantidadNucleos,
+                    std::unique_ptr<PoliticaBalanceo> politica = nullptr);
+    
+    MLFQMultinucleo(const MLFQMultinucleo&) = delete;
+    MLFQMultinucleo& operator=(const MLFQMultinucleo&) = delete;
+    
+    // Agrega procesos (de RegistroProceso o Proceso) antes de simular
+    template <typename Iterador>
+    void agregarProcesos(Iterador inicio, Iterador fin);
+    
+    template <typename Rango>
+    void agregarProcesos(const Rango& procesos) { agregarProcesos(std::begin(procesos), std::end(procesos)); }
+    
+    // Ejecuta toda la simulacion hasta que terminen todos los procesos
+    void ejecutarSimulacion();
+    
+    // Archivo de salida con dos columnas mas: nucleo y migraciones
+    bool escribirSalida(const std::string& rutaArchivo) const;
+    
+    // Tabla por nucleo: tiempo ocupado, utilizacion, rebanadas y robos
+    void escribirResumenNucleos(std::ostream& salida) const;
+    
+    void calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const {
+        metricas.calcularPromedios(promWT, promCT, promRT, promTAT);
+    }
+    
+    // Consultas para las politicas de balanceo
+    int getCantidadNucleos() const { return (int)nucleos.size(); }
+    int getListos(int nucleo) const { return nucleos[nucleo].listos; }
+    int getCarga(int nucleo) const { return nucleos[nucleo].listos + (nucleos[nucleo].nivelActual >= 0 ? 1 : 0); }
+    
+    int getNucleo(IdProceso id) const { return ultimoNucleo[id]; }
+    int getMigraciones(IdProceso id) const { return migraciones[id]; }
+    long long getMigracionesTotales() const;
+    
+    int getTiempoGlobal() const { return tiempoGlobal; }
+    const TablaProcesos& getTabla() const { return tabla; }
+    const std::pmr::vector<IdProceso>& getProcesosFinalizados() const { return procesosFinalizados; }
+    const AgregadorMetricas& getMetricas() const { return metricas; }
+    const PoliticaBalanceo& getBalanceo() const { return *balanceo; }
+};
+
+template <typename Iterador>
+void MLFQMultinucleo::agregarProcesos(Iterador inicio, Iterador fin) {
+    colaLlegadas.agregarRango(inicio, fin, tabla, [this](const auto& proceso) {
+        IdProceso id = registrarProceso(proceso);
+        hacerLugar(id);
+        return id;
+    });
+}
+
+#endif
@@ -1,88 +1,299 @@
 #include "MLFQScheduler.h"
-#include "schedulers/RoundRobinScheduler.h"
-#include "schedulers/SJFScheduler.h" 
-#include "schedulers/STCFScheduler.h"
+#include "ArchivosSalida.h"
+#include "schedulers/NivelSJF.h"
+#include "schedulers/NivelSTCF.h"
 #include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
-#include <climits>
 
 /*
   Constructor del scheduler MLFQ
   
   Recibe la configuracion de esquemas que define como se comporta cada cola.
-  Inicializa el vector de colas vacias segun la cantidad de esquemas.
-  El tiempo global empieza en 0.
+  Inicializa una cola vacia por esquema, con la estructura que pide su
+  politica (FIFO para RR, ColaPorRestante para SJF/STCF). El tiempo global
+  empieza en 0.
+  
+  Con 'liberar' (modo en linea) la corrida nunca se reinicia, y en la
+  arena todo lo que se libera (columnas que se realojan, etiquetas
+  reemplazadas, bloques grandes que devuelve la piscina) se perderia: la
+  memoria creceria con el total de procesos y no con los vivos. Por eso
+  en ese modo los contenedores se crean sobre memoriaFlujo, una piscina
+  sobre el allocator del sistema que reutiliza los bloques chicos y
+  devuelve los grandes. Tiene que decidirse aqui: un contenedor pmr no
+  cambia de memoria al asignarle otro.
  */
-MLFQScheduler::MLFQScheduler(const std::vector<EsquemaCola>& esq) 
-    : esquemas(esq), tiempoGlobal(0) {
-    // Crear tantas colas como esquemas se definieron
-    colas.resize(esquemas.size());
+MLFQScheduler::MLFQScheduler(const std::vector<EsquemaCola>& esq, bool liberar)
+    : esquemas(esq), piscina(&arena),
+      memoriaFija(liberar ? &memoriaFlujo : static_cast<std::pmr::memory_resource*>(&arena)),
+      memoriaVariable(liberar ? &memoriaFlujo : static_cast<std::pmr::memory_resource*>(&piscina)),
+      tabla(*memoriaFija), colas(memoriaFija), ocupadas((int)esq.size()), colaLlegadas(tabla, memoriaVariable),
+      procesosFinalizados(memoriaFija), dormidos(memoriaVariable),
+      despiertos(memoriaVariable), tiempoGlobal(0),
+      periodoBoost(0), epocaBoost(0), contadores(esq.size()), verbosidad(Verbosidad::TRAZA), destinoTraza(&std::cout), detenida(false),
+      fuenteAbierta(false), enviosAbiertos(false), versionEnvios(0), liberarFinalizados(liberar), periodoCheckpoint(0), epocaCheckpoint(0) {
+    crearColas();
 }
 
 /*
   Destructor
   
-  Libera la memoria de todos los procesos creados durante la simulacion.
-  Esto incluye procesos finalizados, procesos que quedaron en colas,
-  y procesos que aun estaban en la cola de llegadas.
+  Los procesos viven en la tabla de procesos y las colas solo guardan ids,
+  asi que no hay nada que liberar uno por uno: los contenedores se
+  destruyen y la arena devuelve todos sus bloques de una vez.
  */
 MLFQScheduler::~MLFQScheduler() {
-    // Liberar procesos finalizados
-    for (auto proceso : procesosFinalizados) {
-        delete proceso;
+}
+
+/*
+  Crea las colas de scheduling
+  
+  Una cola por esquema, con la estructura que pide su politica. Las colas
+  crecen y se vacian todo el tiempo, asi que toman la memoria de la
+  piscina (que recicla los bloques liberados) y no directo de la arena.
+ */
+void MLFQScheduler::crearColas() {
+    colas.reserve(esquemas.size());
+    for (const EsquemaCola& esquema : esquemas) {
+        colas.emplace_back(esquema.politica, memoriaVariable);
     }
+}
+
+/*
+  Reinicia el scheduler para otra corrida
+  
+  Primero se reemplazan todos los contenedores por unos vacios (ninguno
+  puede seguir apuntando a memoria de la arena) y despues se vacian la
+  piscina y la arena, que conserva sus bloques. La siguiente corrida
+  reparte de esos mismos bloques sin volver al allocator del sistema.
+ */
+void MLFQScheduler::reiniciar() {
+    colas = std::pmr::vector<ColaNivel>(memoriaFija);
+    ocupadas.limpiar();
+    generacionesBoost.clear();
+    generacionesLibres.clear();
+    colaLlegadas = ColaLlegadas(tabla, memoriaVariable);
+    procesosFinalizados = std::pmr::vector<IdProceso>(memoriaFija);
+    dormidos = RuedaTiempos(memoriaVariable);
+    despiertos = std::pmr::vector<IdProceso>(memoriaVariable);
+    tabla = TablaProcesos(*memoriaFija);
     
-    // Liberar procesos que quedaron en las colas
-    for (auto& cola : colas) {
-        while (!cola.empty()) {
-            delete cola.front();
-            cola.pop();
-        }
-    }
+    piscina.release();
+    arena.reiniciar();
+    memoriaFlujo.release();
     
-    // Liberar procesos que no llegaron a ejecutar
-    for (auto proceso : colaLlegadas) {
-        delete proceso;
-    }
+    tiempoGlobal = 0;
+    epocaBoost = 0;
+    metricas.reiniciar();
+    contadores.reiniciar(esquemas.size());
+    envios.reset();
+    enviosAbiertos = false;
+    versionEnvios = 0;
+    detenida = false;
+    crearColas();
 }
 
 /*
- * Agrega un proceso al scheduler
+  Registra un proceso en la tabla y retorna su id
   
-  El proceso se agrega a la cola de llegadas ordenada por tiempo de llegada.
-  No se pone directamente en las colas de scheduling porque puede que
-  aun no haya llegado al sistema.
+  La version con puntero toma posesion del Proceso: copia sus datos a la
+  tabla y lo libera, igual que antes el scheduler liberaba los procesos
+  que recibia.
+ */
+IdProceso MLFQScheduler::registrarProceso(const Proceso& proceso) {
+    return tabla.agregar(proceso);
+}
 
+IdProceso MLFQScheduler::registrarProceso(Proceso* proceso) {
+    IdProceso id = tabla.agregar(*proceso);
+    delete proceso;
+    return id;
+}
 
+/*
+  Agrega un proceso al scheduler
+  
+  El proceso se agrega a la cola de llegadas, que se mantiene ordenada
+  por tiempo de llegada. No se pone directamente en las colas de scheduling
+  porque puede que aun no haya llegado al sistema.
+  
+  Es solo un atajo de agregarProcesos para un unico proceso.
  */
 void MLFQScheduler::agregarProceso(Proceso* proceso) {
-    colaLlegadas.push_back(proceso);
+    agregarProcesos(&proceso, &proceso + 1);
+}
+
+void MLFQScheduler::agregarProceso(const Proceso& proceso) {
+    agregarProcesos(&proceso, &proceso + 1);
+}
+
+/*
+  Lee procesos de la fuente (modo en linea)
+  
+  Para planificar en el tiempo actual hay que conocer todas las llegadas
+  hasta ese instante. Como la fuente da los procesos en orden de llegada,
+  basta leer hasta tener uno pendiente que llegue despues del tiempo
+  actual; ese tambien marca donde se corta una rebanada STCF y a donde
+  saltar si la CPU queda ociosa.
+ */
+void MLFQScheduler::leerFuente() {
+    RegistroProceso registro;
+    while (fuenteAbierta &&
+           (!colaLlegadas.hayPendientes() || tabla.getTiempoLlegada(colaLlegadas.ultimo()) <= tiempoGlobal)) {
+        if (!fuente(registro)) {
+            fuenteAbierta = false;
+            break;
+        }
+        IdProceso id = tabla.agregar(registro.etiqueta, registro.tiempoRafaga, registro.tiempoLlegada,
+                                     registro.cola, registro.prioridad);
+        tabla.ponerRafagas(id, registro.rafagas);
+        colaLlegadas.agregar(id);
+    }
+}
+
+void MLFQScheduler::abrirEnvios() {
+    envios.reset(new ColaEnvios());
+    enviosAbiertos = true;
+    versionEnvios = 0;
+}
+
+/*
+  Envia un proceso desde cualquier hilo
+  
+  Solo se valida y se copia el proceso a la cola de envios; el hilo de la
+  simulacion es el unico que toca la tabla.
+ */
+bool MLFQScheduler::enviarProceso(const RegistroProceso& registro) {
+    if (!envios || registro.tiempoRafaga <= 0 || contarRafagas(registro.rafagas) < 0) {
+        return false;
+    }
+    ProcesoEnviado proceso;
+    proceso.etiqueta = std::string(registro.etiqueta);
+    proceso.rafagas = std::string(registro.rafagas);
+    proceso.tiempoRafaga = registro.tiempoRafaga;
+    proceso.tiempoLlegada = registro.tiempoLlegada;
+    proceso.cola = registro.cola;
+    proceso.prioridad = registro.prioridad;
+    return envios->enviar(std::move(proceso));
+}
+
+void MLFQScheduler::cerrarEnvios() {
+    if (envios) {
+        envios->cerrar();
+    }
+}
+
+/*
+  Recibe los procesos enviados por otros hilos
+  
+  La version y el cierre se leen antes de vaciar la cola: si ya estaba
+  cerrada, todo lo enviado esta enlazado y esta vuelta lo saca completo;
+  si no, la version leida es la que se espera que cambie cuando la CPU
+  quede sin nada que hacer. Un proceso cuya llegada ya paso entra en el
+  tiempo actual (la simulacion no retrocede).
+ */
+void MLFQScheduler::recibirEnvios() {
+    if (!enviosAbiertos) {
+        return;
+    }
+    versionEnvios = envios->getVersion();
+    bool cerrada = envios->estaCerrada();
+    
+    ProcesoEnviado proceso;
+    while (envios->sacar(proceso)) {
+        contadores.enviosRecibidos++;
+        int llegada = proceso.tiempoLlegada;
+        if (llegada < tiempoGlobal) {
+            llegada = tiempoGlobal;
+            contadores.enviosTardios++;
+        }
+        IdProceso id = tabla.agregar(proceso.etiqueta, proceso.tiempoRafaga, llegada,
+                                     proceso.cola, proceso.prioridad);
+        tabla.ponerRafagas(id, proceso.rafagas);
+        colaLlegadas.agregar(id);
+    }
     
-    // Mantener la cola de llegadas ordenada por tiempo de llegada
-    std::sort(colaLlegadas.begin(), colaLlegadas.end(), 
-              [](Proceso* a, Proceso* b) { 
-                  return a->getTiempoLlegada() < b->getTiempoLlegada(); 
-              });
+    if (cerrada) {
+        enviosAbiertos = false;
+    }
 }
 
 /*
   Mueve procesos que ya llegaron a sus colas de scheduling
   
-  Revisa la cola de llegadas y mueve a las colas de scheduling todos
-  los procesos cuyo tiempo de llegada ya paso. Los procesos se ponen
-  en la cola especificada en su campo de cola original.
+  Saca de la cola de llegadas todos los procesos cuyo tiempo de llegada
+  ya paso y los pone en la cola especificada en su campo de cola original.
  */
 
 void MLFQScheduler::moverProcesosLlegados() {
-    while (!colaLlegadas.empty() && colaLlegadas[0]->getTiempoLlegada() <= tiempoGlobal) {
-        Proceso* proceso = colaLlegadas[0];
-        colaLlegadas.erase(colaLlegadas.begin());
-        
+    colaLlegadas.liberarHasta(tiempoGlobal, [this](IdProceso id) {
         // Poner el proceso en su cola inicial, convirtiendo de 1-indexed a 0-indexed
-        int nivelCola = proceso->getColaOriginal() - 1;
-        proceso->setCola(nivelCola);
-        colas[nivelCola].push(proceso);
+        // (si el esquema tiene menos colas, el proceso entra a la ultima)
+        int nivelCola = nivelInicial(id);
+        tabla.setCola(id, nivelCola);
+        encolarEnNivel(nivelCola, id);
+    });
+    
+    despertarProcesos();
+}
+
+/*
+  Despierta los procesos cuya E/S termino hasta el tiempo actual
+  
+  Salen de la rueda en orden de despertar (y en el mismo instante, en el
+  orden en que se bloquearon) y vuelven a la cola que tenian al
+  bloquearse, detras de las llegadas de ese mismo instante.
+ */
+void MLFQScheduler::despertarProcesos() {
+    if (dormidos.vacia()) {
+        return;
+    }
+    despiertos.clear();
+    dormidos.avanzar(tiempoGlobal, despiertos);
+    
+    for (IdProceso id : despiertos) {
+        contadores.despertares++;
+        encolarEnNivel(tabla.getCola(id), id);
+    }
+}
+
+/*
+  Boost contra la inanicion, con epocas perezosas
+  
+  Cada periodoBoost unidades empieza una epoca nueva y todos los procesos
+  en espera deben volver al nivel 0. En vez de recorrerlos, el boost
+  aparta las colas actuales completas como una generacion (mover cada
+  ColaNivel es O(1), asi que el boost es O(niveles)) y deja colas vacias
+  en su lugar. Los procesos apartados se consideran en el nivel 0, delante
+  de los que entren despues; su cola se corrige recien cuando planificar
+  los saca. Si la CPU estuvo ocupada durante varias epocas basta un solo
+  boost.
+ */
+void MLFQScheduler::revisarBoost() {
+    if (periodoBoost <= 0 || tiempoGlobal / periodoBoost <= epocaBoost) {
+        return;
+    }
+    epocaBoost = tiempoGlobal / periodoBoost;
+    
+    if (ocupadas.vacio()) {
+        return;
+    }
+    contadores.boosts++;
+    
+    // Las colas nuevas salen de una generacion ya vaciada si hay alguna
+    // (todas usan la arena, asi que moverlas no copia nada)
+    generacionesBoost.push_back(GeneracionBoost{std::move(colas), std::move(ocupadas)});
+    if (!generacionesLibres.empty()) {
+        colas = std::move(generacionesLibres.back().colas);
+        ocupadas = std::move(generacionesLibres.back().ocupadas);
+        generacionesLibres.pop_back();
+    } else {
+        colas = std::pmr::vector<ColaNivel>(memoriaFija);
+        crearColas();
+        ocupadas = MapaOcupacion((int)esquemas.size());
     }
 }
 
@@ -91,280 +302,480 @@ void MLFQScheduler::moverProcesosLlegados() {
   
   Implementa la politica MLFQ: busca procesos en orden de prioridad
   (cola 0 primero, luego cola 1, etc.) y dentro de cada cola aplica
-  el algoritmo correspondiente.
+  el algoritmo correspondiente. La cola no se busca recorriendo los
+  niveles: el mapa de ocupacion la da con dos count-trailing-zeros, asi
+  que despachar cuesta lo mismo con 4 niveles que con 256.
+  
+  Cada cola ya sabe escoger segun su politica: Round Robin saca el primero
+  y SJF/STCF sacan el de menor tiempo restante en O(log n).
   
-  Para Round Robin simplemente saca el primero de la cola.
-  Para SJF y STCF busca el proceso con menor tiempo restante.
+  Los procesos apartados por un boost estan logicamente al frente del
+  nivel 0, asi que salen primero (la generacion mas vieja antes, y dentro
+  de ella en el orden de sus niveles anteriores); al sacarlos se les
+  asigna la cola 0.
  */
-std::pair<int, Proceso*> MLFQScheduler::planificar() {
-    // Buscar en orden de prioridad (cola 0 tiene mayor prioridad)
-    for (int i = 0; i < colas.size(); i++) {
-        if (!colas[i].empty()) {
-            TipoPolitica politica = esquemas[i].politica;
-            
-            if (politica == TipoPolitica::ROUND_ROBIN) {
-                // Round Robin: simplemente tomar el primero
-                Proceso* proceso = colas[i].front();
-                colas[i].pop();
-                return std::make_pair(i, proceso);
-                
-            } else {
-                // SJF o STCF: buscar el de menor tiempo restante
-                std::vector<Proceso*> temp;
-                Proceso* mejor = nullptr;
-                int menorTiempo = INT_MAX;
-                
-                // Sacar todos los procesos de la cola para buscar el mejor
-                while (!colas[i].empty()) {
-                    Proceso* p = colas[i].front();
-                    colas[i].pop();
-                    
-                    // Verificar si este proceso es mejor que el actual mejor
-                    if (p->getTiempoRestante() < menorTiempo || 
-                        (p->getTiempoRestante() == menorTiempo && 
-                         (mejor == nullptr || p->getTiempoLlegada() < mejor->getTiempoLlegada()))) {
-                        
-                        // Si habia un mejor anterior, guardarlo en temp
-                        if (mejor) temp.push_back(mejor);
-                        mejor = p;
-                        menorTiempo = p->getTiempoRestante();
-                    } else {
-                        // Este proceso no es el mejor, guardarlo en temp
-                        temp.push_back(p);
-                    }
-                }
-                
-                // Devolver todos los procesos que no fueron seleccionados
-                for (Proceso* p : temp) colas[i].push(p);
-                
-                return std::make_pair(i, mejor);
+std::pair<int, IdProceso> MLFQScheduler::planificar() {
+    while (!generacionesBoost.empty()) {
+        GeneracionBoost& generacion = generacionesBoost.front();
+        int nivel = generacion.ocupadas.primero();
+        if (nivel >= 0) {
+            ColaNivel& cola = generacion.colas[nivel];
+            IdProceso id = cola.obtenerSiguienteProceso();
+            if (cola.estaVacia()) {
+                generacion.ocupadas.desmarcar(nivel);
             }
+            tabla.setCola(id, 0);
+            contadores.promovidosBoost++;
+            return std::make_pair(0, id);
         }
+        generacionesLibres.push_back(std::move(generacion));
+        generacionesBoost.pop_front();
     }
     
-    // No hay procesos listos
-    return std::make_pair(-1, nullptr);
+    // La cola de mayor prioridad con procesos (cola 0 primero)
+    int nivel = ocupadas.primero();
+    if (nivel < 0) {
+        // No hay procesos listos
+        return std::make_pair(-1, (IdProceso)0);
+    }
+    
+    IdProceso id = colas[nivel].obtenerSiguienteProceso();
+    if (colas[nivel].estaVacia()) {
+        ocupadas.desmarcar(nivel);
+    }
+    return std::make_pair(nivel, id);
 }
 
 /*
-  Ejecuta un proceso usando el scheduler apropiado para su cola
+  Marca un proceso como terminado en el tiempo actual
   
-  Crea una instancia del scheduler especifico (RR, SJF, o STCF),
-  le pasa el proceso, y maneja la ejecucion. Despues del quantum
-  o terminacion, decide si degradar el proceso o finalizarlo.
+  Guarda su tiempo de finalizacion, lo agrega a los finalizados y avisa
+  al observador (si hay). Si el observador pide detenerse, la simulacion
+  termina al volver al bucle principal. Con liberarFinalizados el proceso
+  no se guarda: despues de avisar al observador se libera su id.
+  Sus metricas se acumulan aqui mismo, asi los promedios y percentiles
+  no necesitan recorrer los procesos terminados.
  */
-void MLFQScheduler::ejecutarConScheduler(Proceso* proceso, int indiceCola) {
-    int tiempoEjecutado = 0;
-    TipoPolitica politica = esquemas[indiceCola].politica;
+void MLFQScheduler::finalizarProceso(IdProceso id) {
+    tabla.setTiempoFinalizacion(id, tiempoGlobal);
+    metricas.agregar(tabla, id);
+    if (!liberarFinalizados) {
+        procesosFinalizados.push_back(id);
+    }
     
-    // Si es la primera vez que ejecuta, marcar el tiempo de inicio
-    if (!proceso->getHaIniciado()) {
-        proceso->setTiempoInicio(tiempoGlobal);
-    }
-    
-    switch (politica) {
-        case TipoPolitica::ROUND_ROBIN: {
-            // Crear scheduler Round Robin con el quantum de esta cola
-            RoundRobinScheduler rrScheduler(esquemas[indiceCola].quantum);
-            rrScheduler.agregarProceso(proceso);
-            
-            Proceso* procesoActual = rrScheduler.obtenerSiguienteProceso();
-            if (procesoActual) {
-                // Ejecutar el proceso por su quantum
-                rrScheduler.ejecutarProceso(procesoActual, tiempoGlobal, tiempoEjecutado);
-                
-                // Mostrar lo que paso
-                std::cout << "Tiempo " << tiempoGlobal << " a " << (tiempoGlobal + tiempoEjecutado) 
-                          << ": Proceso " << procesoActual->getEtiqueta() 
-                          << " (Cola " << (indiceCola + 1) << ", RR-" << esquemas[indiceCola].quantum << ")" << std::endl;
-                
-                // Avanzar el tiempo global
-                tiempoGlobal += tiempoEjecutado;
-                
-                if (procesoActual->estaCompleto()) {
-                    // El proceso termino
-                    procesoActual->setTiempoFinalizacion(tiempoGlobal);
-                    procesoActual->calcularMetricas();
-                    procesosFinalizados.push_back(procesoActual);
-                } else {
-                    // El proceso no termino, degradarlo a la siguiente cola
-                    int nuevaCola = std::min(indiceCola + 1, (int)colas.size() - 1);
-                    procesoActual->setCola(nuevaCola);
-                    colas[nuevaCola].push(procesoActual);
-                }
-            }
+    if (alFinalizar && !alFinalizar(id)) {
+        detenida = true;
+    }
+    
+    if (liberarFinalizados) {
+        tabla.liberar(id);
+    }
+}
+
+/*
+  Registra una rebanada de ejecucion en la traza
+  
+  La traza de texto es solo con verbosidad TRAZA. La linea se arma directo
+  en el buffer del escritor asincrono (sin pasar por iostream ni esperar
+  a la pantalla); el hilo escritor la vacia en el destino de la traza.
+  Con traza binaria, ademas se agrega el registro de la rebanada.
+ */
+void MLFQScheduler::registrarRebanada(IdProceso id, int indiceCola, int inicio, int fin, MotivoRebanada motivo) {
+    if (trazaBinaria) {
+        RegistroRebanada registro;
+        registro.inicio = inicio;
+        registro.duracion = fin - inicio;
+        registro.proceso = id;
+        registro.nivel = (std::uint16_t)indiceCola;
+        registro.motivo = (std::uint8_t)motivo;
+        registro.reservado = 0;
+        trazaBinaria->agregar(registro);
+    }
+    if (!traza) return;
+    
+    traza->escribir("Tiempo ");
+    traza->escribir(inicio);
+    traza->escribir(" a ");
+    traza->escribir(fin);
+    traza->escribir(": Proceso ");
+    traza->escribir(tabla.getEtiqueta(id));
+    traza->escribir(" (Cola ");
+    traza->escribir(indiceCola + 1);
+    switch (esquemas[indiceCola].politica) {
+        case TipoPolitica::ROUND_ROBIN:
+            traza->escribir(", RR-");
+            traza->escribir(esquemas[indiceCola].quantum);
+            traza->escribir(")\n");
             break;
+        case TipoPolitica::SJF:
+            traza->escribir(", SJF)\n");
+            break;
+        case TipoPolitica::STCF:
+            traza->escribir(", STCF)\n");
+            break;
+    }
+}
+
+/*
+  Limite de una rebanada expropiativa (STCF)
+  
+  Cuantas unidades puede ejecutar desde ahora el proceso STCF 'id' antes
+  de que algo lo desplace: la primera llegada que lo expropiaria (ver
+  llegadaQueExpropia), el siguiente boost y el siguiente fin de E/S (la
+  rueda no dice a que nivel vuelve el proceso, asi que cualquier
+  despertar corta la rebanada). La rueda se consulta despues de las
+  llegadas y solo hasta donde llegaria la rebanada, asi su cursor no
+  pasa del fin de la rebanada.
+  
+  Un evento que no lo desplaza no necesita cortar la rebanada: el proceso
+  volveria a su cola con la menor clave de ella y se despacharia de
+  nuevo. Lo unico que cambia ese corte es el orden de la cola, y eso lo
+  repite repetirCortesSaltados. La excepcion es un proceso sacado de una
+  generacion de boost, que va al frente del nivel 0 pero no compite con
+  lo que ya hay en esa cola; mientras queden generaciones se corta en la
+  siguiente llegada, como antes.
+ */
+int MLFQScheduler::limiteExpropiacion(IdProceso id, int indiceCola) {
+    int restante = tabla.getTiempoRestante(id);
+    int limite = INT_MAX;
+    
+    // Un boost puede cambiar quien deberia ejecutar
+    if (periodoBoost > 0) {
+        limite = proximoBoost() - tiempoGlobal;
+    }
+    
+    if (colaLlegadas.hayPendientes()) {
+        if (generacionesBoost.empty()) {
+            limite = std::min(limite, llegadaQueExpropia(id, indiceCola, std::min(limite, restante)));
+        } else {
+            int llegada = colaLlegadas.proxima();
+            limite = std::min(limite, llegada > tiempoGlobal ? llegada - tiempoGlobal : 1);
+        }
+    }
+    
+    // Un proceso que despierta de E/S tambien
+    if (!dormidos.vacia()) {
+        int alcance = std::min(limite, restante);
+        int hasta = alcance > INT_MAX - tiempoGlobal ? INT_MAX : tiempoGlobal + alcance;
+        int despertar = dormidos.proximo(hasta);
+        if (despertar <= hasta) {
+            limite = std::min(limite, despertar - tiempoGlobal);
+        }
+    }
+    return limite;
+}
+
+/*
+  Primera llegada que expropiaria a un proceso STCF
+  
+  Una llegada desplaza al proceso si entra a un nivel de mayor prioridad,
+  o a su mismo nivel con menor tiempo restante que el que le quedaria al
+  proceso en ese instante (NivelSTCF::desplaza). Las que entran a niveles
+  de menor prioridad, o a este con un trabajo mas largo, se saltan: entran
+  a su cola como si se hubiera cortado ahi (repetirCortesSaltados).
+  
+  Las llegadas estan ordenadas, asi que se recorren hasta la primera que
+  expropia o hasta la primera que llega despues de 'alcance'. Para que
+  una rebanada no recorra demasiadas se revisan a lo sumo
+  LLEGADAS_REVISADAS y, si se llega a ese tope, la rebanada se corta en
+  la ultima revisada. Con una fuente en linea solo se conocen las
+  llegadas ya leidas, asi que la rebanada no pasa de la ultima: despues
+  pueden venir otras.
+ */
+int MLFQScheduler::llegadaQueExpropia(IdProceso id, int indiceCola, int alcance) const {
+    static constexpr std::size_t LLEGADAS_REVISADAS = 64;
+    int restante = tabla.getTiempoRestante(id);
+    int llegadaPropia = tabla.getTiempoLlegada(id);
+    std::size_t tope = std::min(colaLlegadas.pendientes(), LLEGADAS_REVISADAS);
+    
+    for (std::size_t i = 0; i < tope; i++) {
+        IdProceso otro = colaLlegadas.begin()[i];
+        int llegada = tabla.getTiempoLlegada(otro);
+        int unidades = llegada > tiempoGlobal ? llegada - tiempoGlobal : 1;
+        if (unidades >= alcance) {
+            return INT_MAX;
         }
         
-        case TipoPolitica::SJF: {
-            // Crear scheduler SJF
-            SJFScheduler sjfScheduler;
-            sjfScheduler.agregarProceso(proceso);
-            
-            Proceso* procesoActual = sjfScheduler.obtenerSiguienteProceso();
-            if (procesoActual) {
-                // SJF ejecuta hasta completar
-                sjfScheduler.ejecutarProceso(procesoActual, tiempoGlobal, tiempoEjecutado);
-                
-                std::cout << "Tiempo " << tiempoGlobal << " a " << (tiempoGlobal + tiempoEjecutado) 
-                          << ": Proceso " << procesoActual->getEtiqueta() 
-                          << " (Cola " << (indiceCola + 1) << ", SJF)" << std::endl;
-                
-                tiempoGlobal += tiempoEjecutado;
-                
-                // SJF siempre termina el proceso
-                procesoActual->setTiempoFinalizacion(tiempoGlobal);
-                procesoActual->calcularMetricas();
-                procesosFinalizados.push_back(procesoActual);
-            }
+        int nivel = nivelInicial(otro);
+        if (nivel < indiceCola || i + 1 == LLEGADAS_REVISADAS ||
+            (nivel == indiceCola && NivelSTCF::desplaza(tabla.getTiempoRestante(otro), llegada,
+                                                        restante - unidades, llegadaPropia))) {
+            return unidades;
+        }
+    }
+    
+    if (fuenteAbierta) {
+        int llegada = tabla.getTiempoLlegada(colaLlegadas.ultimo());
+        return llegada > tiempoGlobal ? llegada - tiempoGlobal : 1;
+    }
+    return INT_MAX;
+}
+
+/*
+  Repite los cortes que salto una rebanada STCF
+  
+  Saltar una llegada no es lo mismo que no cortar: al cortar, el proceso
+  volvia al final de su cola y se despachaba de nuevo, y eso corre un
+  lugar a los mejores anteriores de la cola (ColaPorRestante), lo que
+  cambia como se resuelven los empates despues. Antes de ejecutar la
+  rebanada se recorren las llegadas saltadas: en cada instante de corte
+  se aplica ese efecto sobre la cola (el proceso tiene ahi la menor
+  clave, si no la llegada lo habria desplazado) y despues entran las
+  llegadas de ese instante. Las que llegan al final de la rebanada
+  entran como siempre, despues de reencolarlo.
+ */
+void MLFQScheduler::repetirCortesSaltados(int indiceCola, int unidades) {
+    int inicio = tiempoGlobal;
+    while (colaLlegadas.hayPendientes()) {
+        int corte = std::max(colaLlegadas.proxima(), inicio + 1);
+        if (corte - inicio >= unidades) {
             break;
         }
-        
-        case TipoPolitica::STCF: {
-            // Crear scheduler STCF
-            STCFScheduler stcfScheduler;
-            stcfScheduler.agregarProceso(proceso);
-            
-            Proceso* procesoActual = stcfScheduler.obtenerSiguienteProceso();
-            if (procesoActual) {
-                // STCF puede ser interrumpido, calcular cuanto puede ejecutar
-                int tiempoMaximo = 1;  // Por defecto ejecuta 1 unidad
-                
-                // Verificar si hay procesos llegando pronto que podrian interrumpir
-                if (!colaLlegadas.empty()) {
-                    int proximaLlegada = colaLlegadas[0]->getTiempoLlegada();
-                    if (proximaLlegada > tiempoGlobal) {
-                        // Puede ejecutar hasta la proxima llegada o hasta terminar
-                        tiempoMaximo = std::min(procesoActual->getTiempoRestante(), 
-                                              proximaLlegada - tiempoGlobal);
-                    }
-                } else {
-                    // No hay mas llegadas, puede ejecutar hasta terminar
-                    tiempoMaximo = procesoActual->getTiempoRestante();
-                }
-                //ejecucion
-                stcfScheduler.ejecutarProceso(procesoActual, tiempoGlobal, tiempoEjecutado, tiempoMaximo);
-
-                
-                std::cout << "Tiempo " << tiempoGlobal << " a " << (tiempoGlobal + tiempoEjecutado) 
-                          << ": Proceso " << procesoActual->getEtiqueta() 
-                          << " (Cola " << (indiceCola + 1) << ", STCF)" << std::endl;
-                
-                tiempoGlobal += tiempoEjecutado;
-                
-                if (procesoActual->estaCompleto()) {
-                    // El proceso termino
-                    procesoActual->setTiempoFinalizacion(tiempoGlobal);
-                    procesoActual->calcularMetricas();
-                    procesosFinalizados.push_back(procesoActual);
-                } else {
-                    // El proceso no termino, vuelve a la misma cola 
-                    colas[indiceCola].push(procesoActual);
-                }
-            }
+        tiempoGlobal = corte;
+        colas[indiceCola].repetirCorte();
+        moverProcesosLlegados();
+    }
+    tiempoGlobal = inicio;
+}
+
+/*
+  Ejecuta una rebanada de un proceso segun la politica de su cola
+  
+  La rebanada se calcula directo, sin crear ningun objeto: Round Robin
+  ejecuta hasta su quantum, SJF hasta terminar y STCF hasta terminar o
+  hasta su limite de expropiacion. Despues, si el proceso termino se
+  finaliza; si no, Round Robin lo degrada a la siguiente cola y STCF lo
+  devuelve a la misma.
+ */
+void MLFQScheduler::ejecutarRebanada(IdProceso id, int indiceCola) {
+    const EsquemaCola& esquema = esquemas[indiceCola];
+    int restante = tabla.getTiempoRestante(id);
+    int tiempoEjecutado = 0;
+    
+    // Si es la primera vez que ejecuta, marcar el tiempo de inicio
+    if (!tabla.getHaIniciado(id)) {
+        tabla.setTiempoInicio(id, tiempoGlobal);
+    }
+    
+    switch (esquema.politica) {
+        case TipoPolitica::ROUND_ROBIN:
+            tiempoEjecutado = std::min(esquema.quantum, restante);
+            break;
+        case TipoPolitica::SJF:
+            tiempoEjecutado = NivelSJF::rebanada(restante, 0);
             break;
+        case TipoPolitica::STCF:
+            tiempoEjecutado = NivelSTCF::rebanada(restante, limiteExpropiacion(id, indiceCola));
+            repetirCortesSaltados(indiceCola, tiempoEjecutado);
+            break;
+    }
+    
+    // Ejecutar la rebanada completa de una vez y mostrar lo que paso
+    tabla.ejecutar(id, tiempoGlobal, tiempoEjecutado);
+    ContadoresNivel& contador = contadores.nivel(indiceCola);
+    contador.despachos++;
+    contador.tiempoEjecutado += tiempoEjecutado;
+    if (esquema.politica == TipoPolitica::STCF && tiempoEjecutado == 1) {
+        contador.rebanadasUnitarias++;
+    }
+    
+    MotivoRebanada motivo = tabla.estaCompleto(id) ? MotivoRebanada::FIN
+                          : tabla.rafagaTerminada(id) ? MotivoRebanada::BLOQUEO
+                          : esquema.politica == TipoPolitica::STCF ? MotivoRebanada::EXPROPIACION
+                          : MotivoRebanada::QUANTUM;
+    registrarRebanada(id, indiceCola, tiempoGlobal, tiempoGlobal + tiempoEjecutado, motivo);
+    tiempoGlobal += tiempoEjecutado;
+    
+    if (tabla.estaCompleto(id)) {
+        // El proceso termino
+        contador.terminados++;
+        finalizarProceso(id);
+    } else if (tabla.rafagaTerminada(id)) {
+        // Termino su rafaga de CPU: se bloquea en E/S conservando su nivel
+        contador.bloqueos++;
+        bloquearProceso(id, tiempoGlobal - tiempoEjecutado);
+    } else if (esquema.politica == TipoPolitica::STCF) {
+        // Expropiado: vuelve a la misma cola
+        contador.reencolados++;
+        encolarEnNivel(indiceCola, id);
+    } else {
+        // No termino su quantum: degradarlo a la siguiente cola
+        int nuevaCola = std::min(indiceCola + 1, (int)colas.size() - 1);
+        if (nuevaCola != indiceCola) {
+            contador.degradaciones++;
+        } else {
+            contador.reencolados++;
         }
+        tabla.setCola(id, nuevaCola);
+        encolarEnNivel(nuevaCola, id);
+    }
+}
+
+/*
+  Bloquea en E/S un proceso que termino una rafaga de CPU
+  
+  Duerme en la rueda hasta que termine su E/S. Como no esta en ninguna
+  cola, los boosts no lo ven; si algun boost cae entre el inicio de la
+  rebanada que acaba de ejecutar y su despertar, se le asigna el nivel 0
+  desde ya, como si hubiera estado esperando en una cola.
+ */
+void MLFQScheduler::bloquearProceso(IdProceso id, int inicioRebanada) {
+    int despertar = tiempoGlobal + tabla.iniciarES(id);
+    if (periodoBoost > 0 && tabla.getCola(id) != 0 &&
+        despertar / periodoBoost > inicioRebanada / periodoBoost) {
+        tabla.setCola(id, 0);
+        contadores.promovidosBoost++;
     }
+    dormidos.insertar(id, despertar);
 }
 
 /*
   Ejecuta toda la simulacion
   
-  Este es el bucle principal que maneja el tiempo global.
-  En cada iteracion:
+  Este es el bucle principal que maneja el tiempo global. La simulacion
+  es por eventos discretos: el tiempo nunca avanza de a una unidad, sino
+  que salta directamente al siguiente evento (fin de una rebanada o
+  llegada de un proceso). En cada iteracion:
   1. Mueve procesos que ya llegaron a sus colas
   2. Planifica el siguiente proceso a ejecutar
-  3. Lo ejecuta usando el scheduler apropiado
+  3. Lo ejecuta segun la politica de su cola, que calcula el fin de la
+     rebanada y deja tiempoGlobal en ese instante
   4. Repite hasta que no queden procesos
   
   Si no hay procesos listos pero si hay procesos por llegar,
-  avanza el tiempo hasta la proxima llegada.
+  salta el tiempo hasta la proxima llegada.
+  
+  Con una fuente (modo en linea) cada iteracion empieza leyendo los
+  procesos que hagan falta para decidir en el tiempo actual. Con boost,
+  despues de mover las llegadas se revisa si empezo una epoca nueva.
+  
+  Con verbosidad TRAZA las rebanadas se escriben por un EscritorAsincrono
+  que vive solo durante la simulacion; antes de imprimir el resumen se
+  espera a que termine, para que la traza salga completa y en orden. La
+  traza binaria, si se pidio, vive igual y se cierra con las etiquetas.
  */
 void MLFQScheduler::ejecutarSimulacion() {
-    std::cout << "\nIniciando simulacion MLFQ..." << std::endl;
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "\nIniciando simulacion MLFQ..." << std::endl;
+    }
+    if (verbosidad == Verbosidad::TRAZA) {
+        traza.reset(new EscritorAsincrono(*destinoTraza));
+    }
+    if (!rutaTrazaBinaria.empty()) {
+        if (liberarFinalizados) {
+            std::cerr << "Error: No se puede guardar la traza binaria si se liberan los procesos terminados" << std::endl;
+        } else {
+            std::vector<NivelTraza> niveles;
+            for (const EsquemaCola& esquema : esquemas) {
+                niveles.push_back({(std::int32_t)esquema.politica, esquema.quantum});
+            }
+            trazaBinaria.reset(new EscritorTrazaBinaria(rutaTrazaBinaria, niveles));
+            if (!trazaBinaria->abierto()) {
+                std::cerr << "Error al abrir el archivo de traza binaria: " << rutaTrazaBinaria << std::endl;
+                trazaBinaria.reset();
+            }
+        }
+    }
+    
+    if (periodoCheckpoint > 0) {
+        epocaCheckpoint = tiempoGlobal / periodoCheckpoint;
+    }
     
     // Continuar mientras haya procesos por llegar o procesos en colas
-    while (!colaLlegadas.empty() || hayProcesosPendientes()) {
-        // Mover procesos que ya llegaron
+    while (!detenida && (fuenteAbierta || enviosAbiertos || colaLlegadas.hayPendientes() || hayProcesosPendientes())) {
+        revisarCheckpoint();
+        
+        // Leer lo que falte de la fuente y mover procesos que ya llegaron
+        leerFuente();
+        recibirEnvios();
         moverProcesosLlegados();
+        revisarBoost();
         
         // Planificar el siguiente proceso
-        std::pair<int, Proceso*> resultado = planificar();
+        std::pair<int, IdProceso> resultado = planificar();
         int indiceCola = resultado.first;
-        Proceso* proceso = resultado.second;
+        IdProceso proceso = resultado.second;
         
-        if (!proceso) {
-            // No hay procesos listos, avanzar el tiempo
-            if (colaLlegadas.empty()) {
-                // No hay mas procesos por llegar, avanzar 1 unidad
-                tiempoGlobal++;
-            } else {
-                // Saltar al tiempo de la proxima llegada
-                tiempoGlobal = colaLlegadas[0]->getTiempoLlegada();
+        if (indiceCola < 0) {
+            // CPU ociosa: los unicos eventos posibles son la proxima
+            // llegada y el proximo fin de E/S (si no hay ninguno, la
+            // fuente se acabo y el ciclo termina)
+            int siguienteEvento = colaLlegadas.hayPendientes() ? colaLlegadas.proxima() : INT_MAX;
+            siguienteEvento = std::min(siguienteEvento, dormidos.proximo(siguienteEvento));
+            if (siguienteEvento != INT_MAX) {
+                contadores.saltosOciosos++;
+                contadores.tiempoOcioso += siguienteEvento - tiempoGlobal;
+                tiempoGlobal = siguienteEvento;
+            } else if (enviosAbiertos) {
+                // Nada que simular hasta que llegue otro envio (o el cierre)
+                envios->esperar(versionEnvios);
             }
             continue;
         }
         
-        // Ejecutar el proceso seleccionado
-        ejecutarConScheduler(proceso, indiceCola);
+        // Ejecutar el proceso seleccionado; el tiempo salta al fin de la rebanada
+        ejecutarRebanada(proceso, indiceCola);
     }
     
-    std::cout << "Simulacion completada en tiempo: " << tiempoGlobal << std::endl;
-}
-
-/*
-  Verifica si hay procesos pendientes en alguna cola
-  
-  Recorre todas las colas de scheduling para ver si alguna tiene procesos.
-  Se usa para determinar si la simulacion debe continuar.
- */
-bool MLFQScheduler::hayProcesosPendientes() const {
-    return std::any_of(colas.begin(), colas.end(), [](const std::queue<Proceso*>& cola) { 
-        return !cola.empty(); 
-    });
+    if (traza) {
+        traza->terminar();
+        traza.reset();
+    }
+    if (trazaBinaria) {
+        if (!trazaBinaria->terminar(tabla)) {
+            std::cerr << "Error al escribir la traza binaria: " << rutaTrazaBinaria << std::endl;
+        }
+        trazaBinaria.reset();
+    }
+    
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "Simulacion completada en tiempo: " << tiempoGlobal << std::endl;
+    }
 }
 
 /*
   Calcula los promedios de las metricas de rendimiento
   
-  Suma todas las metricas de los procesos finalizados y calcula
-  los promedios. Si no hay procesos finalizados, todos los promedios son 0.
+  Las sumas se acumulan al terminar cada proceso, asi que no se recorre
+  nada. Si no hay procesos finalizados, todos los promedios son 0.
  */
-void MLFQScheduler::calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) {
-    if (procesosFinalizados.empty()) {
-        promWT = promCT = promRT = promTAT = 0.0;
-        return;
-    }
-    
-    double sumaWT = 0, sumaCT = 0, sumaRT = 0, sumaTAT = 0;
-    
-    // Sumar todas las metricas
-    for (const auto& proceso : procesosFinalizados) {
-        sumaWT += proceso->getTiempoEspera();
-        sumaCT += proceso->getTiempoFinalizacion();
-        sumaRT += proceso->getTiempoRespuesta();
-        sumaTAT += proceso->getTiempoRetorno();
-    }
-    
-    // Calcular promedios
-    int cantidad = procesosFinalizados.size();
-    promWT = sumaWT / cantidad;
-    promCT = sumaCT / cantidad;
-    promRT = sumaRT / cantidad;
-    promTAT = sumaTAT / cantidad;
+void MLFQScheduler::calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const {
+    metricas.calcularPromedios(promWT, promCT, promRT, promTAT);
 }
 
 /*
   Escribe los resultados en un archivo
-
+  
   Genera un archivo con el formato requerido:
   - Header con los nombres de las columnas
   - Una linea por cada proceso con sus metricas
   - Linea final con los promedios
   
   Los procesos se ordenan alfabeticamente por etiqueta en el archivo.
+  El formato lo arma escribirArchivoSalida, que comparte con MLFQ<...>.
  */
 void MLFQScheduler::escribirSalida(const std::string& rutaArchivo) {
+    if (escribirArchivoSalida(rutaArchivo, tabla, procesosFinalizados, metricas) &&
+        verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "Resultados escritos en: " << rutaArchivo << std::endl;
+    }
+}
+
+void MLFQScheduler::escribirColumnas(const std::string& rutaArchivo) {
+    if (escribirArchivoColumnar(rutaArchivo, tabla, procesosFinalizados) &&
+        verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "Columnas escritas en: " << rutaArchivo << std::endl;
+    }
+}
+
+/*
+  Escribe las metricas de cola en un archivo aparte
+  
+  Promedio, p50, p95, p99 y maximo de WT, RT, TAT y slowdown, tomados de
+  los histogramas. Va en un archivo propio para no cambiar el formato del
+  archivo de salida.
+ */
+void MLFQScheduler::escribirMetricas(const std::string& rutaArchivo) {
     std::ofstream archivo(rutaArchivo);
     
     if (!archivo.is_open()) {
@@ -372,39 +783,49 @@ void MLFQScheduler::escribirSalida(const std::string& rutaArchivo) {
         return;
     }
     
-    // Escribir header
-    archivo << "# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n";
+    metricas.escribirPercentiles(archivo);
     
-    // Ordenar procesos por etiqueta para el archivo de salida
-    std::vector<Proceso*> procesosOrdenados = procesosFinalizados;
-    std::sort(procesosOrdenados.begin(), procesosOrdenados.end(), 
-              [](Proceso* a, Proceso* b) { 
-                  return a->getEtiqueta() < b->getEtiqueta(); 
-              });
+    archivo.close();
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "Metricas escritas en: " << rutaArchivo << std::endl;
+    }
+}
+
+/*
+  Escribe los contadores del motor en un archivo
+  
+  Con JSON queda un objeto con los totales y un arreglo de niveles; con
+  PROMETHEUS, el formato de texto que leen sus exportadores de archivos.
+  Cada nivel se identifica con su numero y su politica ("RR-2", "SJF",
+  "STCF").
+ */
+void MLFQScheduler::escribirContadores(const std::string& rutaArchivo, FormatoContadores formato) {
+    std::ofstream archivo(rutaArchivo);
     
-    // Escribir cada proceso
-    for (const auto& proceso : procesosOrdenados) {
-        archivo << proceso->getEtiqueta() << ";"
-                << proceso->getTiempoRafaga() << ";"
-                << proceso->getTiempoLlegada() << ";"
-                << (proceso->getCola() + 1) << ";"  // Convertir a 1-indexed
-                << proceso->getPrioridad() << ";"
-                << proceso->getTiempoEspera() << ";"
-                << proceso->getTiempoFinalizacion() << ";"
-                << proceso->getTiempoRespuesta() << ";"
-                << proceso->getTiempoRetorno() << std::endl;
+    if (!archivo.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << rutaArchivo << std::endl;
+        return;
     }
     
-    // Calcular y escribir promedios
-    double promWT, promCT, promRT, promTAT;
-    calcularPromedios(promWT, promCT, promRT, promTAT);
+    std::vector<std::string> nombres;
+    for (const EsquemaCola& esquema : esquemas) {
+        switch (esquema.politica) {
+            case TipoPolitica::ROUND_ROBIN: nombres.push_back("RR-" + std::to_string(esquema.quantum)); break;
+            case TipoPolitica::SJF: nombres.push_back("SJF"); break;
+            case TipoPolitica::STCF: nombres.push_back("STCF"); break;
+        }
+    }
     
-    archivo << std::fixed << std::setprecision(1);
-    archivo << "WT=" << promWT << ";CT=" << promCT 
-            << ";RT=" << promRT << ";TAT=" << promTAT << ";" << std::endl;
+    if (formato == FormatoContadores::PROMETHEUS) {
+        contadores.escribirPrometheus(archivo, nombres, tiempoGlobal);
+    } else {
+        contadores.escribirJSON(archivo, nombres, tiempoGlobal);
+    }
     
     archivo.close();
-    std::cout << "Resultados escritos en: " << rutaArchivo << std::endl;
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "Contadores escritos en: " << rutaArchivo << std::endl;
+    }
 }
 
 /*
@@ -413,15 +834,22 @@ void MLFQScheduler::escribirSalida(const std::string& rutaArchivo) {
   Imprime un resumen de la simulacion con informacion de cada proceso
   y los promedios calculados. Util para verificar los resultados
   antes de revisar el archivo de salida.
+  
+  Con verbosidad RESUMEN se omite el detalle de cada proceso, y con
+  NINGUNA no se imprime nada.
  */
 void MLFQScheduler::mostrarResultados() {
+    if (verbosidad == Verbosidad::NINGUNA) return;
+    
     std::cout << "\n=== RESULTADOS DE LA SIMULACION ===" << std::endl;
     std::cout << "Tiempo total de simulacion: " << tiempoGlobal << std::endl;
     std::cout << "Procesos completados: " << procesosFinalizados.size() << std::endl;
     
     // Mostrar informacion de cada proceso
-    for (const auto& proceso : procesosFinalizados) {
-        proceso->mostrarInfo();
+    if (verbosidad == Verbosidad::TRAZA) {
+        for (IdProceso id : procesosFinalizados) {
+            tabla.obtenerProceso(id).mostrarInfo();
+        }
     }
     
     // Calcular y mostrar promedios
@@ -434,4 +862,188 @@ void MLFQScheduler::mostrarResultados() {
     std::cout << "Tiempo de Finalizacion (CT): " << promCT << std::endl;
     std::cout << "Tiempo de Respuesta (RT): " << promRT << std::endl;
     std::cout << "Tiempo de Retorno (TAT): " << promTAT << std::endl;
-}
\ No newline at end of file
+    
+    std::cout << "\nPercentiles:" << std::endl;
+    metricas.escribirPercentiles(std::cout);
+}
+/*
+  Guarda el checkpoint periodico
+  
+  Se llama al empezar cada iteracion del bucle, cuando el estado esta
+  completo (ninguna rebanada a medias). Si el tiempo paso varias epocas de
+  una vez se guarda uno solo.
+ */
+void MLFQScheduler::revisarCheckpoint() {
+    if (periodoCheckpoint <= 0 || tiempoGlobal / periodoCheckpoint <= epocaCheckpoint) {
+        return;
+    }
+    epocaCheckpoint = tiempoGlobal / periodoCheckpoint;
+    guardarCheckpoint(rutaCheckpoint);
+}
+
+// Marcas al inicio y al final del checkpoint, y version del formato
+static const char MAGIA_CHECKPOINT[8] = {'M', 'L', 'F', 'Q', 'C', 'K', 'P', '6'};
+static const std::uint32_t FIN_CHECKPOINT = 0x4e494621;
+
+/*
+  Guarda el checkpoint en un archivo
+  
+  Se escribe primero a <ruta>.tmp y despues se renombra, asi un corte a
+  mitad de la escritura deja el checkpoint anterior intacto.
+ */
+bool MLFQScheduler::guardarCheckpoint(const std::string& rutaArchivo) const {
+    std::string temporal = rutaArchivo + ".tmp";
+    {
+        std::ofstream archivo(temporal, std::ios::binary);
+        if (!archivo.is_open()) {
+            std::cerr << "Error al abrir el archivo de checkpoint: " << temporal << std::endl;
+            return false;
+        }
+        if (!guardarCheckpoint(archivo)) {
+            return false;
+        }
+    }
+    if (std::rename(temporal.c_str(), rutaArchivo.c_str()) != 0) {
+        std::cerr << "Error al escribir el checkpoint: " << rutaArchivo << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+  Escribe el estado completo de la simulacion
+  
+  Formato: marca, esquemas, tiempo y boost, tabla de procesos, cada cola
+  en orden de nivel, las generaciones del boost, los procesos dormidos en
+  E/S, las llegadas pendientes, los finalizados, las metricas, los contadores y la marca de fin.
+ */
+bool MLFQScheduler::guardarCheckpoint(std::ostream& salida) const {
+    if (fuente) {
+        std::cerr << "Error: No se puede guardar un checkpoint en modo en linea" << std::endl;
+        return false;
+    }
+    if (enviosAbiertos) {
+        std::cerr << "Error: No se puede guardar un checkpoint con los envios abiertos" << std::endl;
+        return false;
+    }
+    
+    EscritorBinario escritor(salida);
+    escritor.escribir(MAGIA_CHECKPOINT);
+    escritor.escribir((std::uint32_t)esquemas.size());
+    for (const EsquemaCola& esquema : esquemas) {
+        escritor.escribir((std::int32_t)esquema.politica);
+        escritor.escribir((std::int32_t)esquema.quantum);
+    }
+    escritor.escribir(tiempoGlobal);
+    escritor.escribir(periodoBoost);
+    escritor.escribir(epocaBoost);
+    
+    tabla.guardar(escritor);
+    for (const ColaNivel& cola : colas) {
+        cola.guardar(escritor);
+    }
+    escritor.escribir((std::uint64_t)generacionesBoost.size());
+    for (const GeneracionBoost& generacion : generacionesBoost) {
+        for (const ColaNivel& cola : generacion.colas) {
+            cola.guardar(escritor);
+        }
+    }
+    dormidos.guardar(escritor);
+    
+    colaLlegadas.guardar(escritor);
+    escritor.escribirVector(procesosFinalizados);
+    metricas.guardar(escritor);
+    contadores.guardar(escritor);
+    escritor.escribir(FIN_CHECKPOINT);
+    
+    if (!escritor.bien()) {
+        std::cerr << "Error al escribir el checkpoint" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MLFQScheduler::cargarCheckpoint(const std::string& rutaArchivo) {
+    std::ifstream archivo(rutaArchivo, std::ios::binary);
+    if (!archivo.is_open()) {
+        std::cerr << "Error: No se pudo abrir el checkpoint " << rutaArchivo << std::endl;
+        return false;
+    }
+    return cargarCheckpoint(archivo);
+}
+
+/*
+  Restaura el estado guardado por guardarCheckpoint
+  
+  Descarta lo que tuviera el scheduler (reiniciar) y carga todo el
+  estado. Los esquemas del checkpoint deben ser los mismos del scheduler;
+  los ids de las colas se validan contra la tabla. Si algo no cuadra se
+  avisa por std::cerr, el scheduler queda vacio y se retorna false.
+ */
+bool MLFQScheduler::cargarCheckpoint(std::istream& entrada) {
+    reiniciar();
+    LectorBinario lector(entrada);
+    
+    char magia[sizeof(MAGIA_CHECKPOINT)];
+    std::uint32_t cantidadEsquemas = 0;
+    lector.leer(magia);
+    lector.leer(cantidadEsquemas);
+    bool mismosEsquemas = lector.bien() && std::memcmp(magia, MAGIA_CHECKPOINT, sizeof(magia)) == 0 &&
+                          cantidadEsquemas == esquemas.size();
+    for (std::uint32_t i = 0; mismosEsquemas && i < cantidadEsquemas; i++) {
+        std::int32_t politica = 0, quantum = 0;
+        lector.leer(politica);
+        lector.leer(quantum);
+        mismosEsquemas = lector.bien() && politica == (std::int32_t)esquemas[i].politica &&
+                         (esquemas[i].politica != TipoPolitica::ROUND_ROBIN || quantum == esquemas[i].quantum);
+    }
+    if (!mismosEsquemas) {
+        std::cerr << "Error: El checkpoint no es valido o es de otro esquema" << std::endl;
+        reiniciar();
+        return false;
+    }
+    
+    lector.leer(tiempoGlobal);
+    lector.leer(periodoBoost);
+    lector.leer(epocaBoost);
+    
+    tabla.cargar(lector);
+    std::size_t filas = tabla.tamano();
+    for (std::size_t nivel = 0; nivel < colas.size(); nivel++) {
+        if (colas[nivel].cargar(lector, filas) && !colas[nivel].estaVacia()) {
+            ocupadas.marcar((int)nivel);
+        }
+    }
+    
+    std::uint64_t generaciones = 0;
+    lector.leerTamano(generaciones, filas);
+    for (std::uint64_t g = 0; g < generaciones && lector.bien(); g++) {
+        GeneracionBoost generacion{std::pmr::vector<ColaNivel>(memoriaFija), MapaOcupacion((int)esquemas.size())};
+        generacion.colas.reserve(esquemas.size());
+        for (std::size_t nivel = 0; nivel < esquemas.size(); nivel++) {
+            generacion.colas.emplace_back(esquemas[nivel].politica, memoriaVariable);
+            if (generacion.colas.back().cargar(lector, filas) && !generacion.colas.back().estaVacia()) {
+                generacion.ocupadas.marcar((int)nivel);
+            }
+        }
+        generacionesBoost.push_back(std::move(generacion));
+    }
+    dormidos.cargar(lector, filas);
+    
+    std::uint32_t fin = 0;
+    colaLlegadas.cargar(lector, filas);
+    lector.leerVector(procesosFinalizados, filas);
+    metricas.cargar(lector);
+    contadores.cargar(lector);
+    lector.leer(fin);
+    
+    bool idsValidos = true;
+    for (IdProceso id : procesosFinalizados) idsValidos = idsValidos && id < filas;
+    
+    if (!lector.bien() || fin != FIN_CHECKPOINT || !idsValidos) {
+        std::cerr << "Error: El checkpoint esta incompleto o corrupto" << std::endl;
+        reiniciar();
+        return false;
+    }
+    return true;
+}
@@ -2,21 +2,28 @@
 #define MLFQSCHEDULER_H
 
 #include "Proceso.h"
+#include "Arena.h"
+#include "TablaProcesos.h"
+#include "ColaNivel.h"
+#include "EscritorAsincrono.h"
+#include "Metricas.h"
+#include "Contadores.h"
+#include "TrazaBinaria.h"
+#include "RuedaTiempos.h"
+#include "ColaLlegadas.h"
+#include "ColaEnvios.h"
 #include <vector>
-#include <queue>
 #include <string>
 #include <fstream>
 #include <utility>
-
-/*
-  Enumeracion para los tipos de algoritmos de scheduling
-  que pueden usarse en cada cola del MLFQ
- */
-enum class TipoPolitica {
-    ROUND_ROBIN,    // Round Robin con quantum
-    SJF,           // Shortest Job First
-    STCF           // Shortest Time-to-Completion First
-};
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
+#include <memory_resource>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <ostream>
 
 /*
   Estructura que define como se comporta cada cola
@@ -29,50 +36,183 @@ struct EsquemaCola {
     EsquemaCola(TipoPolitica pol, int q = -1) : politica(pol), quantum(q) {}
 };
 
+/*
+  Cuanto imprime el scheduler
+  NINGUNA: nada (para correr muchas simulaciones en paralelo)
+  RESUMEN: inicio, fin y promedios, sin el detalle de cada rebanada
+  TRAZA:   ademas, una linea por rebanada y el detalle de cada proceso
+ */
+enum class Verbosidad {
+    NINGUNA,
+    RESUMEN,
+    TRAZA
+};
+
 /*
   Clase MLFQScheduler
   
   Este es el scheduler principal que implementa Multilevel Feedback Queue.
-  Maneja multiples colas con diferentes prioridades y algoritmos.
+  Maneja multiples colas con diferentes prioridades y algoritmos, escogidos
+  en tiempo de ejecucion (ver MLFQEstatico.h para la version con los
+  niveles fijos en tiempo de compilacion).
   
   Los procesos empiezan en la cola de mayor prioridad (indice 0) y pueden
   ser degradados a colas de menor prioridad si no terminan en su quantum.
   
   El scheduler siempre ejecuta procesos de la cola de mayor prioridad que
   tenga procesos disponibles.
+  
+  Toda la memoria de una simulacion (tabla de procesos, colas, llegadas y
+  finalizados) sale de una Arena propia del scheduler: se libera de una
+  vez al destruirlo, y reiniciar() la deja lista para otra corrida sin
+  devolverla al sistema. En modo en linea (con 'liberar' en el
+  constructor) la corrida no termina nunca, asi que sale de memoriaFlujo,
+  que si recicla lo que se libera.
  */
 class MLFQScheduler {
 private:
+    // Colas apartadas por un boost, con su propio mapa de ocupacion
+    struct GeneracionBoost {
+        std::pmr::vector<ColaNivel> colas;
+        MapaOcupacion ocupadas;
+    };
+    
     std::vector<EsquemaCola> esquemas;              // Configuracion de cada cola
-    std::vector<std::queue<Proceso*>> colas;       // Las colas de procesos
-    std::vector<Proceso*> colaLlegadas;            // Procesos que aun no llegan
-    std::vector<Proceso*> procesosFinalizados;     // Procesos terminados
+    Arena arena;                                   // Memoria de la simulacion (va antes de quien la usa)
+    std::pmr::unsynchronized_pool_resource piscina;  // Reparte de la arena y recicla lo que se libera
+    std::pmr::unsynchronized_pool_resource memoriaFlujo;  // En modo en linea: recicla y devuelve al sistema
+    std::pmr::memory_resource* memoriaFija;        // Tabla y finalizados (la arena o memoriaFlujo)
+    std::pmr::memory_resource* memoriaVariable;    // Colas, llegadas y rueda (la piscina o memoriaFlujo)
+    TablaProcesos tabla;                           // Estado de todos los procesos
+    std::pmr::vector<ColaNivel> colas;             // Las colas de procesos (ids)
+    MapaOcupacion ocupadas;                        // Que colas tienen procesos
+    std::deque<GeneracionBoost> generacionesBoost;  // Colas apartadas por cada boost (todas en nivel 0)
+    std::vector<GeneracionBoost> generacionesLibres;  // Generaciones vacias para reutilizar
+    ColaLlegadas colaLlegadas;                     // Procesos que aun no llegan, por tiempo de llegada
+    std::pmr::vector<IdProceso> procesosFinalizados;  // Procesos terminados
+    RuedaTiempos dormidos;                         // Procesos bloqueados en E/S, por tiempo de despertar
+    std::pmr::vector<IdProceso> despiertos;        // Procesos que despiertan en el instante actual
     int tiempoGlobal;                              // Tiempo actual de simulacion
+    int periodoBoost;                              // Cada cuanto subir todo al nivel 0 (0 = nunca)
+    int epocaBoost;                                // Ultimo boost aplicado (tiempoGlobal / periodoBoost)
+    AgregadorMetricas metricas;                    // Metricas acumuladas al terminar cada proceso
+    ContadoresScheduler contadores;                // Lo que hizo el motor en cada nivel
+    Verbosidad verbosidad;                         // Cuanto se imprime
+    std::ostream* destinoTraza;                    // Donde va la traza (std::cout por defecto)
+    std::unique_ptr<EscritorAsincrono> traza;      // Escritor de la traza durante la simulacion
+    std::function<bool(IdProceso)> alFinalizar;    // Observador de procesos terminados
+    bool detenida;                                 // true si el observador pidio parar
+    std::function<bool(RegistroProceso&)> fuente;  // De donde leer procesos en linea (opcional)
+    bool fuenteAbierta;                            // true mientras la fuente pueda dar mas procesos
+    std::unique_ptr<ColaEnvios> envios;            // Procesos enviados por otros hilos (opcional)
+    bool enviosAbiertos;                           // true mientras puedan llegar mas envios
+    std::uint64_t versionEnvios;                   // Version de los envios antes de la ultima recepcion
+    bool liberarFinalizados;                       // true para no guardar los procesos terminados
+    int periodoCheckpoint;                         // Cada cuanto guardar un checkpoint (0 = nunca)
+    int epocaCheckpoint;                           // Ultimo checkpoint (tiempoGlobal / periodoCheckpoint)
+    std::string rutaCheckpoint;                    // Archivo del checkpoint periodico
+    std::string rutaTrazaBinaria;                  // Donde guardar la traza binaria (vacio = no guardarla)
+    std::unique_ptr<EscritorTrazaBinaria> trazaBinaria;  // Escritor de la traza binaria durante la simulacion
+    
+    // Crea una cola vacia por esquema
+    void crearColas();
     
     // Mueve procesos que ya llegaron a sus colas correspondientes
     void moverProcesosLlegados();
     
+    // Devuelve a su cola los procesos cuya E/S ya termino
+    void despertarProcesos();
+    
+    // Pone un proceso listo en la cola del nivel dado
+    void encolarEnNivel(int nivel, IdProceso id) {
+        colas[nivel].agregarProceso(id, tabla);
+        ocupadas.marcar(nivel);
+        contadores.encolado(nivel, colas[nivel].tamano());
+    }
+    
+    // Lee de la fuente hasta conocer una llegada posterior al tiempo actual
+    void leerFuente();
+    
+    // Pasa los procesos enviados por otros hilos a la cola de llegadas
+    void recibirEnvios();
+    
+    // Copia un proceso a la tabla (la version con puntero lo libera; la
+    // de registro no copia la etiqueta)
+    IdProceso registrarProceso(const Proceso& proceso);
+    IdProceso registrarProceso(Proceso* proceso);
+    IdProceso registrarProceso(const RegistroProceso& registro) { return tabla.agregar(registro); }
+    
+    // Aplica los boosts pendientes si el tiempo cambio de epoca
+    void revisarBoost();
+    
+    // Instante del siguiente boost (solo si periodoBoost > 0)
+    int proximoBoost() const { return (epocaBoost + 1) * periodoBoost; }
+    
     // Selecciona el siguiente proceso a ejecutar siguiendo las prioridades MLFQ
-    std::pair<int, Proceso*> planificar();
+    // (retorna cola -1 si no hay procesos listos)
+    std::pair<int, IdProceso> planificar();
     
-    // Ejecuta un proceso usando el scheduler apropiado para su cola
-    void ejecutarConScheduler(Proceso* proceso, int indiceCola);
+    // Registra el fin de un proceso en el tiempo actual
+    void finalizarProceso(IdProceso id);
     
-    // Verifica si quedan procesos en alguna cola
-    bool hayProcesosPendientes() const;
+    // Duerme un proceso en la rueda hasta que termine su siguiente E/S
+    void bloquearProceso(IdProceso id, int inicioRebanada);
     
-    // Calcula los promedios de las metricas
-    void calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT);
+    // Escribe una linea de traza por rebanada (solo con verbosidad TRAZA)
+    // y su registro en la traza binaria (si hay una abierta)
+    void registrarRebanada(IdProceso id, int indiceCola, int inicio, int fin, MotivoRebanada motivo);
+    
+    // Nivel al que entra un proceso cuando llega (su cola del archivo,
+    // desde 1, o la ultima si el esquema tiene menos)
+    int nivelInicial(IdProceso id) const {
+        return std::max(0, std::min(tabla.getColaOriginal(id), (int)esquemas.size()) - 1);
+    }
+    
+    // Cuanto puede ejecutar sin interrupcion el proceso STCF 'id' del
+    // nivel 'indiceCola' antes de que algo lo desplace
+    int limiteExpropiacion(IdProceso id, int indiceCola);
+    
+    // Unidades hasta la primera llegada conocida que desplazaria a 'id',
+    // revisando solo las que llegan antes de 'alcance' (INT_MAX si ninguna)
+    int llegadaQueExpropia(IdProceso id, int indiceCola, int alcance) const;
+    
+    // Aplica a las colas las llegadas saltadas por una rebanada STCF de
+    // 'unidades' en el nivel 'indiceCola', como si se hubiera cortado en cada una
+    void repetirCortesSaltados(int indiceCola, int unidades);
+    
+    // Ejecuta una rebanada del proceso segun la politica de su cola
+    void ejecutarRebanada(IdProceso id, int indiceCola);
+    
+    // Guarda el checkpoint periodico si el tiempo cambio de epoca
+    void revisarCheckpoint();
+    
+    // Verifica si quedan procesos en alguna cola
+    bool hayProcesosPendientes() const { return !ocupadas.vacio() || !generacionesBoost.empty() || !dormidos.vacia(); }
 
 public:
     // Crea el scheduler con la configuracion de esquemas especificada
-    MLFQScheduler(const std::vector<EsquemaCola>& esq);
+    // (de 1 a MapaOcupacion::MAX_NIVELES colas). Con 'liberar' cada proceso
+    // se libera al terminar (modo en linea, ver setFuente)
+    MLFQScheduler(const std::vector<EsquemaCola>& esq, bool liberar = false);
     
-    // Destructor que libera la memoria de todos los procesos
+    // Destructor (los procesos viven en la arena, se liberan con ella)
     ~MLFQScheduler();
     
-    // Agrega un proceso al scheduler (lo pone en cola de llegadas)
+    // Descarta todos los procesos y deja el scheduler listo para otra
+    // corrida con los mismos esquemas, reutilizando la memoria de la arena
+    void reiniciar();
+    
+    // Agrega un proceso al scheduler (lo pone en cola de llegadas).
+    // Con puntero, el scheduler copia el proceso a su tabla y lo libera.
     void agregarProceso(Proceso* proceso);
+    void agregarProceso(const Proceso& proceso);
+    
+    // Agrega muchos procesos de una vez; se ordenan una sola vez al simular
+    template <typename Iterador>
+    void agregarProcesos(Iterador inicio, Iterador fin);
+    
+    template <typename Rango>
+    void agregarProcesos(const Rango& procesos) { agregarProcesos(std::begin(procesos), std::end(procesos)); }
     
     // Ejecuta toda la simulacion hasta que terminen todos los procesos
     void ejecutarSimulacion();
@@ -80,12 +220,141 @@ public:
     // Escribe los resultados en un archivo
     void escribirSalida(const std::string& rutaArchivo);
     
+    // Escribe los mismos resultados por columnas (ver SalidaColumnar.h)
+    void escribirColumnas(const std::string& rutaArchivo);
+    
     // Muestra los resultados en pantalla
     void mostrarResultados();
     
+    // Escribe promedio y percentiles de WT, RT, TAT y slowdown en un archivo
+    void escribirMetricas(const std::string& rutaArchivo);
+    
+    // Escribe los contadores del motor (ver Contadores.h) como JSON o
+    // como texto de Prometheus
+    void escribirContadores(const std::string& rutaArchivo, FormatoContadores formato);
+    
+    // Calcula los promedios de las metricas
+    void calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const;
+    
+    // Cuanto se imprime (TRAZA por defecto) y a donde va la traza; el
+    // destino debe vivir mientras dure ejecutarSimulacion
+    void setVerbosidad(Verbosidad v) { verbosidad = v; }
+    Verbosidad getVerbosidad() const { return verbosidad; }
+    void setDestinoTraza(std::ostream& destino) { destinoTraza = &destino; }
+    
+    // Cada 'periodo' unidades de tiempo todos los procesos vuelven a la
+    // cola de mayor prioridad, para que los de las colas bajas no esperen
+    // indefinidamente (0 desactiva el boost, que es el comportamiento original)
+    void setPeriodoBoost(int periodo) { periodoBoost = periodo > 0 ? periodo : 0; }
+    
+    // Funcion que se llama cada vez que un proceso termina. Si retorna
+    // false la simulacion se detiene (por ejemplo, para podar una
+    // configuracion que ya no puede ganar)
+    void setAlFinalizar(std::function<bool(IdProceso)> f) { alFinalizar = std::move(f); }
+    bool fueDetenida() const { return detenida; }
+    
+    /*
+      Modo en linea
+      
+      Con una fuente, la simulacion pide los procesos a medida que los
+      necesita en vez de tenerlos todos desde el inicio: antes de planificar
+      en el tiempo t lee hasta conocer una llegada posterior a t (o hasta
+      que la fuente se acabe). La fuente debe dar los procesos en orden de
+      llegada y retornar false al terminar; la etiqueta se copia.
+      
+      Con 'liberar' en el constructor, cada proceso que termina se entrega
+      al observador y enseguida se libera (su id se reutiliza), asi la
+      memoria depende de los procesos vivos y no del total.
+     */
+    void setFuente(std::function<bool(RegistroProceso&)> f) { fuente = std::move(f); fuenteAbierta = (bool)fuente; }
+    
+    /*
+      Envios desde otros hilos
+      
+      abrirEnvios() (antes de lanzar los productores y de
+      ejecutarSimulacion) habilita enviarProceso, que cualquier hilo puede
+      llamar mientras la simulacion corre: copia el proceso a una cola sin
+      locks y el hilo de la simulacion los pasa a las llegadas al empezar
+      cada iteracion (entre un evento y el siguiente). Con los envios
+      abiertos la simulacion no termina: si no tiene nada que hacer, espera
+      al siguiente envio. cerrarEnvios() se llama cuando todos los
+      productores terminaron; la simulacion sigue hasta vaciar lo recibido.
+      
+      Regla de los envios tardios: la simulacion no retrocede. Un proceso
+      que se recibe cuando el tiempo ya paso su llegada entra con llegada
+      igual al tiempo actual (el de la recepcion), y se cuenta en
+      contadores.enviosTardios. Como la simulacion avanza tan rapido como
+      puede, cuales envios llegan tarde depende de la velocidad de los
+      productores, y el resultado puede cambiar de una corrida a otra.
+      
+      enviarProceso retorna false si los envios no estan abiertos o el
+      proceso no es valido (BT no positivo o rafagas mal formadas).
+     */
+    void abrirEnvios();
+    bool enviarProceso(const RegistroProceso& registro);
+    void cerrarEnvios();
+    
+    /*
+      Checkpoints
+      
+      Un checkpoint es una copia binaria de todo el estado de la simulacion:
+      tiempo, tabla de procesos, colas (con su orden), generaciones del
+      boost, llegadas pendientes, finalizados, metricas y contadores.
+      Cargarlo en un scheduler con los mismos esquemas y seguir la
+      simulacion da el mismo resultado que no haberla interrumpido. No se
+      puede con una fuente ni con envios abiertos, porque la posicion en
+      la entrada y lo que aun no se envia no son parte del estado.
+      
+      Con setCheckpoint, ejecutarSimulacion guarda uno cada 'periodo'
+      unidades de tiempo en la ruta dada (reemplazando el anterior).
+     */
+    bool guardarCheckpoint(const std::string& rutaArchivo) const;
+    bool guardarCheckpoint(std::ostream& salida) const;
+    bool cargarCheckpoint(const std::string& rutaArchivo);
+    bool cargarCheckpoint(std::istream& entrada);
+    void setCheckpoint(int periodo, const std::string& rutaArchivo) {
+        periodoCheckpoint = periodo > 0 ? periodo : 0;
+        rutaCheckpoint = rutaArchivo;
+    }
+    
+    /*
+      Traza binaria
+      
+      Ademas de (o en vez de) la traza de texto, ejecutarSimulacion puede
+      guardar cada rebanada como un registro de 16 bytes (ver
+      TrazaBinaria.h), sin importar la verbosidad. No se puede con
+      liberarFinalizados, porque los ids se reutilizan y las etiquetas
+      del final no corresponderian a los registros.
+     */
+    void setTrazaBinaria(const std::string& rutaArchivo) { rutaTrazaBinaria = rutaArchivo; }
+    
+    // Escribe la linea de salida de un proceso terminado
+    // (etiqueta;BT;AT;Q;Pr;WT;CT;RT;TAT)
+    void escribirLinea(std::ostream& salida, IdProceso id) const { tabla.escribirLinea(salida, id); }
+    void escribirLinea(EscritorTexto& salida, IdProceso id) const { tabla.escribirLinea(salida, id); }
+    
     // Getters para acceso de solo lectura
     int getTiempoGlobal() const { return tiempoGlobal; }
-    const std::vector<Proceso*>& getProcesosFinalizados() const { return procesosFinalizados; }
+    const TablaProcesos& getTabla() const { return tabla; }
+    const std::pmr::vector<IdProceso>& getProcesosFinalizados() const { return procesosFinalizados; }
+    const AgregadorMetricas& getMetricas() const { return metricas; }
+    const ContadoresScheduler& getContadores() const { return contadores; }
+    std::size_t getBytesArena() const { return arena.getBytesReservados(); }
 };
 
+/*
+  Agrega un rango de procesos al scheduler
+  
+  Los procesos se copian a la tabla y su id se agrega al final de la cola
+  de llegadas sin ordenar. Acepta rangos de Proceso*, de Proceso o de
+  RegistroProceso (en este caso las etiquetas no se copian, y el texto al
+  que apuntan debe vivir mas que el scheduler).
+  Si llegan en orden de tiempo de llegada no hace falta ordenar nunca
+  (ver ColaLlegadas).
+ */
+template <typename Iterador>
+void MLFQScheduler::agregarProcesos(Iterador inicio, Iterador fin) {
+    colaLlegadas.agregarRango(inicio, fin, tabla, [this](const auto& proceso) { return registrarProceso(proceso); });
+}
+
 #endif
\ No newline at end of file
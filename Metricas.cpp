@@ -0,0 +1,206 @@
+#include "Metricas.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+HistogramaMetrica::HistogramaMetrica() : conteo(CUBETAS, 0), cantidad(0), suma(0), maximo(0) {
+}
+
+/*
+  Cubeta de un valor
+  
+  Debajo de 2^BITS_EXACTOS la cubeta es el valor. Arriba, el exponente
+  (posicion del bit mas alto) escoge la potencia de dos y los siguientes
+  bits escogen una de sus SUBCUBETAS.
+ */
+int HistogramaMetrica::indice(std::uint64_t valor) {
+    if (valor < (1u << BITS_EXACTOS)) {
+        return (int)valor;
+    }
+    int exponente = 0;
+    while ((valor >> exponente) > 1) exponente++;
+    int desplazamiento = exponente - (BITS_EXACTOS - 1);
+    int sub = (int)(valor >> desplazamiento) - SUBCUBETAS;
+    return (1 << BITS_EXACTOS) + (exponente - BITS_EXACTOS) * SUBCUBETAS + sub;
+}
+
+std::uint64_t HistogramaMetrica::limiteSuperior(int cubeta) {
+    if (cubeta < (1 << BITS_EXACTOS)) {
+        return (std::uint64_t)cubeta;
+    }
+    int resto = cubeta - (1 << BITS_EXACTOS);
+    int exponente = BITS_EXACTOS + resto / SUBCUBETAS;
+    int desplazamiento = exponente - (BITS_EXACTOS - 1);
+    std::uint64_t sub = (std::uint64_t)(SUBCUBETAS + resto % SUBCUBETAS);
+    return ((sub + 1) << desplazamiento) - 1;
+}
+
+void HistogramaMetrica::agregar(long long valor) {
+    conteo[indice((std::uint64_t)std::max(0LL, valor))]++;
+    suma += valor;
+    maximo = cantidad == 0 ? valor : std::max(maximo, valor);
+    cantidad++;
+}
+
+void HistogramaMetrica::reiniciar() {
+    std::fill(conteo.begin(), conteo.end(), 0);
+    cantidad = 0;
+    suma = 0;
+    maximo = 0;
+}
+
+/*
+  Guarda el histograma para un checkpoint
+  
+  Casi todas las cubetas estan en cero, asi que solo se escriben las
+  ocupadas, como pares (cubeta, cuenta) en orden de cubeta.
+ */
+void HistogramaMetrica::guardar(EscritorBinario& escritor) const {
+    escritor.escribir(cantidad);
+    escritor.escribir(suma);
+    escritor.escribir(maximo);
+    
+    std::uint32_t ocupadas = (std::uint32_t)(CUBETAS - std::count(conteo.begin(), conteo.end(), 0));
+    escritor.escribir(ocupadas);
+    for (int i = 0; i < CUBETAS; i++) {
+        if (conteo[i] != 0) {
+            escritor.escribir((std::uint32_t)i);
+            escritor.escribir(conteo[i]);
+        }
+    }
+}
+
+/*
+  Carga un histograma guardado con guardar
+  
+  Las cubetas tienen que venir en orden, sin repetirse, y sus cuentas
+  sumar la cantidad.
+ */
+bool HistogramaMetrica::cargar(LectorBinario& lector) {
+    std::fill(conteo.begin(), conteo.end(), 0);
+    lector.leer(cantidad);
+    lector.leer(suma);
+    lector.leer(maximo);
+    
+    std::uint32_t ocupadas = 0;
+    lector.leer(ocupadas);
+    if (ocupadas > (std::uint32_t)CUBETAS) {
+        lector.fallar();
+    }
+    std::uint64_t total = 0;
+    std::int64_t anterior = -1;
+    for (std::uint32_t k = 0; k < ocupadas && lector.bien(); k++) {
+        std::uint32_t cubeta = 0;
+        std::uint64_t cuenta = 0;
+        lector.leer(cubeta);
+        lector.leer(cuenta);
+        if (!lector.bien() || cubeta >= (std::uint32_t)CUBETAS || (std::int64_t)cubeta <= anterior || cuenta == 0) {
+            lector.fallar();
+            break;
+        }
+        conteo[cubeta] = cuenta;
+        anterior = cubeta;
+        total += cuenta;
+    }
+    if (total != cantidad) {
+        lector.fallar();
+    }
+    return lector.bien();
+}
+
+/*
+  Percentil por rango cercano
+  
+  Busca la cubeta donde la cuenta acumulada alcanza ceil(p * cantidad).
+  Recorre a lo sumo todas las cubetas, que son una cantidad fija.
+ */
+long long HistogramaMetrica::percentil(double p) const {
+    if (cantidad == 0) return 0;
+    
+    std::uint64_t rango = (std::uint64_t)std::ceil(p * cantidad);
+    rango = std::clamp<std::uint64_t>(rango, 1, cantidad);
+    
+    std::uint64_t acumulado = 0;
+    for (int i = 0; i < CUBETAS; i++) {
+        acumulado += conteo[i];
+        if (acumulado >= rango) {
+            return std::min((long long)limiteSuperior(i), maximo);
+        }
+    }
+    return maximo;
+}
+
+AgregadorMetricas::AgregadorMetricas() : sumaFinalizacion(0) {
+}
+
+void AgregadorMetricas::agregar(long long bt, long long wt, long long ct, long long rt, long long tat) {
+    espera.agregar(wt);
+    respuesta.agregar(rt);
+    retorno.agregar(tat);
+    sumaFinalizacion += ct;
+    
+    // Slowdown = TAT / BT (1 si el proceso no pedia CPU)
+    long long slowdown = bt > 0 ? std::llround(100.0 * (double)tat / (double)bt) : 100;
+    ralentizacion.agregar(slowdown);
+}
+
+void AgregadorMetricas::reiniciar() {
+    espera.reiniciar();
+    respuesta.reiniciar();
+    retorno.reiniciar();
+    ralentizacion.reiniciar();
+    sumaFinalizacion = 0;
+}
+
+void AgregadorMetricas::guardar(EscritorBinario& escritor) const {
+    espera.guardar(escritor);
+    respuesta.guardar(escritor);
+    retorno.guardar(escritor);
+    ralentizacion.guardar(escritor);
+    escritor.escribir(sumaFinalizacion);
+}
+
+bool AgregadorMetricas::cargar(LectorBinario& lector) {
+    espera.cargar(lector);
+    respuesta.cargar(lector);
+    retorno.cargar(lector);
+    ralentizacion.cargar(lector);
+    lector.leer(sumaFinalizacion);
+    return lector.bien();
+}
+
+void AgregadorMetricas::calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const {
+    std::uint64_t cantidad = getCantidad();
+    if (cantidad == 0) {
+        promWT = promCT = promRT = promTAT = 0.0;
+        return;
+    }
+    promWT = (double)espera.getSuma() / cantidad;
+    promCT = (double)sumaFinalizacion / cantidad;
+    promRT = (double)respuesta.getSuma() / cantidad;
+    promTAT = (double)retorno.getSuma() / cantidad;
+}
+
+/*
+  Escribe la tabla de percentiles
+  
+  Una linea por metrica: promedio, p50, p95, p99 y maximo. El slowdown se
+  escribe con dos decimales (se guarda en centesimas).
+ */
+void AgregadorMetricas::escribirPercentiles(std::ostream& salida) const {
+    salida << "# metrica; promedio; p50; p95; p99; max\n";
+    
+    const HistogramaMetrica* histogramas[] = {&espera, &respuesta, &retorno};
+    const char* nombres[] = {"WT", "RT", "TAT"};
+    salida << std::fixed << std::setprecision(1);
+    for (int i = 0; i < 3; i++) {
+        const HistogramaMetrica& h = *histogramas[i];
+        salida << nombres[i] << ";" << h.getPromedio() << ";" << h.percentil(0.50) << ";"
+               << h.percentil(0.95) << ";" << h.percentil(0.99) << ";" << h.getMaximo() << "\n";
+    }
+    
+    salida << std::setprecision(2);
+    salida << "slowdown;" << ralentizacion.getPromedio() / 100 << ";"
+           << ralentizacion.percentil(0.50) / 100.0 << ";" << ralentizacion.percentil(0.95) / 100.0 << ";"
+           << ralentizacion.percentil(0.99) / 100.0 << ";" << ralentizacion.getMaximo() / 100.0 << "\n";
+}
@@ -0,0 +1,98 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include "Binario.h"
+#include "TablaProcesos.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/*
+  Clase HistogramaMetrica
+  
+  Histograma log-lineal de memoria fija para valores enteros no negativos:
+  los valores menores a 128 tienen una cubeta cada uno y despues cada
+  potencia de dos se divide en 64 cubetas, asi que un percentil se reporta
+  con error relativo menor a 1/64 (1.6%) sin guardar los valores. Tambien
+  lleva la cantidad, la suma y el maximo exactos.
+ */
+class HistogramaMetrica {
+private:
+    static constexpr int BITS_EXACTOS = 7;                         // Valores < 128 son exactos
+    static constexpr int SUBCUBETAS = 1 << (BITS_EXACTOS - 1);      // Cubetas por potencia de dos
+    static constexpr int CUBETAS = (1 << BITS_EXACTOS) + (64 - BITS_EXACTOS) * SUBCUBETAS;
+    
+    std::vector<std::uint64_t> conteo;     // Una entrada por cubeta (tamano fijo)
+    std::uint64_t cantidad;
+    long long suma;
+    long long maximo;
+    
+    // Cubeta de un valor y rango de valores de una cubeta
+    static int indice(std::uint64_t valor);
+    static std::uint64_t limiteSuperior(int cubeta);
+
+public:
+    HistogramaMetrica();
+    
+    void agregar(long long valor);
+    void reiniciar();
+    
+    // Checkpoint del histograma completo
+    void guardar(EscritorBinario& escritor) const;
+    bool cargar(LectorBinario& lector);
+    
+    std::uint64_t getCantidad() const { return cantidad; }
+    long long getSuma() const { return suma; }
+    long long getMaximo() const { return maximo; }
+    double getPromedio() const { return cantidad > 0 ? (double)suma / cantidad : 0.0; }
+    
+    // Valor en el percentil p (0 < p <= 1) por rango cercano; se reporta
+    // el limite superior de su cubeta, sin pasar del maximo
+    long long percentil(double p) const;
+};
+
+/*
+  Clase AgregadorMetricas
+  
+  Acumula las metricas de los procesos a medida que terminan, sin
+  recorrerlos despues: promedios exactos de WT, CT, RT y TAT, y
+  histogramas de WT, RT, TAT y slowdown (TAT/BT) para los percentiles.
+  El slowdown se guarda en centesimas.
+ */
+class AgregadorMetricas {
+private:
+    HistogramaMetrica espera;
+    HistogramaMetrica respuesta;
+    HistogramaMetrica retorno;
+    HistogramaMetrica ralentizacion;       // Slowdown x 100
+    long long sumaFinalizacion;            // Solo se necesita el promedio de CT
+
+public:
+    AgregadorMetricas();
+    
+    // Registra un proceso terminado (long long para los tiempos en
+    // microsegundos de EjecutorTareas, que no caben en un int)
+    void agregar(long long bt, long long wt, long long ct, long long rt, long long tat);
+    
+    // Registra un proceso de la tabla que ya tiene su tiempo de finalizacion
+    void agregar(const TablaProcesos& tabla, IdProceso id) {
+        agregar(tabla.getTiempoRafaga(id), tabla.getTiempoEspera(id), tabla.getTiempoFinalizacion(id),
+                tabla.getTiempoRespuesta(id), tabla.getTiempoRetorno(id));
+    }
+    void reiniciar();
+    
+    // Checkpoint de las sumas y los histogramas
+    void guardar(EscritorBinario& escritor) const;
+    bool cargar(LectorBinario& lector);
+    
+    std::uint64_t getCantidad() const { return retorno.getCantidad(); }
+    
+    // Promedios (0 si no hay procesos)
+    void calcularPromedios(double& promWT, double& promCT, double& promRT, double& promTAT) const;
+    
+    // Tabla de promedio, p50, p95, p99 y maximo de WT, RT, TAT y slowdown
+    void escribirPercentiles(std::ostream& salida) const;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include "ModoLote.h"
+#include "MLFQScheduler.h"
+#include "MLFQEstatico.h"
+#include "LectorTrazas.h"
+#include "Esquemas.h"
+#include "ArchivosSalida.h"
+#include "PoolHilos.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// Resultado de una simulacion del lote
+struct ResultadoLote {
+    std::string archivo;        // Archivo de entrada
+    int esquema;                // Numero de esquema
+    std::string salida;         // Archivo de salida escrito
+    std::size_t procesos;       // Procesos simulados
+    int tiempoTotal;            // Tiempo final de la simulacion
+    double promWT, promCT, promRT, promTAT;
+    bool ok;                    // false si la simulacion fallo
+    std::string error;          // Mensaje si fallo
+};
+
+// Simula los registros con el scheduler dado y llena el resultado
+template <typename Scheduler>
+void simular(Scheduler& scheduler, const std::vector<RegistroProceso>& registros, ResultadoLote& resultado) {
+    scheduler.agregarProcesos(registros);
+    scheduler.ejecutarSimulacion();
+    scheduler.escribirSalida(resultado.salida);
+    
+    resultado.procesos = scheduler.getProcesosFinalizados().size();
+    resultado.tiempoTotal = scheduler.getTiempoGlobal();
+    scheduler.calcularPromedios(resultado.promWT, resultado.promCT, resultado.promRT, resultado.promTAT);
+}
+
+// Lista los archivos .txt del directorio, ordenados por nombre
+std::vector<std::string> listarEntradas(const std::string& directorio) {
+    std::vector<std::string> archivos;
+    std::error_code error;
+    
+    for (const auto& entrada : std::filesystem::directory_iterator(directorio, error)) {
+        if (entrada.is_regular_file() && entrada.path().extension() == ".txt") {
+            archivos.push_back(entrada.path().string());
+        }
+    }
+    std::sort(archivos.begin(), archivos.end());
+    return archivos;
+}
+
+// Escribe la tabla de resumen en el flujo dado
+void escribirResumen(std::ostream& salida, const std::vector<ResultadoLote>& resultados) {
+    salida << "# archivo; esquema; procesos; tiempo; WT; CT; RT; TAT\n";
+    salida << std::fixed << std::setprecision(1);
+    
+    for (const ResultadoLote& r : resultados) {
+        salida << r.archivo << ";" << r.esquema << ";";
+        if (r.ok) {
+            salida << r.procesos << ";" << r.tiempoTotal << ";"
+                   << r.promWT << ";" << r.promCT << ";" << r.promRT << ";" << r.promTAT << "\n";
+        } else {
+            salida << "ERROR: " << r.error << "\n";
+        }
+    }
+}
+
+}
+
+/*
+  Ejecuta el modo lote
+  
+  1. Lista las entradas y arma la configuracion de cada esquema.
+  2. Parsea cada archivo una sola vez (en paralelo, un trabajo por archivo).
+  3. Encola un trabajo por cada par (archivo, esquema); cada uno usa su
+     propio scheduler sin salida por pantalla y escribe su salida al terminar.
+  4. Espera a todos y escribe el resumen.
+ */
+int ejecutarLote(const std::string& directorio, const std::vector<int>& numerosEsquema,
+                 std::size_t hilos) {
+    std::vector<std::string> archivos = listarEntradas(directorio);
+    if (archivos.empty()) {
+        std::cerr << "Error: No hay archivos .txt en " << directorio << std::endl;
+        return 1;
+    }
+    
+    // Configuracion de cada esquema (se arma una vez y se comparte)
+    std::vector<std::vector<EsquemaCola>> esquemas;
+    for (int numero : numerosEsquema) {
+        esquemas.push_back(obtenerEsquema(numero));
+        if (esquemas.back().empty()) {
+            return 1;
+        }
+    }
+    
+    crearCarpetaSalida();
+    PoolHilos pool(hilos);
+    std::cout << "Modo lote: " << archivos.size() << " archivos x " << esquemas.size()
+              << " esquemas en " << pool.getCantidadHilos() << " hilos" << std::endl;
+    
+    // Parsear cada archivo una sola vez
+    std::vector<std::unique_ptr<ArchivoTrazas>> cargas(archivos.size());
+    std::vector<char> cargado(archivos.size(), 0);
+    for (std::size_t i = 0; i < archivos.size(); i++) {
+        cargas[i].reset(new ArchivoTrazas());
+        pool.encolar([&, i] {
+            cargado[i] = cargas[i]->cargar(archivos[i], 1);
+        });
+    }
+    pool.esperar();
+    
+    // Un trabajo por cada par (archivo, esquema)
+    std::vector<ResultadoLote> resultados(archivos.size() * esquemas.size());
+    std::mutex mutexPantalla;
+    
+    for (std::size_t i = 0; i < archivos.size(); i++) {
+        for (std::size_t e = 0; e < esquemas.size(); e++) {
+            ResultadoLote& resultado = resultados[i * esquemas.size() + e];
+            resultado.archivo = archivos[i];
+            resultado.esquema = numerosEsquema[e];
+            resultado.salida = nombreArchivoSalida(archivos[i], esquemas.size() > 1
+                                                   ? "_e" + std::to_string(numerosEsquema[e]) : "");
+            resultado.ok = false;
+            
+            pool.encolar([&, i, e] {
+                if (!cargado[i] || cargas[i]->getRegistros().empty()) {
+                    resultado.error = "no se pudieron cargar procesos";
+                    return;
+                }
+                
+                try {
+                    // Los esquemas predefinidos usan su version compilada, que
+                    // no modela E/S (con rafagas de E/S va el de tiempo de ejecucion)
+                    const std::vector<RegistroProceso>& registros = cargas[i]->getRegistros();
+                    switch (cargas[i]->tieneRafagasES() ? 0 : numerosEsquema[e]) {
+                        case 1: { MLFQEsquema1 scheduler; simular(scheduler, registros, resultado); break; }
+                        case 2: { MLFQEsquema2 scheduler; simular(scheduler, registros, resultado); break; }
+                        case 3: { MLFQEsquema3 scheduler; simular(scheduler, registros, resultado); break; }
+                        default: {
+                            MLFQScheduler scheduler(esquemas[e]);
+                            scheduler.setVerbosidad(Verbosidad::NINGUNA);
+                            simular(scheduler, registros, resultado);
+                            break;
+                        }
+                    }
+                    resultado.ok = true;
+                } catch (const std::exception& ex) {
+                    resultado.error = ex.what();
+                }
+                
+                std::lock_guard<std::mutex> lock(mutexPantalla);
+                std::cout << (resultado.ok ? "Terminado: " : "Fallo: ") << resultado.archivo
+                          << " (esquema " << resultado.esquema << ") -> " << resultado.salida << std::endl;
+            });
+        }
+    }
+    pool.esperar();
+    
+    // Resumen combinado
+    std::string rutaResumen = "output/resumen_lote.txt";
+    std::ofstream archivoResumen(rutaResumen);
+    if (archivoResumen.is_open()) {
+        escribirResumen(archivoResumen, resultados);
+    } else {
+        std::cerr << "Error al abrir el archivo de salida: " << rutaResumen << std::endl;
+    }
+    
+    std::cout << "\n=== RESUMEN DEL LOTE ===" << std::endl;
+    escribirResumen(std::cout, resultados);
+    std::cout << "Resumen guardado en: " << rutaResumen << std::endl;
+    
+    bool todoOk = std::all_of(resultados.begin(), resultados.end(),
+                              [](const ResultadoLote& r) { return r.ok; });
+    return todoOk ? 0 : 1;
+}
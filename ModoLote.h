@@ -0,0 +1,27 @@
+#ifndef MODOLOTE_H
+#define MODOLOTE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+  Modo lote
+  
+  Corre cada archivo .txt de un directorio contra cada esquema pedido.
+  Cada archivo se parsea una sola vez y sus registros se comparten (solo
+  lectura) entre todas las simulaciones que lo usan. Cada par
+  (archivo, esquema) es un trabajo independiente con su propio
+  MLFQScheduler, y los trabajos se reparten en un pool de hilos de tamano
+  fijo.
+  
+  Cada trabajo escribe su archivo output/<nombre>_out.txt al terminar (con
+  sufijo _e<esquema> si se piden varios esquemas) y al final se escribe
+  output/resumen_lote.txt con una fila de promedios por trabajo.
+  
+  Retorna el codigo de salida del programa (0 si todo salio bien).
+ */
+int ejecutarLote(const std::string& directorio, const std::vector<int>& numerosEsquema,
+                 std::size_t hilos = 0);
+
+#endif
@@ -0,0 +1,269 @@
+#include "OrdenExterno.h"
+#include "Binario.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <queue>
+
+namespace {
+
+// Buffer de lectura (o escritura) de cada corrida durante la mezcla. Con
+// poca memoria se achica, pero no por debajo del minimo
+const std::size_t BUFFER_CORRIDA = 64 * 1024;
+const std::size_t BUFFER_MINIMO = 4 * 1024;
+
+// Corridas que se mezclan a la vez como mucho; cada una tiene su archivo
+// abierto y su buffer
+const std::size_t MAX_CORRIDAS_MEZCLA = 64;
+
+// Lineas o claves mas largas que esto indican una corrida danada
+const std::uint32_t MAX_LARGO_LINEA = 1 << 24;
+
+// Posicion de lectura en una corrida
+struct Cursor {
+    std::vector<char> buffer;
+    std::ifstream archivo;
+    std::string clave;
+    std::string linea;
+    
+    Cursor(const std::string& ruta, std::size_t largoBuffer) : buffer(largoBuffer) {
+        archivo.rdbuf()->pubsetbuf(buffer.data(), (std::streamsize)buffer.size());
+        archivo.open(ruta, std::ios::binary);
+        if (!archivo.is_open()) {
+            archivo.setstate(std::ios::badbit);
+        }
+    }
+    
+    // Lee la siguiente linea; false al terminar la corrida o si falla
+    bool avanzar() {
+        LectorBinario entrada(archivo);
+        std::uint32_t largoClave = 0, largoLinea = 0;
+        if (!entrada.leer(largoClave)) {
+            // Al final de la corrida no queda ningun byte
+            if (archivo.gcount() != 0) {
+                archivo.setstate(std::ios::badbit);
+            }
+            return false;
+        }
+        if (!entrada.leer(largoLinea) || largoClave > MAX_LARGO_LINEA || largoLinea > MAX_LARGO_LINEA) {
+            archivo.setstate(std::ios::badbit);
+            return false;
+        }
+        clave.resize(largoClave);
+        linea.resize(largoLinea);
+        if (!archivo.read(clave.data(), largoClave) || !archivo.read(linea.data(), largoLinea)) {
+            archivo.setstate(std::ios::badbit);
+            return false;
+        }
+        return true;
+    }
+};
+
+/*
+  Mezcla las corridas [desde, hasta) de 'rutas' y pasa cada linea, en
+  orden, a escribir(clave, linea). El heap guarda el indice de cada
+  corrida con linea pendiente y saca la de menor clave (a igual clave, la
+  de menor indice). Retorna false si alguna corrida no se pudo leer.
+ */
+template <typename Escribir>
+bool mezclar(const std::vector<std::string>& rutas, std::size_t desde, std::size_t hasta,
+             std::size_t largoBuffer, Escribir escribir) {
+    std::vector<std::unique_ptr<Cursor>> cursores;
+    for (std::size_t i = desde; i < hasta; i++) {
+        cursores.push_back(std::make_unique<Cursor>(rutas[i], largoBuffer));
+    }
+    
+    auto despues = [&cursores](std::size_t a, std::size_t b) {
+        int comparacion = cursores[a]->clave.compare(cursores[b]->clave);
+        return comparacion != 0 ? comparacion > 0 : a > b;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(despues)> heap(despues);
+    for (std::size_t i = 0; i < cursores.size(); i++) {
+        if (cursores[i]->avanzar()) {
+            heap.push(i);
+        }
+    }
+    
+    while (!heap.empty()) {
+        std::size_t i = heap.top();
+        heap.pop();
+        escribir(cursores[i]->clave, cursores[i]->linea);
+        if (cursores[i]->avanzar()) {
+            heap.push(i);
+        }
+    }
+    
+    for (const std::unique_ptr<Cursor>& cursor : cursores) {
+        if (cursor->archivo.bad()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+/*
+  Constructor
+  
+  El prefijo de los temporales lleva la direccion del ordenador y la
+  hora, asi dos ordenadores (o dos procesos) no comparten archivos.
+ */
+OrdenadorExterno::OrdenadorExterno(std::size_t memoriaMaxima, const std::string& carpetaTemporal)
+    : memoriaMaxima(std::max<std::size_t>(memoriaMaxima, 1)), numeroCorrida(0), lineas(0) {
+    std::error_code codigo;
+    std::filesystem::path carpeta = carpetaTemporal.empty()
+                                  ? std::filesystem::temp_directory_path(codigo)
+                                  : std::filesystem::path(carpetaTemporal);
+    long long marca = std::chrono::steady_clock::now().time_since_epoch().count();
+    prefijo = (carpeta / ("mlfq_orden_" + std::to_string((std::uintptr_t)this) + "_" +
+                          std::to_string(marca) + "_")).string();
+}
+
+OrdenadorExterno::~OrdenadorExterno() {
+    borrarCorridas();
+}
+
+void OrdenadorExterno::borrarCorridas() {
+    for (const std::string& ruta : corridas) {
+        std::remove(ruta.c_str());
+    }
+    corridas.clear();
+}
+
+void OrdenadorExterno::agregar(std::string_view clave, std::string_view linea) {
+    entradas.push_back(Entrada{datos.size(), (std::uint32_t)clave.size(), (std::uint32_t)linea.size()});
+    datos.insert(datos.end(), clave.begin(), clave.end());
+    datos.insert(datos.end(), linea.begin(), linea.end());
+    lineas++;
+    if (datos.size() + entradas.size() * sizeof(Entrada) >= memoriaMaxima) {
+        volcarCorrida();
+    }
+}
+
+void OrdenadorExterno::ordenarEntradas() {
+    std::stable_sort(entradas.begin(), entradas.end(),
+                     [this](const Entrada& a, const Entrada& b) { return getClave(a) < getClave(b); });
+}
+
+/*
+  Vuelca una corrida
+  
+  Cada linea queda como largo de la clave, largo de la linea, la clave y
+  la linea. Si el archivo no se puede escribir las lineas se pierden y
+  terminar() avisa el error.
+ */
+void OrdenadorExterno::volcarCorrida() {
+    if (entradas.empty()) {
+        return;
+    }
+    ordenarEntradas();
+    
+    std::string ruta = prefijo + std::to_string(numeroCorrida++) + ".tmp";
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    corridas.push_back(ruta);
+    {
+        EscritorBinario salida(archivo);
+        for (const Entrada& e : entradas) {
+            salida.escribir(e.largoClave);
+            salida.escribir(e.largoLinea);
+            archivo.write(datos.data() + e.inicio, (std::streamsize)(e.largoClave + e.largoLinea));
+        }
+    }
+    archivo.flush();
+    if (!archivo && error.empty()) {
+        error = "no se pudo escribir la corrida " + ruta;
+    }
+    
+    datos.clear();
+    entradas.clear();
+}
+
+/*
+  Escribe las lineas ordenadas
+  
+  Sin corridas, ordena en memoria y escribe. Con corridas, vuelca lo que
+  quede como la ultima y las mezcla. Cada corrida abierta ocupa un archivo
+  y un buffer, asi que se mezclan de a lo sumo 'grupo' a la vez (las que
+  entran en memoriaMaxima, contando el buffer de la corrida que se
+  escribe, y nunca mas de MAX_CORRIDAS_MEZCLA): mientras haya mas, cada
+  grupo de corridas seguidas se mezcla en una corrida nueva y se borra.
+  Como los grupos conservan el orden de las corridas, a igual clave las
+  lineas siguen saliendo en el orden en que se agregaron.
+ */
+bool OrdenadorExterno::terminar(EscritorTexto& salida) {
+    if (corridas.empty()) {
+        ordenarEntradas();
+        for (const Entrada& e : entradas) {
+            salida.texto(getLinea(e));
+        }
+        datos.clear();
+        entradas.clear();
+        return error.empty();
+    }
+    
+    volcarCorrida();
+    // La memoria de las entradas ya no se usa: queda para los buffers
+    std::vector<char>().swap(datos);
+    std::vector<Entrada>().swap(entradas);
+    
+    std::size_t grupo = std::clamp<std::size_t>(memoriaMaxima / BUFFER_CORRIDA, 3, MAX_CORRIDAS_MEZCLA + 1) - 1;
+    std::size_t largoBuffer = std::clamp(memoriaMaxima / (grupo + 1), BUFFER_MINIMO, BUFFER_CORRIDA);
+    
+    while (corridas.size() > grupo && error.empty()) {
+        std::vector<std::string> mezcladas;
+        for (std::size_t desde = 0; desde < corridas.size() && error.empty(); desde += grupo) {
+            std::size_t hasta = std::min(desde + grupo, corridas.size());
+            if (hasta - desde == 1) {
+                mezcladas.push_back(corridas[desde]);
+                corridas[desde].clear();
+                continue;
+            }
+            
+            std::string ruta = prefijo + std::to_string(numeroCorrida++) + ".tmp";
+            std::vector<char> buffer(largoBuffer);
+            std::ofstream archivo;
+            archivo.rdbuf()->pubsetbuf(buffer.data(), (std::streamsize)buffer.size());
+            archivo.open(ruta, std::ios::binary | std::ios::trunc);
+            mezcladas.push_back(ruta);
+            EscritorBinario escritor(archivo);
+            bool leidas = mezclar(corridas, desde, hasta, largoBuffer,
+                                  [&](const std::string& clave, const std::string& linea) {
+                escritor.escribir((std::uint32_t)clave.size());
+                escritor.escribir((std::uint32_t)linea.size());
+                archivo.write(clave.data(), (std::streamsize)clave.size());
+                archivo.write(linea.data(), (std::streamsize)linea.size());
+            });
+            archivo.close();
+            if (!leidas) {
+                error = "no se pudo leer una corrida";
+            } else if (archivo.fail()) {
+                error = "no se pudo escribir la corrida " + ruta;
+            }
+            
+            for (std::size_t i = desde; i < hasta; i++) {
+                std::remove(corridas[i].c_str());
+                corridas[i].clear();
+            }
+        }
+        // Lo que no se llego a mezclar (si hubo un error) se borra igual
+        for (const std::string& ruta : corridas) {
+            if (!ruta.empty()) {
+                mezcladas.push_back(ruta);
+            }
+        }
+        corridas = std::move(mezcladas);
+    }
+    
+    if (error.empty() && !mezclar(corridas, 0, corridas.size(), largoBuffer,
+                                  [&salida](const std::string&, const std::string& linea) {
+        salida.texto(linea);
+    })) {
+        error = "no se pudo leer una corrida";
+    }
+    borrarCorridas();
+    return error.empty();
+}
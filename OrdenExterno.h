@@ -0,0 +1,80 @@
+#ifndef ORDENEXTERNO_H
+#define ORDENEXTERNO_H
+
+#include "EscritorTexto.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+  Clase OrdenadorExterno
+  
+  Ordena lineas de texto por una clave (la etiqueta en el archivo de
+  salida) sin tenerlas todas en memoria. Las lineas se juntan hasta
+  'memoriaMaxima' bytes; al llenarse se ordenan y se vuelcan a un
+  archivo temporal (una corrida). terminar() mezcla las corridas con un
+  heap de una entrada por corrida y escribe el resultado; si son mas de
+  las que entran a la vez en 'memoriaMaxima' (o mas de 64), las mezcla
+  por grupos en varias pasadas. Si todo cupo en memoria no se crea
+  ningun archivo.
+  
+  Las lineas con la misma clave salen en el orden en que se agregaron:
+  cada corrida se ordena de forma estable y, en la mezcla, a igual clave
+  gana la corrida anterior. Los temporales se borran al terminar (o al
+  destruir el ordenador si no se llego a terminar).
+ */
+class OrdenadorExterno {
+private:
+    // Una linea en memoria: clave y linea van seguidas en 'datos'
+    struct Entrada {
+        std::uint64_t inicio;
+        std::uint32_t largoClave;
+        std::uint32_t largoLinea;
+    };
+    
+    std::size_t memoriaMaxima;
+    std::string prefijo;                // Ruta de los temporales sin el numero de corrida
+    std::vector<char> datos;
+    std::vector<Entrada> entradas;
+    std::vector<std::string> corridas;  // Temporales ya escritos, en orden
+    std::size_t numeroCorrida;          // Numero del proximo temporal
+    std::uint64_t lineas;
+    std::string error;
+    
+    std::string_view getClave(const Entrada& e) const {
+        return std::string_view(datos.data() + e.inicio, e.largoClave);
+    }
+    std::string_view getLinea(const Entrada& e) const {
+        return std::string_view(datos.data() + e.inicio + e.largoClave, e.largoLinea);
+    }
+    
+    // Ordena lo que hay en memoria (estable, por clave)
+    void ordenarEntradas();
+    
+    // Escribe lo que hay en memoria como una corrida nueva y lo descarta
+    void volcarCorrida();
+    
+    void borrarCorridas();
+
+public:
+    // Sin carpeta, los temporales van a la carpeta temporal del sistema
+    explicit OrdenadorExterno(std::size_t memoriaMaxima, const std::string& carpetaTemporal = "");
+    ~OrdenadorExterno();
+    
+    OrdenadorExterno(const OrdenadorExterno&) = delete;
+    OrdenadorExterno& operator=(const OrdenadorExterno&) = delete;
+    
+    void agregar(std::string_view clave, std::string_view linea);
+    
+    // Escribe todas las lineas ordenadas. Retorna false (con getError())
+    // si no se pudo escribir o leer una corrida
+    bool terminar(EscritorTexto& salida);
+    
+    std::uint64_t getLineas() const { return lineas; }
+    std::size_t getCorridas() const { return corridas.size(); }
+    const std::string& getError() const { return error; }
+};
+
+#endif
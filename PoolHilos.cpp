@@ -0,0 +1,82 @@
+#include "PoolHilos.h"
+#include <algorithm>
+
+/*
+  Constructor
+  
+  Crea los hilos trabajadores. Si no se indica cantidad se usa la que
+  reporta el sistema (al menos uno).
+ */
+PoolHilos::PoolHilos(std::size_t hilos) : enEjecucion(0), cerrando(false) {
+    if (hilos == 0) {
+        hilos = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    trabajadores.reserve(hilos);
+    for (std::size_t i = 0; i < hilos; i++) {
+        trabajadores.emplace_back(&PoolHilos::trabajar, this);
+    }
+}
+
+/*
+  Destructor
+  
+  Deja terminar los trabajos que ya estaban en la cola y luego
+  despierta a todos los hilos para que salgan.
+ */
+PoolHilos::~PoolHilos() {
+    esperar();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        cerrando = true;
+    }
+    hayTrabajo.notify_all();
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+void PoolHilos::encolar(std::function<void()> trabajo) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        trabajos.push(std::move(trabajo));
+    }
+    hayTrabajo.notify_one();
+}
+
+void PoolHilos::esperar() {
+    std::unique_lock<std::mutex> lock(mutex);
+    terminado.wait(lock, [this] { return trabajos.empty() && enEjecucion == 0; });
+}
+
+/*
+  Bucle de un hilo trabajador
+  
+  Saca trabajos de la cola y los ejecuta fuera del mutex. Cuando la cola
+  queda vacia y no hay nada ejecutandose avisa a quien este en esperar().
+ */
+void PoolHilos::trabajar() {
+    while (true) {
+        std::function<void()> trabajo;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hayTrabajo.wait(lock, [this] { return cerrando || !trabajos.empty(); });
+            if (trabajos.empty()) {
+                return;
+            }
+            trabajo = std::move(trabajos.front());
+            trabajos.pop();
+            enEjecucion++;
+        }
+        
+        trabajo();
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            enEjecucion--;
+            if (trabajos.empty() && enEjecucion == 0) {
+                terminado.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef POOLHILOS_H
+#define POOLHILOS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/*
+  Clase PoolHilos
+  
+  Pool de hilos de tamano fijo. Los trabajos se encolan como funciones y
+  los hilos trabajadores los van sacando en orden FIFO. esperar() bloquea
+  hasta que la cola este vacia y ningun trabajo se este ejecutando.
+  
+  Los trabajos no deben lanzar excepciones; si necesitan reportar un error
+  deben guardarlo en su propio resultado.
+ */
+class PoolHilos {
+private:
+    std::vector<std::thread> trabajadores;        // Hilos del pool
+    std::queue<std::function<void()>> trabajos;   // Trabajos pendientes
+    std::mutex mutex;                             // Protege la cola y los contadores
+    std::condition_variable hayTrabajo;           // Avisa a los trabajadores
+    std::condition_variable terminado;            // Avisa a quien espera en esperar()
+    std::size_t enEjecucion;                      // Trabajos que se estan ejecutando
+    bool cerrando;                                // true cuando el pool se destruye
+    
+    // Bucle de cada hilo trabajador
+    void trabajar();
+
+public:
+    // Crea el pool; hilos = 0 usa un hilo por nucleo
+    explicit PoolHilos(std::size_t hilos = 0);
+    
+    // Espera los trabajos pendientes y detiene los hilos
+    ~PoolHilos();
+    
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+    
+    // Agrega un trabajo a la cola
+    void encolar(std::function<void()> trabajo);
+    
+    // Bloquea hasta que todos los trabajos encolados terminen
+    void esperar();
+    
+    std::size_t getCantidadHilos() const { return trabajadores.size(); }
+};
+
+#endif
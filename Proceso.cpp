@@ -1,18 +1,25 @@
 #include "Proceso.h"
-#include <sstream>
+#include "EscritorTexto.h"
+#include <algorithm>
 
 /*
   Constructor del proceso
   
   Inicializa el proceso con la informacion que viene del archivo de entrada.
-  El tiempo restante empieza igual al tiempo de rafaga total.
+  El tiempo restante empieza igual a la primera rafaga de CPU y el tiempo
+  de rafaga es la suma de todas (con las de los pares E/S,CPU).
   Las metricas se inicializan en 0 porque se calculan durante la simulacion.
   haIniciado se pone en false porque aun no ha ejecutado.
  */
-Proceso::Proceso(std::string etiq, int bt, int at, int q, int pr) 
+Proceso::Proceso(std::string etiq, int bt, int at, int q, int pr, std::vector<int> rafagas) 
     : etiqueta(etiq), tiempoRafaga(bt), tiempoLlegada(at), cola(q), colaOriginal(q), prioridad(pr),
+      rafagasES(std::move(rafagas)), primeraRafaga(bt), tiempoES(0),
       tiempoEspera(0), tiempoFinalizacion(0), tiempoRespuesta(0), tiempoRetorno(0),
       tiempoRestante(bt), tiempoInicio(-1), haIniciado(false) {
+    for (std::size_t i = 0; i + 1 < rafagasES.size(); i += 2) {
+        tiempoES += rafagasES[i];
+        tiempoRafaga += rafagasES[i + 1];
+    }
 }
 
 /*
@@ -23,6 +30,19 @@ Proceso::Proceso(std::string etiq, int bt, int at, int q, int pr)
   uso la CPU por una unidad de tiempo.
  */
 void Proceso::ejecutar(int tiempoActual) {
+    ejecutar(tiempoActual, 1);
+}
+
+/*
+  Ejecuta el proceso por una rebanada de varias unidades de tiempo
+  
+  Es equivalente a llamar ejecutar() una vez por cada unidad, pero en O(1):
+  el tiempo de inicio solo se marca en la primera unidad y el tiempo
+  restante se descuenta de una sola vez (sin bajar de 0).
+ */
+void Proceso::ejecutar(int tiempoActual, int unidades) {
+    if (unidades <= 0) return;
+    
     // Si es la primera vez que ejecuta, guardar cuando empezo
     if (!haIniciado) {
         tiempoInicio = tiempoActual;
@@ -30,9 +50,7 @@ void Proceso::ejecutar(int tiempoActual) {
     }
     
     // Reducir el tiempo que le falta por ejecutar
-    if (tiempoRestante > 0) {
-        tiempoRestante--;
-    }
+    tiempoRestante -= std::min(unidades, tiempoRestante);
 }
 
 /*
@@ -42,6 +60,7 @@ void Proceso::ejecutar(int tiempoActual) {
   - Tiempo de retorno = cuando termino - cuando llego
   - Tiempo de respuesta = cuando empezo a ejecutar - cuando llego
   - Tiempo de espera = tiempo de retorno - tiempo que realmente ejecuto
+    - tiempo bloqueado en E/S
  */
 void Proceso::calcularMetricas() {
     // Cuanto tiempo total estuvo en el sistema
@@ -50,8 +69,8 @@ void Proceso::calcularMetricas() {
     // Cuanto espero antes de ejecutar por primera vez
     tiempoRespuesta = tiempoInicio - tiempoLlegada;
     
-    // Cuanto tiempo paso esperando en colas (no ejecutando)
-    tiempoEspera = tiempoRetorno - tiempoRafaga;
+    // Cuanto tiempo paso esperando en colas (no ejecutando ni en E/S)
+    tiempoEspera = tiempoRetorno - tiempoRafaga - tiempoES;
 }
 
 /*
@@ -82,15 +101,23 @@ void Proceso::mostrarInfo() const {
   de salida debe ser 1-indexed.
  */
 std::string Proceso::toString() const {
-    std::ostringstream oss;
-    oss << etiqueta << ";"
-        << tiempoRafaga << ";"
-        << tiempoLlegada << ";"
-        << (cola + 1) << ";"  // Convertir a 1-indexed para el archivo
-        << prioridad << ";"
-        << tiempoEspera << ";"
-        << tiempoFinalizacion << ";"
-        << tiempoRespuesta << ";"
-        << tiempoRetorno;
-    return oss.str();
+    EscritorTexto linea(nullptr, 64);
+    linea.texto(etiqueta);
+    linea.caracter(';');
+    linea.entero(tiempoRafaga);
+    linea.caracter(';');
+    linea.entero(tiempoLlegada);
+    linea.caracter(';');
+    linea.entero(cola + 1);  // Convertir a 1-indexed para el archivo
+    linea.caracter(';');
+    linea.entero(prioridad);
+    linea.caracter(';');
+    linea.entero(tiempoEspera);
+    linea.caracter(';');
+    linea.entero(tiempoFinalizacion);
+    linea.caracter(';');
+    linea.entero(tiempoRespuesta);
+    linea.caracter(';');
+    linea.entero(tiempoRetorno);
+    return std::string(linea.contenido());
 }
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 /*
   Clase Proceso
@@ -14,6 +15,10 @@
   La clase maneja el estado del proceso durante toda su vida util en el sistema,
   desde que llega hasta que termina, calculando automaticamente las metricas
   de rendimiento necesarias para el analisis del scheduler.
+  
+  Un proceso puede alternar CPU y E/S: despues de la primera rafaga de CPU
+  vienen pares E/S,CPU. El tiempo de rafaga es el total de CPU y el
+  tiempo bloqueado en E/S no cuenta como espera.
  */
 class Proceso {
 private:
@@ -24,6 +29,9 @@ private:
     int cola;                      // Cola actual (0-indexed internamente)
     int colaOriginal;              // Cola donde empezo (para reportes)
     int prioridad;                 // Valor de prioridad del proceso
+    std::vector<int> rafagasES;    // Pares E/S,CPU despues de la primera rafaga
+    int primeraRafaga;             // CPU antes de la primera E/S
+    int tiempoES;                  // Total de E/S
     
     // Metricas calculadas al final
     int tiempoEspera;              // Tiempo esperando en colas
@@ -38,7 +46,8 @@ private:
 
 public:
     // Constructor que inicializa el proceso con sus datos basicos
-    Proceso(std::string etiq, int bt, int at, int q, int pr);
+    // (bt es la primera rafaga de CPU; rafagas son los pares E/S,CPU que siguen)
+    Proceso(std::string etiq, int bt, int at, int q, int pr, std::vector<int> rafagas = std::vector<int>());
     
     // Getters para acceder a los datos sin modificarlos
     std::string getEtiqueta() const { return etiqueta; }
@@ -47,6 +56,9 @@ public:
     int getCola() const { return cola; }
     int getColaOriginal() const { return colaOriginal; }
     int getPrioridad() const { return prioridad; }
+    int getPrimeraRafaga() const { return primeraRafaga; }
+    const std::vector<int>& getRafagasES() const { return rafagasES; }
+    int getTiempoES() const { return tiempoES; }
     int getTiempoEspera() const { return tiempoEspera; }
     int getTiempoFinalizacion() const { return tiempoFinalizacion; }
     int getTiempoRespuesta() const { return tiempoRespuesta; }
@@ -67,6 +79,9 @@ public:
     // Simula la ejecucion del proceso por una unidad de tiempo
     void ejecutar(int tiempoActual);
     
+    // Simula la ejecucion de una rebanada completa de varias unidades
+    void ejecutar(int tiempoActual, int unidades);
+    
     // Calcula las metricas finales cuando el proceso termina
     void calcularMetricas();
     
@@ -0,0 +1,143 @@
+#include "Replicas.h"
+#include "MLFQScheduler.h"
+#include "Esquemas.h"
+#include "PoolHilos.h"
+#include <cmath>
+#include <iomanip>
+
+/*
+  Cuantil 0.975 de la t de Student
+  
+  Hasta 30 grados de libertad se usa la tabla; despues, la expansion de
+  Cornish-Fisher alrededor del cuantil normal, que a partir de ahi tiene
+  error menor a 0.001.
+ */
+static double cuantilT975(std::size_t gradosLibertad) {
+    static const double TABLA[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (gradosLibertad == 0) {
+        return 0.0;
+    }
+    if (gradosLibertad <= 30) {
+        return TABLA[gradosLibertad - 1];
+    }
+    double z = 1.959964;
+    double n = (double)gradosLibertad;
+    return z + (z * z * z + z) / (4 * n) + (5 * std::pow(z, 5) + 16 * z * z * z + 3 * z) / (96 * n * n);
+}
+
+/*
+  Media e intervalo de confianza del 95%
+  
+  Radio = t(0.975, n-1) * s / sqrt(n), con la desviacion muestral s.
+  Con una sola replica no hay varianza que estimar y el radio es 0.
+ */
+IntervaloConfianza intervaloConfianza(const std::vector<double>& valores) {
+    IntervaloConfianza intervalo{0.0, 0.0};
+    std::size_t n = valores.size();
+    if (n == 0) {
+        return intervalo;
+    }
+    
+    double suma = 0.0;
+    for (double v : valores) suma += v;
+    intervalo.media = suma / n;
+    if (n < 2) {
+        return intervalo;
+    }
+    
+    double cuadrados = 0.0;
+    for (double v : valores) cuadrados += (v - intervalo.media) * (v - intervalo.media);
+    double desviacion = std::sqrt(cuadrados / (n - 1));
+    intervalo.radio = cuantilT975(n - 1) * desviacion / std::sqrt((double)n);
+    return intervalo;
+}
+
+std::vector<ResumenEsquema> ejecutarReplicas(const ConfiguracionReplicas& config) {
+    // Configuracion de cada esquema (se arma una vez y se comparte)
+    std::vector<std::vector<EsquemaCola>> esquemas;
+    std::vector<ResumenEsquema> resumenes(config.esquemas.size());
+    for (std::size_t e = 0; e < config.esquemas.size(); e++) {
+        esquemas.push_back(obtenerEsquema(config.esquemas[e], false));
+        if (esquemas.back().empty()) {
+            return std::vector<ResumenEsquema>();
+        }
+        resumenes[e].esquema = config.esquemas[e];
+        resumenes[e].replicas.resize(config.replicas);
+    }
+    
+    {
+        PoolHilos pool(config.hilos);
+        for (std::size_t r = 0; r < config.replicas; r++) {
+            pool.encolar([&, r] {
+                ConfiguracionCarga carga = config.carga;
+                carga.semilla = semillaReplica(config.carga.semilla, r);
+                std::string etiquetas;
+                std::vector<RegistroProceso> registros;
+                generarCarga(carga, etiquetas, registros);
+                
+                for (std::size_t e = 0; e < esquemas.size(); e++) {
+                    MLFQScheduler scheduler(esquemas[e]);
+                    scheduler.setVerbosidad(Verbosidad::NINGUNA);
+                    scheduler.agregarProcesos(registros);
+                    scheduler.ejecutarSimulacion();
+                    
+                    ResultadoReplica& resultado = resumenes[e].replicas[r];
+                    double promCT = 0.0;
+                    resultado.semilla = carga.semilla;
+                    resultado.procesos = scheduler.getProcesosFinalizados().size();
+                    resultado.tiempoTotal = scheduler.getTiempoGlobal();
+                    scheduler.calcularPromedios(resultado.promWT, promCT, resultado.promRT, resultado.promTAT);
+                }
+            });
+        }
+        pool.esperar();
+    }
+    
+    for (ResumenEsquema& resumen : resumenes) {
+        std::vector<double> wt, rt, tat;
+        for (const ResultadoReplica& r : resumen.replicas) {
+            wt.push_back(r.promWT);
+            rt.push_back(r.promRT);
+            tat.push_back(r.promTAT);
+        }
+        resumen.wt = intervaloConfianza(wt);
+        resumen.rt = intervaloConfianza(rt);
+        resumen.tat = intervaloConfianza(tat);
+    }
+    return resumenes;
+}
+
+void escribirReplicas(std::ostream& salida, const std::vector<ResumenEsquema>& resumenes) {
+    salida << "# esquema; replica; semilla; procesos; tiempo; WT; RT; TAT\n";
+    salida << std::fixed << std::setprecision(2);
+    for (const ResumenEsquema& resumen : resumenes) {
+        for (std::size_t r = 0; r < resumen.replicas.size(); r++) {
+            const ResultadoReplica& replica = resumen.replicas[r];
+            salida << resumen.esquema << ";" << r + 1 << ";" << replica.semilla << ";"
+                   << replica.procesos << ";" << replica.tiempoTotal << ";"
+                   << replica.promWT << ";" << replica.promRT << ";" << replica.promTAT << "\n";
+        }
+    }
+}
+
+/*
+  Escribe el resumen de cada esquema
+  
+  Cada metrica sale como media, limite inferior y limite superior del
+  intervalo del 95% de la media entre replicas.
+ */
+void escribirResumenReplicas(std::ostream& salida, const std::vector<ResumenEsquema>& resumenes) {
+    salida << "# esquema; replicas; WT; WT inf; WT sup; RT; RT inf; RT sup; TAT; TAT inf; TAT sup\n";
+    salida << std::fixed << std::setprecision(2);
+    for (const ResumenEsquema& resumen : resumenes) {
+        salida << resumen.esquema << ";" << resumen.replicas.size();
+        for (const IntervaloConfianza* i : {&resumen.wt, &resumen.rt, &resumen.tat}) {
+            salida << ";" << i->media << ";" << i->media - i->radio << ";" << i->media + i->radio;
+        }
+        salida << "\n";
+    }
+}
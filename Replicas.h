@@ -0,0 +1,67 @@
+#ifndef REPLICAS_H
+#define REPLICAS_H
+
+#include "GeneradorCargas.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+  Parametros de las replicas Monte Carlo
+  
+  Cada replica genera una carga nueva con 'carga' (solo cambia la
+  semilla, que sale de semillaReplica(carga.semilla, i)) y la simula con
+  cada esquema de 'esquemas' (numeros o archivos de esquema).
+ */
+struct ConfiguracionReplicas {
+    std::size_t replicas = 30;
+    ConfiguracionCarga carga;
+    std::vector<std::string> esquemas = {"1", "2", "3"};
+    std::size_t hilos = 0;              // 0 = un hilo por nucleo
+};
+
+// Promedios de una replica con un esquema
+struct ResultadoReplica {
+    std::uint64_t semilla;      // Semilla con que se genero la carga
+    std::size_t procesos;       // Procesos simulados
+    int tiempoTotal;            // Tiempo final de la simulacion
+    double promWT, promRT, promTAT;
+};
+
+// Media de una metrica entre replicas y su intervalo de confianza del 95%
+struct IntervaloConfianza {
+    double media;
+    double radio;               // El intervalo es media +- radio
+};
+
+// Todas las replicas de un esquema y su resumen
+struct ResumenEsquema {
+    std::string esquema;
+    std::vector<ResultadoReplica> replicas;   // En orden de replica
+    IntervaloConfianza wt, rt, tat;
+};
+
+/*
+  Corre las replicas
+  
+  Un trabajo por replica en un pool de hilos: genera su carga en memoria
+  y la simula con todos los esquemas, asi cada carga se genera una sola
+  vez y todos los esquemas se comparan sobre las mismas cargas. Cada
+  resultado se guarda en su posicion, por lo que el resumen no depende
+  del orden en que terminen los hilos. Retorna un resumen por esquema
+  (vacio si algun esquema no es valido).
+ */
+std::vector<ResumenEsquema> ejecutarReplicas(const ConfiguracionReplicas& config);
+
+// Media e intervalo del 95% (t de Student con n-1 grados de libertad)
+IntervaloConfianza intervaloConfianza(const std::vector<double>& valores);
+
+// Escribe una fila por replica y esquema
+void escribirReplicas(std::ostream& salida, const std::vector<ResumenEsquema>& resumenes);
+
+// Escribe la media y el intervalo de WT, RT y TAT de cada esquema
+void escribirResumenReplicas(std::ostream& salida, const std::vector<ResumenEsquema>& resumenes);
+
+#endif
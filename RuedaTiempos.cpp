@@ -0,0 +1,189 @@
+#include "RuedaTiempos.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <vector>
+
+RuedaTiempos::RuedaTiempos(std::pmr::memory_resource* memoria)
+    : siguiente(memoria), despertar(memoria), secuencia(memoria), cursor(0), cantidad(0), insertados(0),
+      lote(memoria) {
+    reiniciar();
+}
+
+void RuedaTiempos::reiniciar() {
+    for (int nivel = 0; nivel < NIVELES; nivel++) {
+        std::fill(primero[nivel], primero[nivel] + RANURAS, NINGUNO);
+        ocupadas[nivel] = 0;
+    }
+    cursor = 0;
+    cantidad = 0;
+    insertados = 0;
+}
+
+/*
+  Pone un proceso en su ranura
+  
+  El nivel es el del bit mas alto en que su tiempo difiere del cursor
+  (nivel 0 si solo difieren los 6 bits de abajo) y la ranura son los bits
+  de su tiempo en ese nivel. Como el tiempo no es menor que el cursor, la
+  ranura queda siempre despues de la del cursor en ese nivel.
+ */
+void RuedaTiempos::colocar(IdProceso id) {
+    std::uint64_t tiempo = (std::uint64_t)despertar[id];
+    std::uint64_t diferencia = tiempo ^ cursor;
+    int nivel = diferencia == 0 ? 0 : (int)(std::bit_width(diferencia) - 1) / BITS;
+    int ranura = (int)((tiempo >> (BITS * nivel)) & (RANURAS - 1));
+    
+    siguiente[id] = primero[nivel][ranura];
+    primero[nivel][ranura] = id;
+    ocupadas[nivel] |= std::uint64_t(1) << ranura;
+}
+
+IdProceso RuedaTiempos::vaciarRanura(int nivel, int ranura) {
+    IdProceso id = primero[nivel][ranura];
+    primero[nivel][ranura] = NINGUNO;
+    ocupadas[nivel] &= ~(std::uint64_t(1) << ranura);
+    return id;
+}
+
+void RuedaTiempos::dormir(IdProceso id, int tiempo, std::uint64_t orden) {
+    if (id >= siguiente.size()) {
+        siguiente.resize((std::size_t)id + 1, NINGUNO);
+        despertar.resize((std::size_t)id + 1, 0);
+        secuencia.resize((std::size_t)id + 1, 0);
+    }
+    despertar[id] = tiempo;
+    secuencia[id] = orden;
+    colocar(id);
+    cantidad++;
+}
+
+void RuedaTiempos::insertar(IdProceso id, int tiempo) {
+    dormir(id, tiempo, insertados++);
+}
+
+/*
+  Busca el proximo despertar
+  
+  Si el nivel 0 tiene procesos, su primera ranura ocupada es el proximo
+  tiempo exacto (todo lo de niveles altos es posterior). Si no, el primer
+  nivel ocupado dice desde cuando puede haber alguno: si eso ya pasa del
+  limite se responde sin tocar nada; si no, el cursor avanza al inicio de
+  esa ranura, sus procesos bajan de nivel y se vuelve a mirar.
+ */
+int RuedaTiempos::proximo(int limite) {
+    while (true) {
+        if (ocupadas[0] != 0) {
+            return (int)((cursor & ~std::uint64_t(RANURAS - 1)) | (std::uint64_t)std::countr_zero(ocupadas[0]));
+        }
+        
+        int nivel = 1;
+        while (nivel < NIVELES && ocupadas[nivel] == 0) nivel++;
+        if (nivel == NIVELES) {
+            return INT_MAX;
+        }
+        
+        int ranura = std::countr_zero(ocupadas[nivel]);
+        int alto = BITS * (nivel + 1);
+        std::uint64_t inicio = ((cursor >> alto) << alto) | ((std::uint64_t)ranura << (BITS * nivel));
+        if (limite < 0 || inicio > (std::uint64_t)limite) {
+            return inicio > (std::uint64_t)INT_MAX ? INT_MAX : (int)inicio;
+        }
+        
+        // Bajar los procesos de la ranura, ahora relativos al nuevo cursor
+        cursor = inicio;
+        IdProceso id = vaciarRanura(nivel, ranura);
+        while (id != NINGUNO) {
+            IdProceso despues = siguiente[id];
+            colocar(id);
+            id = despues;
+        }
+    }
+}
+
+/*
+  Despierta todo lo que vence hasta 'tiempo'
+  
+  Saca las ranuras del nivel 0 en orden; cada una es un tiempo exacto y
+  sus procesos se ordenan por numero de secuencia, para que el orden no
+  dependa de como fueron bajando de nivel ni de que id les toco. Al final
+  el cursor queda en 'tiempo'.
+ */
+void RuedaTiempos::avanzar(int tiempo, std::pmr::vector<IdProceso>& salida) {
+    while (cantidad > 0) {
+        int vence = proximo(tiempo);
+        if (vence > tiempo) break;
+        
+        lote.clear();
+        IdProceso id = vaciarRanura(0, vence & (RANURAS - 1));
+        while (id != NINGUNO) {
+            lote.push_back(id);
+            id = siguiente[id];
+        }
+        std::sort(lote.begin(), lote.end(), [this](IdProceso a, IdProceso b) {
+            return secuencia[a] < secuencia[b];
+        });
+        salida.insert(salida.end(), lote.begin(), lote.end());
+        cantidad -= lote.size();
+    }
+    if (tiempo >= 0 && (std::uint64_t)tiempo > cursor) {
+        cursor = (std::uint64_t)tiempo;
+    }
+}
+
+void RuedaTiempos::guardar(EscritorBinario& escritor) const {
+    escritor.escribir(cursor);
+    escritor.escribir(insertados);
+    escritor.escribir((std::uint64_t)cantidad);
+    for (int nivel = 0; nivel < NIVELES; nivel++) {
+        for (int ranura = 0; ranura < RANURAS; ranura++) {
+            for (IdProceso id = primero[nivel][ranura]; id != NINGUNO; id = siguiente[id]) {
+                escritor.escribir(id);
+                escritor.escribir(despertar[id]);
+                escritor.escribir(secuencia[id]);
+            }
+        }
+    }
+}
+
+/*
+  Carga una rueda guardada con guardar
+  
+  Los procesos se vuelven a colocar desde el cursor guardado, con su
+  numero de secuencia. Se rechazan ids fuera de la tabla o repetidos,
+  tiempos anteriores al cursor y secuencias que el contador no alcanzo.
+ */
+bool RuedaTiempos::cargar(LectorBinario& lector, std::size_t maxId) {
+    reiniciar();
+    std::uint64_t cursorGuardado = 0;
+    std::uint64_t insertadosGuardados = 0;
+    std::uint64_t procesos = 0;
+    lector.leer(cursorGuardado);
+    lector.leer(insertadosGuardados);
+    lector.leerTamano(procesos, maxId);
+    if (!lector.bien() || cursorGuardado > (std::uint64_t)INT_MAX) {
+        lector.fallar();
+        return false;
+    }
+    cursor = cursorGuardado;
+    insertados = insertadosGuardados;
+    
+    std::vector<bool> visto(maxId, false);
+    for (std::uint64_t i = 0; i < procesos; i++) {
+        IdProceso id = 0;
+        int tiempo = 0;
+        std::uint64_t orden = 0;
+        lector.leer(id);
+        lector.leer(tiempo);
+        lector.leer(orden);
+        if (!lector.bien() || id >= maxId || visto[id] || tiempo < 0 || (std::uint64_t)tiempo < cursor ||
+            orden >= insertados) {
+            lector.fallar();
+            reiniciar();
+            return false;
+        }
+        visto[id] = true;
+        dormir(id, tiempo, orden);
+    }
+    return true;
+}
@@ -0,0 +1,91 @@
+#ifndef RUEDATIEMPOS_H
+#define RUEDATIEMPOS_H
+
+#include "TablaProcesos.h"
+#include "Binario.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/*
+  Clase RuedaTiempos
+  
+  Procesos bloqueados en E/S, ordenados por el tiempo en que despiertan,
+  en una rueda de tiempos jerarquica: 6 niveles de 64 ranuras (6 bits de
+  tiempo por nivel, 36 en total, mas que el rango de un int). Un proceso
+  va al nivel del bit mas alto en que su tiempo difiere del cursor de la
+  rueda y a la ranura que dan sus bits de ese nivel, asi que insertar es
+  O(1) sin importar cuantos haya dormidos. En el nivel 0 cada ranura es
+  un solo tiempo exacto; las de arriba abarcan 64, 4096, ... unidades.
+  
+  Para encontrar el proximo despertar se busca la primera ranura ocupada
+  del nivel mas bajo con un count-trailing-zeros por nivel. Si esta en un
+  nivel alto, el cursor avanza al inicio de esa ranura y sus procesos se
+  reparten en los niveles de abajo (cada proceso baja a lo sumo 5 veces
+  en total), hasta que el proximo queda en el nivel 0.
+  
+  Las listas de cada ranura se enlazan por id de proceso (un arreglo de
+  siguientes indexado por id), sin nodos aparte. Cada insercion lleva un
+  numero de secuencia creciente: los que despiertan en el mismo tiempo
+  salen en el orden en que se durmieron, no por id (en modo flujo los
+  ids se reciclan, asi que ese orden no dice nada).
+  
+  El cursor nunca pasa del limite que se le da a proximo() ni del tiempo
+  de avanzar(), y ningun proceso puede dormirse antes del cursor: quien
+  la usa debe garantizar que no insertara un despertar menor que esos
+  limites (en la simulacion, nada se bloquea antes del fin de la rebanada
+  o del salto de tiempo que se esta calculando).
+ */
+class RuedaTiempos {
+private:
+    static constexpr int BITS = 6;
+    static constexpr int RANURAS = 1 << BITS;
+    static constexpr int NIVELES = 6;
+    static constexpr IdProceso NINGUNO = UINT32_MAX;
+    
+    std::pmr::vector<IdProceso> siguiente;   // Siguiente de la misma ranura (por id)
+    std::pmr::vector<int> despertar;         // Tiempo en que despierta (por id)
+    std::pmr::vector<std::uint64_t> secuencia; // Numero de insercion (por id)
+    IdProceso primero[NIVELES][RANURAS];     // Cabeza de la lista de cada ranura
+    std::uint64_t ocupadas[NIVELES];         // Un bit por ranura con procesos
+    std::uint64_t cursor;                    // Todos los procesos despiertan en o despues de aqui
+    std::size_t cantidad;                    // Procesos dormidos
+    std::uint64_t insertados;                // Proximo numero de secuencia
+    std::pmr::vector<IdProceso> lote;        // Procesos de una ranura al despertar
+    
+    // Pone un proceso en la ranura que le toca segun el cursor actual
+    void colocar(IdProceso id);
+    
+    // Duerme un proceso con un numero de secuencia ya asignado
+    void dormir(IdProceso id, int tiempo, std::uint64_t orden);
+    
+    // Saca toda la lista de una ranura
+    IdProceso vaciarRanura(int nivel, int ranura);
+
+public:
+    explicit RuedaTiempos(std::pmr::memory_resource* memoria = std::pmr::get_default_resource());
+    
+    // Quita todos los procesos y vuelve el cursor a 0
+    void reiniciar();
+    
+    // Duerme un proceso hasta 'tiempo' (no menor que el ultimo avanzar)
+    void insertar(IdProceso id, int tiempo);
+    
+    // El proximo despertar si es menor o igual a 'limite'; si no, algun
+    // valor mayor que 'limite' (INT_MAX si no hay nadie dormido)
+    int proximo(int limite);
+    
+    // Agrega a 'salida' los procesos que despiertan hasta 'tiempo', por
+    // tiempo de despertar y, en el mismo tiempo, por orden de insercion
+    void avanzar(int tiempo, std::pmr::vector<IdProceso>& salida);
+    
+    bool vacia() const { return cantidad == 0; }
+    std::size_t tamano() const { return cantidad; }
+    
+    // Checkpoint: el cursor, el contador de secuencia y cada proceso con
+    // su tiempo de despertar y su numero de secuencia
+    void guardar(EscritorBinario& escritor) const;
+    bool cargar(LectorBinario& lector, std::size_t maxId);
+};
+
+#endif
@@ -0,0 +1,265 @@
+#include "SalidaColumnar.h"
+#include "Binario.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char MAGIA_COLUMNAS[8] = {'M', 'L', 'F', 'Q', 'C', 'O', 'L', '1'};
+const char MAGIA_PIE[8] = {'F', 'I', 'N', 'C', 'O', 'L', '0', '1'};
+const std::uint32_t VERSION_COLUMNAS = 1;
+
+// Inicio de las etiquetas, cantidad de filas, cantidad de grupos y magia
+const std::uint64_t TAMANO_PIE = 8 + 8 + 8 + 8;
+
+// Nombres mas largos que esto indican un archivo corrupto
+const std::uint64_t MAX_LARGO_NOMBRE = 256;
+
+const char* const NOMBRES_COLUMNAS[COLUMNAS_RESULTADO] = {
+    "etiqueta", "BT", "AT", "Q", "Pr", "WT", "CT", "RT", "TAT"
+};
+
+}
+
+const char* nombreColumna(std::size_t columna) {
+    return columna < COLUMNAS_RESULTADO ? NOMBRES_COLUMNAS[columna] : "";
+}
+
+/*
+  Constructor del escritor
+  
+  Crea el archivo y escribe el encabezado con el nombre de cada columna.
+  Si el archivo no se pudo crear, abierto() da false y lo que se agregue
+  se descarta.
+ */
+EscritorColumnar::EscritorColumnar(const std::string& ruta)
+    : archivo(ruta, std::ios::binary | std::ios::trunc), filas(0), grupos(0) {
+    for (std::vector<std::int32_t>& columna : columnas) {
+        columna.reserve(FILAS_POR_GRUPO);
+    }
+    
+    EscritorBinario salida(archivo);
+    std::uint32_t cantidadColumnas = (std::uint32_t)COLUMNAS_RESULTADO;
+    archivo.write(MAGIA_COLUMNAS, sizeof(MAGIA_COLUMNAS));
+    salida.escribir(VERSION_COLUMNAS);
+    salida.escribir(cantidadColumnas);
+    for (std::size_t c = 0; c < COLUMNAS_RESULTADO; c++) {
+        std::uint32_t largo = (std::uint32_t)std::strlen(NOMBRES_COLUMNAS[c]);
+        salida.escribir(largo);
+        archivo.write(NOMBRES_COLUMNAS[c], largo);
+    }
+}
+
+void EscritorColumnar::agregar(std::string_view etiqueta, FilaResultado fila) {
+    if (!archivo.is_open()) {
+        return;
+    }
+    
+    fila[0] = (std::int32_t)etiquetas.internar(etiqueta);
+    for (std::size_t c = 0; c < COLUMNAS_RESULTADO; c++) {
+        columnas[c].push_back(fila[c]);
+    }
+    filas++;
+    if (columnas[0].size() == FILAS_POR_GRUPO) {
+        escribirGrupo();
+    }
+}
+
+void EscritorColumnar::escribirGrupo() {
+    EscritorBinario salida(archivo);
+    std::uint32_t cantidad = (std::uint32_t)columnas[0].size();
+    salida.escribir(cantidad);
+    for (std::vector<std::int32_t>& columna : columnas) {
+        archivo.write(reinterpret_cast<const char*>(columna.data()),
+                      (std::streamsize)(columna.size() * sizeof(std::int32_t)));
+        columna.clear();
+    }
+    grupos++;
+}
+
+bool EscritorColumnar::terminar() {
+    if (!archivo.is_open()) {
+        return false;
+    }
+    if (!columnas[0].empty()) {
+        escribirGrupo();
+    }
+    
+    EscritorBinario salida(archivo);
+    std::uint64_t inicioEtiquetas = (std::uint64_t)archivo.tellp();
+    std::uint64_t cantidad = etiquetas.tamano();
+    salida.escribir(cantidad);
+    for (IdEtiqueta id = 0; id < cantidad; id++) {
+        std::uint32_t largo = (std::uint32_t)etiquetas.getTexto(id).size();
+        salida.escribir(largo);
+    }
+    for (IdEtiqueta id = 0; id < cantidad; id++) {
+        std::string_view etiqueta = etiquetas.getTexto(id);
+        archivo.write(etiqueta.data(), (std::streamsize)etiqueta.size());
+    }
+    
+    salida.escribir(inicioEtiquetas);
+    salida.escribir(filas);
+    salida.escribir(grupos);
+    archivo.write(MAGIA_PIE, sizeof(MAGIA_PIE));
+    
+    archivo.flush();
+    bool ok = archivo.good();
+    archivo.close();
+    return ok;
+}
+
+LectorColumnar::LectorColumnar() : filas(0), grupos(0), gruposLeidos(0), finGrupos(0) {
+}
+
+/*
+  Abre un archivo columnar
+  
+  Lee el encabezado y el pie, carga las etiquetas y recorre los grupos
+  solo leyendo su cantidad de filas: tienen que sumar las filas del pie y
+  terminar justo donde empiezan las etiquetas. Asi un archivo cortado o
+  ajeno se rechaza antes de leer columnas.
+ */
+bool LectorColumnar::abrir(const std::string& ruta) {
+    archivo.close();
+    archivo.clear();
+    nombres.clear();
+    textoEtiquetas.clear();
+    inicios.clear();
+    filas = grupos = gruposLeidos = finGrupos = 0;
+    error.clear();
+    
+    archivo.open(ruta, std::ios::binary);
+    if (!archivo.is_open()) {
+        error = "no se pudo abrir el archivo";
+        return false;
+    }
+    archivo.seekg(0, std::ios::end);
+    std::uint64_t tamano = (std::uint64_t)archivo.tellg();
+    archivo.seekg(0);
+    
+    // Encabezado
+    LectorBinario entrada(archivo);
+    char magia[8] = {};
+    std::uint32_t version = 0, cantidadColumnas = 0;
+    archivo.read(magia, sizeof(magia));
+    if (!archivo || tamano < sizeof(magia) + TAMANO_PIE ||
+        std::memcmp(magia, MAGIA_COLUMNAS, sizeof(magia)) != 0) {
+        error = "no es un archivo columnar";
+        return false;
+    }
+    if (!entrada.leer(version) || version != VERSION_COLUMNAS) {
+        error = "version de archivo columnar no soportada";
+        return false;
+    }
+    if (!entrada.leer(cantidadColumnas) || cantidadColumnas != COLUMNAS_RESULTADO) {
+        error = "encabezado columnar corrupto";
+        return false;
+    }
+    for (std::uint32_t c = 0; c < cantidadColumnas; c++) {
+        std::uint32_t largo = 0;
+        std::string nombre;
+        if (!entrada.leer(largo) || largo > MAX_LARGO_NOMBRE) {
+            error = "encabezado columnar corrupto";
+            return false;
+        }
+        nombre.resize(largo);
+        if (!archivo.read(nombre.data(), largo)) {
+            error = "encabezado columnar corrupto";
+            return false;
+        }
+        nombres.push_back(std::move(nombre));
+    }
+    std::uint64_t inicioGrupos = (std::uint64_t)archivo.tellg();
+    
+    // Pie
+    std::uint64_t inicioEtiquetas = 0;
+    archivo.seekg((std::streamoff)(tamano - TAMANO_PIE));
+    entrada.leer(inicioEtiquetas);
+    entrada.leer(filas);
+    entrada.leer(grupos);
+    archivo.read(magia, sizeof(magia));
+    if (!entrada.bien() || !archivo || std::memcmp(magia, MAGIA_PIE, sizeof(magia)) != 0) {
+        error = "el archivo columnar esta incompleto (falta el pie)";
+        return false;
+    }
+    std::uint64_t finEtiquetas = tamano - TAMANO_PIE;
+    if (inicioEtiquetas < inicioGrupos || inicioEtiquetas > finEtiquetas) {
+        error = "el pie del archivo columnar esta corrupto";
+        return false;
+    }
+    finGrupos = inicioEtiquetas;
+    
+    // Etiquetas: cantidad, largos y texto, que deben terminar justo en el pie
+    std::uint64_t cantidad = 0;
+    archivo.seekg((std::streamoff)inicioEtiquetas);
+    std::uint64_t disponible = finEtiquetas - inicioEtiquetas;
+    if (!entrada.leerTamano(cantidad, (disponible - std::min<std::uint64_t>(disponible, 8)) / sizeof(std::uint32_t))) {
+        error = "tabla de etiquetas corrupta";
+        return false;
+    }
+    std::vector<std::uint32_t> largos((std::size_t)cantidad);
+    archivo.read(reinterpret_cast<char*>(largos.data()), (std::streamsize)(cantidad * sizeof(std::uint32_t)));
+    std::uint64_t texto = inicioEtiquetas + 8 + cantidad * sizeof(std::uint32_t);
+    inicios.reserve((std::size_t)cantidad + 1);
+    inicios.push_back(0);
+    for (std::uint32_t largo : largos) {
+        inicios.push_back(inicios.back() + largo);
+    }
+    if (!archivo || texto + inicios.back() != finEtiquetas) {
+        error = "tabla de etiquetas corrupta";
+        return false;
+    }
+    textoEtiquetas.resize((std::size_t)inicios.back());
+    if (!archivo.read(textoEtiquetas.data(), (std::streamsize)textoEtiquetas.size())) {
+        error = "tabla de etiquetas corrupta";
+        return false;
+    }
+    
+    // Grupos: solo su cantidad de filas, saltando las columnas
+    std::uint64_t posicion = inicioGrupos;
+    std::uint64_t filasGrupos = 0;
+    for (std::uint64_t g = 0; g < grupos; g++) {
+        std::uint32_t cantidadFilas = 0;
+        archivo.seekg((std::streamoff)posicion);
+        if (finGrupos - posicion < sizeof(cantidadFilas) || !entrada.leer(cantidadFilas) ||
+            cantidadFilas > FILAS_POR_GRUPO) {
+            error = "grupo de filas corrupto";
+            return false;
+        }
+        posicion += sizeof(cantidadFilas) + (std::uint64_t)cantidadFilas * COLUMNAS_RESULTADO * sizeof(std::int32_t);
+        filasGrupos += cantidadFilas;
+        if (posicion > finGrupos) {
+            error = "grupo de filas corrupto";
+            return false;
+        }
+    }
+    if (posicion != finGrupos || filasGrupos != filas) {
+        error = "la cantidad de filas no coincide con el archivo";
+        return false;
+    }
+    
+    archivo.seekg((std::streamoff)inicioGrupos);
+    return true;
+}
+
+bool LectorColumnar::siguienteGrupo(std::array<std::vector<std::int32_t>, COLUMNAS_RESULTADO>& columnas) {
+    if (gruposLeidos == grupos || !error.empty()) {
+        return false;
+    }
+    
+    // La cantidad ya se valido al abrir
+    LectorBinario entrada(archivo);
+    std::uint32_t cantidadFilas = 0;
+    entrada.leer(cantidadFilas);
+    for (std::vector<std::int32_t>& columna : columnas) {
+        columna.resize(cantidadFilas);
+        archivo.read(reinterpret_cast<char*>(columna.data()), (std::streamsize)(cantidadFilas * sizeof(std::int32_t)));
+    }
+    if (!entrada.bien() || !archivo) {
+        error = "no se pudo leer un grupo de filas";
+        return false;
+    }
+    gruposLeidos++;
+    return true;
+}
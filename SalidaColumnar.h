@@ -0,0 +1,135 @@
+#ifndef SALIDACOLUMNAR_H
+#define SALIDACOLUMNAR_H
+
+#include "Etiquetas.h"
+#include "TablaProcesos.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+  Archivo columnar de resultados
+  
+  Las mismas filas del archivo de salida guardadas por columnas, para
+  cargarlas en herramientas de analisis sin parsear texto. El archivo
+  tiene cuatro partes:
+  
+  1. Encabezado: magia "MLFQCOL1", version, cantidad de columnas y el
+     nombre de cada una (largo y texto).
+  2. Grupos de hasta FILAS_POR_GRUPO filas: la cantidad de filas y
+     despues cada columna completa como enteros de 32 bits. La etiqueta
+     es un id del diccionario de la parte 3.
+  3. Etiquetas: cantidad de etiquetas distintas, el largo de cada una y
+     despues todo el texto seguido (al final, porque en el modo en linea
+     siguen llegando procesos mientras se escriben los grupos).
+  4. Pie: donde empiezan las etiquetas, cuantas filas y cuantos grupos
+     hay, y la magia "FINCOL01". Un archivo sin pie quedo cortado y no se
+     acepta.
+  
+  Las filas van en orden de finalizacion y los enteros en el orden de
+  bytes de la maquina, igual que la traza binaria.
+ */
+
+// Columnas en el orden del archivo de salida; la 0 es la etiqueta
+const std::size_t COLUMNAS_RESULTADO = 9;
+const std::size_t FILAS_POR_GRUPO = 65536;
+
+// Nombre de una columna ("etiqueta", "BT", ..., "TAT")
+const char* nombreColumna(std::size_t columna);
+
+// Una fila: id de la etiqueta y BT, AT, Q, Pr, WT, CT, RT, TAT
+typedef std::array<std::int32_t, COLUMNAS_RESULTADO> FilaResultado;
+
+/*
+  Clase EscritorColumnar
+  
+  Junta las filas de un grupo en memoria y lo escribe al llenarse, asi
+  la memoria no crece con la cantidad de filas (solo el diccionario de
+  etiquetas distintas). terminar() escribe el ultimo grupo, las
+  etiquetas y el pie.
+ */
+class EscritorColumnar {
+private:
+    std::ofstream archivo;
+    TablaEtiquetas etiquetas;
+    std::array<std::vector<std::int32_t>, COLUMNAS_RESULTADO> columnas;   // Grupo en curso
+    std::uint64_t filas;        // Filas escritas (incluye el grupo en curso)
+    std::uint64_t grupos;       // Grupos ya escritos
+    
+    void escribirGrupo();
+
+public:
+    explicit EscritorColumnar(const std::string& ruta);
+    
+    EscritorColumnar(const EscritorColumnar&) = delete;
+    EscritorColumnar& operator=(const EscritorColumnar&) = delete;
+    
+    // false si el archivo no se pudo crear
+    bool abierto() const { return archivo.is_open(); }
+    
+    // Agrega una fila; fila[0] se ignora y se reemplaza por el id de 'etiqueta'
+    void agregar(std::string_view etiqueta, FilaResultado fila);
+    
+    // Fila de un proceso terminado, con los mismos valores de su linea de salida
+    void agregar(const TablaProcesos& tabla, IdProceso id) {
+        agregar(tabla.getEtiqueta(id),
+                FilaResultado{0, tabla.getTiempoRafaga(id), tabla.getTiempoLlegada(id), tabla.getCola(id) + 1,
+                              tabla.getPrioridad(id), tabla.getTiempoEspera(id), tabla.getTiempoFinalizacion(id),
+                              tabla.getTiempoRespuesta(id), tabla.getTiempoRetorno(id)});
+    }
+    
+    std::uint64_t getFilas() const { return filas; }
+    
+    // Escribe lo pendiente, las etiquetas y el pie, y cierra el archivo.
+    // Retorna false si algo no se pudo escribir
+    bool terminar();
+};
+
+/*
+  Clase LectorColumnar
+  
+  Lee un archivo columnar grupo por grupo. abrir() valida el encabezado
+  y el pie y carga el diccionario de etiquetas; despues cada
+  siguienteGrupo() deja las columnas de un grupo en el arreglo dado.
+ */
+class LectorColumnar {
+private:
+    std::ifstream archivo;
+    std::vector<std::string> nombres;       // Nombre de cada columna
+    std::string textoEtiquetas;             // Todas las etiquetas seguidas
+    std::vector<std::uint64_t> inicios;     // Donde empieza cada etiqueta (y uno mas al final)
+    std::uint64_t filas;
+    std::uint64_t grupos;
+    std::uint64_t gruposLeidos;
+    std::uint64_t finGrupos;                // Donde terminan los grupos (empiezan las etiquetas)
+    std::string error;
+
+public:
+    LectorColumnar();
+    
+    // Abre y valida el archivo; si falla, getError() dice por que
+    bool abrir(const std::string& ruta);
+    
+    // Lee el siguiente grupo; false al terminar o si el archivo esta danado
+    // (en ese caso getError() no queda vacio)
+    bool siguienteGrupo(std::array<std::vector<std::int32_t>, COLUMNAS_RESULTADO>& columnas);
+    
+    std::uint64_t getFilas() const { return filas; }
+    std::uint64_t getGrupos() const { return grupos; }
+    std::size_t getCantidadEtiquetas() const { return inicios.empty() ? 0 : inicios.size() - 1; }
+    const std::vector<std::string>& getNombres() const { return nombres; }
+    const std::string& getError() const { return error; }
+    
+    // Texto de una etiqueta; vacio si el id no esta en el diccionario
+    std::string_view getEtiqueta(std::uint32_t id) const {
+        if (id >= getCantidadEtiquetas()) return std::string_view();
+        return std::string_view(textoEtiquetas).substr((std::size_t)inicios[id],
+                                                       (std::size_t)(inicios[id + 1] - inicios[id]));
+    }
+};
+
+#endif
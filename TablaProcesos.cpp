@@ -0,0 +1,404 @@
+#include "TablaProcesos.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+/*
+  Constructor
+  
+  Todas las columnas usan 'm' como recurso de memoria.
+ */
+TablaProcesos::TablaProcesos(std::pmr::memory_resource& m)
+    : memoria(&m), tiempoRafaga(&m), tiempoLlegada(&m), tiempoRestante(&m), cola(&m),
+      colaOriginal(&m), tiempoInicio(&m), tiempoFinalizacion(&m), prioridad(&m), etiquetas(&m),
+      capacidadEtiqueta(&m), rafagas(&m), inicioRafagas(&m), siguienteRafaga(&m), finRafagas(&m),
+      capacidadRafagas(&m), libres(&m) {
+}
+
+/*
+  Recorre un texto de rafagas "es,cpu,es,cpu,..."
+  
+  Llama a 'usar' con cada numero y retorna cuantos hubo, o -1 si alguno
+  no es un entero positivo o si no vienen en pares. Acepta espacios
+  alrededor de los numeros; un texto vacio (o solo espacios) no tiene
+  rafagas.
+ */
+template <typename Funcion>
+static int recorrerRafagas(std::string_view texto, Funcion usar) {
+    auto esEspacio = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+    const char* p = texto.data();
+    const char* fin = p + texto.size();
+    while (p < fin && esEspacio(*p)) p++;
+    if (p == fin) return 0;
+    
+    int cantidad = 0;
+    while (true) {
+        while (p < fin && esEspacio(*p)) p++;
+        int valor = 0;
+        std::from_chars_result resultado = std::from_chars(p, fin, valor);
+        if (resultado.ec != std::errc() || valor <= 0) return -1;
+        usar(valor);
+        cantidad++;
+        p = resultado.ptr;
+        while (p < fin && esEspacio(*p)) p++;
+        if (p == fin) break;
+        if (*p != ',') return -1;
+        p++;
+    }
+    return cantidad % 2 == 0 ? cantidad : -1;
+}
+
+int contarRafagas(std::string_view texto) {
+    return recorrerRafagas(texto, [](int) {});
+}
+
+/*
+  Reserva espacio para n procesos
+  
+  Util cuando se cargan muchos procesos de una vez, para que las columnas
+  no se realojen varias veces mientras crecen (en la arena cada realojo
+  deja el bloque anterior sin usar hasta el reinicio). Si ya hay espacio
+  no hace nada; si no, al menos duplica la capacidad.
+ */
+void TablaProcesos::reservar(std::size_t n) {
+    if (n <= tiempoRafaga.capacity()) return;
+    n = std::max(n, 2 * tiempoRafaga.capacity());
+    
+    tiempoRafaga.reserve(n);
+    tiempoLlegada.reserve(n);
+    tiempoRestante.reserve(n);
+    cola.reserve(n);
+    colaOriginal.reserve(n);
+    tiempoInicio.reserve(n);
+    tiempoFinalizacion.reserve(n);
+    prioridad.reserve(n);
+    etiquetas.reserve(n);
+    capacidadEtiqueta.reserve(n);
+    inicioRafagas.reserve(n);
+    siguienteRafaga.reserve(n);
+    finRafagas.reserve(n);
+    capacidadRafagas.reserve(n);
+}
+
+/*
+  Obtiene la fila para un proceso nuevo y la llena con sus datos
+  
+  Si hay ids liberados se reutiliza el ultimo (sus columnas se
+  sobrescriben); si no, se agrega una fila al final de todas las columnas.
+  Asi una simulacion que libera sus procesos al terminar ocupa memoria
+  proporcional a los procesos vivos, no a todos los que han pasado.
+  La etiqueta la pone quien llama.
+ */
+IdProceso TablaProcesos::nuevaFila(int bt, int at, int q, int pr) {
+    if (libres.empty()) {
+        IdProceso id = (IdProceso)tiempoRafaga.size();
+        tiempoRafaga.push_back(bt);
+        tiempoLlegada.push_back(at);
+        tiempoRestante.push_back(bt);
+        cola.push_back(q);
+        colaOriginal.push_back(q);
+        tiempoInicio.push_back(SIN_INICIO);
+        tiempoFinalizacion.push_back(0);
+        prioridad.push_back(pr);
+        etiquetas.push_back(std::string_view());
+        capacidadEtiqueta.push_back(0);
+        inicioRafagas.push_back(0);
+        siguienteRafaga.push_back(0);
+        finRafagas.push_back(0);
+        capacidadRafagas.push_back(0);
+        return id;
+    }
+    
+    IdProceso id = libres.back();
+    libres.pop_back();
+    tiempoRafaga[id] = bt;
+    tiempoLlegada[id] = at;
+    tiempoRestante[id] = bt;
+    cola[id] = q;
+    colaOriginal[id] = q;
+    tiempoInicio[id] = SIN_INICIO;
+    tiempoFinalizacion[id] = 0;
+    prioridad[id] = pr;
+    siguienteRafaga[id] = inicioRafagas[id];
+    finRafagas[id] = inicioRafagas[id];
+    return id;
+}
+
+/*
+  Guarda las rafagas de E/S de un proceso
+  
+  Igual que con las etiquetas, si el id es reutilizado y su espacio
+  anterior alcanza se copian ahi; si no, van al final del arreglo comun.
+  La CPU de cada par se suma a la rafaga total del proceso.
+ */
+void TablaProcesos::ponerRafagas(IdProceso id, const int* datos, std::size_t cantidad) {
+    if (cantidad == 0) return;
+    
+    if (capacidadRafagas[id] < cantidad) {
+        inicioRafagas[id] = (std::uint32_t)rafagas.size();
+        capacidadRafagas[id] = (std::uint32_t)cantidad;
+        rafagas.insert(rafagas.end(), datos, datos + cantidad);
+    } else {
+        std::copy(datos, datos + cantidad, rafagas.begin() + inicioRafagas[id]);
+    }
+    siguienteRafaga[id] = inicioRafagas[id];
+    finRafagas[id] = inicioRafagas[id] + (std::uint32_t)cantidad;
+    
+    for (std::size_t i = 1; i < cantidad; i += 2) {
+        tiempoRafaga[id] += datos[i];
+    }
+}
+
+void TablaProcesos::ponerRafagas(IdProceso id, std::string_view texto) {
+    temporalRafagas.clear();
+    if (recorrerRafagas(texto, [this](int valor) { temporalRafagas.push_back(valor); }) > 0) {
+        ponerRafagas(id, temporalRafagas.data(), temporalRafagas.size());
+    }
+}
+
+int TablaProcesos::getTiempoES(IdProceso id) const {
+    int total = 0;
+    for (std::uint32_t i = inicioRafagas[id]; i < finRafagas[id]; i += 2) {
+        total += rafagas[i];
+    }
+    return total;
+}
+
+std::vector<int> TablaProcesos::getRafagasES(IdProceso id) const {
+    return std::vector<int>(rafagas.begin() + inicioRafagas[id], rafagas.begin() + finRafagas[id]);
+}
+
+/*
+  Agrega un proceso a la tabla
+  
+  El id es la posicion del proceso en las columnas. El tiempo restante
+  empieza igual a la rafaga y el proceso aun no ha iniciado.
+  
+  El texto de la etiqueta se copia a 'memoria'. Si el id es reutilizado y
+  su espacio anterior alcanza, se copia ahi mismo; si no, ese espacio se
+  devuelve y se pide uno nuevo (en la arena devolver no hace nada).
+ */
+IdProceso TablaProcesos::agregar(std::string_view etiqueta, int bt, int at, int q, int pr,
+                                 const std::vector<int>& rafagasES) {
+    IdProceso id = nuevaFila(bt, at, q, pr);
+    ponerRafagas(id, rafagasES.data(), rafagasES.size());
+    
+    char* texto = const_cast<char*>(etiquetas[id].data());
+    if (capacidadEtiqueta[id] < etiqueta.size()) {
+        if (capacidadEtiqueta[id] > 0) {
+            memoria->deallocate(texto, capacidadEtiqueta[id], 1);
+        }
+        texto = static_cast<char*>(memoria->allocate(etiqueta.size(), 1));
+        capacidadEtiqueta[id] = (std::uint32_t)etiqueta.size();
+    }
+    if (!etiqueta.empty()) {
+        std::memcpy(texto, etiqueta.data(), etiqueta.size());
+    }
+    etiquetas[id] = std::string_view(texto, etiqueta.size());
+    
+    return id;
+}
+
+/*
+  Agrega un proceso desde un registro de entrada
+  
+  La vista de la etiqueta se guarda tal cual, sin copiar el texto. Lo usa
+  el lector de trazas para que las etiquetas sigan apuntando al archivo
+  mapeado en memoria. Si el id reutilizado tenia texto propio, se devuelve.
+ */
+IdProceso TablaProcesos::agregar(const RegistroProceso& registro) {
+    IdProceso id = nuevaFila(registro.tiempoRafaga, registro.tiempoLlegada, registro.cola, registro.prioridad);
+    if (capacidadEtiqueta[id] > 0) {
+        memoria->deallocate(const_cast<char*>(etiquetas[id].data()), capacidadEtiqueta[id], 1);
+    }
+    etiquetas[id] = registro.etiqueta;
+    capacidadEtiqueta[id] = 0;
+    ponerRafagas(id, registro.rafagas);
+    
+    return id;
+}
+
+IdProceso TablaProcesos::agregar(const Proceso& proceso) {
+    return agregar(proceso.getEtiqueta(), proceso.getPrimeraRafaga(), proceso.getTiempoLlegada(),
+                   proceso.getColaOriginal(), proceso.getPrioridad(), proceso.getRafagasES());
+}
+
+/*
+  Ejecuta un proceso por una rebanada de varias unidades
+  
+  Igual que Proceso::ejecutar: marca el inicio si es la primera vez
+  y descuenta el tiempo restante de una sola vez.
+ */
+void TablaProcesos::ejecutar(IdProceso id, int tiempoActual, int unidades) {
+    if (unidades <= 0) return;
+    
+    if (tiempoInicio[id] == SIN_INICIO) {
+        tiempoInicio[id] = tiempoActual;
+    }
+    tiempoRestante[id] -= std::min(unidades, tiempoRestante[id]);
+}
+
+/*
+  Escribe la linea de salida de un proceso terminado
+  
+  Mismo formato que cada fila del archivo de salida; la Q es la cola
+  final, convertida a 1-indexed, y BT es el total de CPU (con E/S es la
+  suma de todas sus rafagas).
+ */
+void TablaProcesos::escribirLinea(EscritorTexto& salida, IdProceso id) const {
+    salida.texto(etiquetas[id]);
+    salida.caracter(';');
+    salida.entero(tiempoRafaga[id]);
+    salida.caracter(';');
+    salida.entero(tiempoLlegada[id]);
+    salida.caracter(';');
+    salida.entero(cola[id] + 1);
+    salida.caracter(';');
+    salida.entero(prioridad[id]);
+    salida.caracter(';');
+    salida.entero(getTiempoEspera(id));
+    salida.caracter(';');
+    salida.entero(tiempoFinalizacion[id]);
+    salida.caracter(';');
+    salida.entero(getTiempoRespuesta(id));
+    salida.caracter(';');
+    salida.entero(getTiempoRetorno(id));
+    salida.caracter('\n');
+}
+
+// Linea suelta a un flujo (para muchas lineas conviene un EscritorTexto)
+void TablaProcesos::escribirLinea(std::ostream& salida, IdProceso id) const {
+    EscritorTexto linea(&salida, 128);
+    escribirLinea(linea, id);
+}
+
+/*
+  Construye un Proceso con el estado actual del id
+  
+  Proceso queda como fachada: sirve para mostrar la informacion o generar
+  la linea de salida sin que el resto del codigo conozca la tabla.
+ */
+Proceso TablaProcesos::obtenerProceso(IdProceso id) const {
+    std::vector<int> rafagasES = getRafagasES(id);
+    int primera = tiempoRafaga[id];
+    for (std::size_t i = 1; i < rafagasES.size(); i += 2) {
+        primera -= rafagasES[i];
+    }
+    Proceso proceso(std::string(etiquetas[id]), primera, tiempoLlegada[id], colaOriginal[id], prioridad[id], rafagasES);
+    proceso.setCola(cola[id]);
+    proceso.setTiempoRestante(tiempoRestante[id]);
+    
+    if (getHaIniciado(id)) {
+        proceso.setTiempoInicio(tiempoInicio[id]);
+    }
+    if (estaCompleto(id) && getHaIniciado(id)) {
+        proceso.setTiempoFinalizacion(tiempoFinalizacion[id]);
+        proceso.calcularMetricas();
+    }
+    return proceso;
+}
+
+/*
+  Guarda la tabla para un checkpoint
+  
+  Cada columna se escribe completa; las etiquetas van como una lista de
+  largos seguida de todo el texto junto.
+ */
+void TablaProcesos::guardar(EscritorBinario& escritor) const {
+    escritor.escribirVector(tiempoRafaga);
+    escritor.escribirVector(tiempoLlegada);
+    escritor.escribirVector(tiempoRestante);
+    escritor.escribirVector(cola);
+    escritor.escribirVector(colaOriginal);
+    escritor.escribirVector(tiempoInicio);
+    escritor.escribirVector(tiempoFinalizacion);
+    escritor.escribirVector(prioridad);
+    
+    std::vector<std::uint32_t> largos(etiquetas.size());
+    std::string texto;
+    for (std::size_t i = 0; i < etiquetas.size(); i++) {
+        largos[i] = (std::uint32_t)etiquetas[i].size();
+        texto.append(etiquetas[i].data(), etiquetas[i].size());
+    }
+    escritor.escribirVector(largos);
+    escritor.escribirTexto(texto);
+    escritor.escribirVector(rafagas);
+    escritor.escribirVector(inicioRafagas);
+    escritor.escribirVector(siguienteRafaga);
+    escritor.escribirVector(finRafagas);
+    escritor.escribirVector(capacidadRafagas);
+    escritor.escribirVector(libres);
+}
+
+/*
+  Carga una tabla guardada con guardar
+  
+  Revisa que todas las columnas tengan el mismo largo y que los ids
+  libres existan. El texto de cada etiqueta se copia a 'memoria' por
+  separado, para que se pueda devolver cuando se reemplace.
+ */
+bool TablaProcesos::cargar(LectorBinario& lector) {
+    const std::uint64_t MAX_FILAS = UINT32_MAX;
+    lector.leerVector(tiempoRafaga, MAX_FILAS);
+    lector.leerVector(tiempoLlegada, MAX_FILAS);
+    lector.leerVector(tiempoRestante, MAX_FILAS);
+    lector.leerVector(cola, MAX_FILAS);
+    lector.leerVector(colaOriginal, MAX_FILAS);
+    lector.leerVector(tiempoInicio, MAX_FILAS);
+    lector.leerVector(tiempoFinalizacion, MAX_FILAS);
+    lector.leerVector(prioridad, MAX_FILAS);
+    
+    std::vector<std::uint32_t> largos;
+    std::string texto;
+    lector.leerVector(largos, MAX_FILAS);
+    lector.leerTexto(texto, UINT64_MAX);
+    lector.leerVector(rafagas, MAX_FILAS);
+    lector.leerVector(inicioRafagas, MAX_FILAS);
+    lector.leerVector(siguienteRafaga, MAX_FILAS);
+    lector.leerVector(finRafagas, MAX_FILAS);
+    lector.leerVector(capacidadRafagas, MAX_FILAS);
+    lector.leerVector(libres, MAX_FILAS);
+    if (!lector.bien()) {
+        return false;
+    }
+    
+    std::size_t n = tiempoRafaga.size();
+    bool consistente = tiempoLlegada.size() == n && tiempoRestante.size() == n && cola.size() == n &&
+                       colaOriginal.size() == n && tiempoInicio.size() == n &&
+                       tiempoFinalizacion.size() == n && prioridad.size() == n && largos.size() == n &&
+                       inicioRafagas.size() == n && siguienteRafaga.size() == n && finRafagas.size() == n &&
+                       capacidadRafagas.size() == n;
+    for (std::size_t i = 0; consistente && i < n; i++) {
+        // Los pares del proceso deben caber en su espacio y el cursor ir de par en par
+        std::uint64_t limite = (std::uint64_t)inicioRafagas[i] + capacidadRafagas[i];
+        consistente = limite <= rafagas.size() && inicioRafagas[i] <= siguienteRafaga[i] &&
+                      siguienteRafaga[i] <= finRafagas[i] && finRafagas[i] <= limite &&
+                      (siguienteRafaga[i] - inicioRafagas[i]) % 2 == 0 && (finRafagas[i] - inicioRafagas[i]) % 2 == 0;
+    }
+    std::uint64_t totalTexto = 0;
+    for (std::uint32_t largo : largos) {
+        totalTexto += largo;
+    }
+    consistente = consistente && totalTexto == texto.size();
+    for (IdProceso id : libres) {
+        consistente = consistente && id < n;
+    }
+    if (!consistente) {
+        lector.fallar();
+        return false;
+    }
+    
+    etiquetas.resize(n);
+    capacidadEtiqueta.resize(n);
+    std::size_t posicion = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        char* copia = largos[i] == 0 ? nullptr : static_cast<char*>(memoria->allocate(largos[i], 1));
+        if (copia) {
+            std::memcpy(copia, texto.data() + posicion, largos[i]);
+        }
+        etiquetas[i] = std::string_view(copia, largos[i]);
+        capacidadEtiqueta[i] = largos[i];
+        posicion += largos[i];
+    }
+    return true;
+}
@@ -0,0 +1,194 @@
+#ifndef TABLAPROCESOS_H
+#define TABLAPROCESOS_H
+
+#include "Proceso.h"
+#include "Binario.h"
+#include "EscritorTexto.h"
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+
+// Identificador compacto de un proceso: su indice en la tabla
+typedef std::uint32_t IdProceso;
+
+/*
+  Datos de entrada de un proceso tal como vienen en el archivo
+  (etiqueta;BT;AT;Q;Pr[;rafagas]). La etiqueta y las rafagas son vistas
+  al texto original, no copias.
+  
+  BT es la primera rafaga de CPU. Las rafagas opcionales siguen con
+  pares E/S,CPU separados por comas: "10,4,20,2" significa que despues
+  de BT el proceso espera 10 unidades de E/S, ejecuta 4, espera 20 y
+  ejecuta 2 mas. Sin ese campo el proceso es una sola rafaga de CPU.
+ */
+struct RegistroProceso {
+    std::string_view etiqueta;
+    int tiempoRafaga;
+    int tiempoLlegada;
+    int cola;
+    int prioridad;
+    std::string_view rafagas;   // Pares E/S,CPU despues de la primera rafaga (vacio si no hay)
+};
+
+// Cantidad de numeros en un texto de rafagas ("10,4,20,2" tiene 4), o -1
+// si no es valido: cada numero debe ser positivo y deben venir en pares
+int contarRafagas(std::string_view texto);
+
+/*
+  Clase TablaProcesos
+  
+  Guarda todos los procesos de una simulacion como estructura de arreglos:
+  cada campo vive en su propio vector y el proceso es solo un indice de
+  32 bits. El bucle de simulacion toca pocos campos (rafaga, llegada,
+  tiempo restante, cola), asi que tenerlos contiguos evita saltar por
+  punteros a objetos dispersos en memoria.
+  
+  Las etiquetas se guardan aparte (tabla fria) porque solo se usan al
+  mostrar o escribir resultados. WT, RT y TAT no se guardan: se derivan
+  de CT, del tiempo de inicio y de los datos de entrada.
+  
+  Las rafagas de E/S y CPU de todos los procesos viven en un solo arreglo
+  de pares; cada proceso guarda donde empiezan las suyas y cual sigue.
+  Un proceso sin E/S no ocupa nada ahi. tiempoRafaga es el total de CPU
+  de todas las rafagas y tiempoRestante lo que falta de la rafaga actual.
+  
+  Toda la memoria de la tabla (columnas y texto de las etiquetas) sale del
+  recurso que se le da: la Arena de la simulacion, que la libera de una
+  vez, o en modo en linea una piscina que recicla lo que se libera (el
+  texto de una etiqueta reemplazada se devuelve).
+ */
+class TablaProcesos {
+private:
+    std::pmr::memory_resource* memoria;          // De donde sale la memoria
+    
+    // Columnas calientes
+    std::pmr::vector<int> tiempoRafaga;          // Tiempo total de CPU que necesita
+    std::pmr::vector<int> tiempoLlegada;         // Cuando llega al sistema
+    std::pmr::vector<int> tiempoRestante;        // Cuanto tiempo de CPU le falta
+    std::pmr::vector<int> cola;                  // Cola actual (0-indexed)
+    std::pmr::vector<int> colaOriginal;          // Cola donde empezo (1-indexed, como en la entrada)
+    std::pmr::vector<int> tiempoInicio;          // Primera ejecucion (SIN_INICIO si no ha ejecutado)
+    std::pmr::vector<int> tiempoFinalizacion;    // Cuando termino de ejecutar
+    
+    // Columnas frias
+    std::pmr::vector<int> prioridad;             // Valor de prioridad del proceso
+    std::pmr::vector<std::string_view> etiquetas;  // Nombre del proceso (texto copiado a 'memoria')
+    std::pmr::vector<std::uint32_t> capacidadEtiqueta;  // Bytes propios para la etiqueta (0 si no se copio)
+    
+    // Rafagas de E/S (pares E/S,CPU en 'rafagas', indices por proceso)
+    std::pmr::vector<int> rafagas;                      // Todos los pares de todos los procesos
+    std::pmr::vector<std::uint32_t> inicioRafagas;      // Primer par del proceso
+    std::pmr::vector<std::uint32_t> siguienteRafaga;    // Siguiente par por usar
+    std::pmr::vector<std::uint32_t> finRafagas;         // Fin de sus pares
+    std::pmr::vector<std::uint32_t> capacidadRafagas;   // Espacio propio en 'rafagas' (para reutilizar el id)
+    std::vector<int> temporalRafagas;                   // Rafagas recien leidas de un texto
+    
+    std::pmr::vector<IdProceso> libres;          // Ids liberados, para reutilizar
+    
+    // Toma un id libre o agrega una fila nueva, con los datos de entrada
+    // (sin la etiqueta ni las rafagas de E/S)
+    IdProceso nuevaFila(int bt, int at, int q, int pr);
+    
+    // Copia los pares E/S,CPU de un proceso y suma su CPU a la rafaga total
+    void ponerRafagas(IdProceso id, const int* datos, std::size_t cantidad);
+
+public:
+    static constexpr int SIN_INICIO = INT_MIN;
+    
+    // Crea la tabla vacia tomando la memoria de 'm' (la arena de la simulacion)
+    explicit TablaProcesos(std::pmr::memory_resource& m);
+    
+    // Asegura espacio para n procesos en total en todas las columnas
+    void reservar(std::size_t n);
+    
+    // Agrega un proceso y retorna su id (la etiqueta se copia a 'memoria')
+    IdProceso agregar(std::string_view etiqueta, int bt, int at, int q, int pr,
+                      const std::vector<int>& rafagasES = std::vector<int>());
+    IdProceso agregar(const Proceso& proceso);
+    
+    // Agrega un proceso sin copiar la etiqueta: el texto al que apunta el
+    // registro debe seguir vivo mientras se use la tabla
+    IdProceso agregar(const RegistroProceso& registro);
+    
+    // Pone a un proceso recien agregado las rafagas de E/S de un texto
+    // "E/S,CPU,..." ya validado con contarRafagas
+    void ponerRafagas(IdProceso id, std::string_view texto);
+    
+    // Devuelve el id para que lo use un proceso nuevo. El texto de la
+    // etiqueta (si la tabla lo copio) se reutiliza con el id.
+    void liberar(IdProceso id) { libres.push_back(id); }
+    
+    // Filas de la tabla, incluyendo las liberadas
+    std::size_t tamano() const { return tiempoRafaga.size(); }
+    
+    // Getters por id
+    std::string_view getEtiqueta(IdProceso id) const { return etiquetas[id]; }
+    int getTiempoRafaga(IdProceso id) const { return tiempoRafaga[id]; }
+    int getTiempoLlegada(IdProceso id) const { return tiempoLlegada[id]; }
+    int getTiempoRestante(IdProceso id) const { return tiempoRestante[id]; }
+    int getCola(IdProceso id) const { return cola[id]; }
+    int getColaOriginal(IdProceso id) const { return colaOriginal[id]; }
+    int getPrioridad(IdProceso id) const { return prioridad[id]; }
+    int getTiempoInicio(IdProceso id) const { return tiempoInicio[id]; }
+    int getTiempoFinalizacion(IdProceso id) const { return tiempoFinalizacion[id]; }
+    bool getHaIniciado(IdProceso id) const { return tiempoInicio[id] != SIN_INICIO; }
+    bool estaCompleto(IdProceso id) const { return tiempoRestante[id] <= 0 && !tieneES(id); }
+    
+    // Rafagas de E/S: si aun le queda alguna y si termino la rafaga de CPU actual
+    bool tieneES(IdProceso id) const { return siguienteRafaga[id] < finRafagas[id]; }
+    bool rafagaTerminada(IdProceso id) const { return tiempoRestante[id] <= 0; }
+    
+    // Pasa a la siguiente E/S: deja lista la rafaga de CPU que sigue y
+    // retorna cuanto dura la E/S (solo si rafagaTerminada y tieneES)
+    int iniciarES(IdProceso id) {
+        std::uint32_t par = siguienteRafaga[id];
+        siguienteRafaga[id] = par + 2;
+        tiempoRestante[id] = rafagas[par + 1];
+        return rafagas[par];
+    }
+    
+    // Duracion de la ultima E/S iniciada (0 si no ha hecho ninguna)
+    int getUltimaES(IdProceso id) const {
+        return siguienteRafaga[id] > inicioRafagas[id] ? rafagas[siguienteRafaga[id] - 2] : 0;
+    }
+    
+    // Tiempo total de E/S del proceso
+    int getTiempoES(IdProceso id) const;
+    
+    // Pares E/S,CPU del proceso, en orden
+    std::vector<int> getRafagasES(IdProceso id) const;
+    
+    // Metricas derivadas (validas cuando el proceso termino). El tiempo
+    // bloqueado en E/S no cuenta como espera.
+    int getTiempoRetorno(IdProceso id) const { return tiempoFinalizacion[id] - tiempoLlegada[id]; }
+    int getTiempoRespuesta(IdProceso id) const { return tiempoInicio[id] - tiempoLlegada[id]; }
+    int getTiempoEspera(IdProceso id) const { return getTiempoRetorno(id) - tiempoRafaga[id] - getTiempoES(id); }
+    
+    // Setters para que el scheduler actualice el estado
+    void setCola(IdProceso id, int c) { cola[id] = c; }
+    void setTiempoInicio(IdProceso id, int ti) { tiempoInicio[id] = ti; }
+    void setTiempoFinalizacion(IdProceso id, int tf) { tiempoFinalizacion[id] = tf; }
+    
+    // Simula la ejecucion de una rebanada de varias unidades de tiempo
+    void ejecutar(IdProceso id, int tiempoActual, int unidades);
+    
+    // Escribe la linea de salida de un proceso terminado
+    // (etiqueta;BT;AT;Q;Pr;WT;CT;RT;TAT)
+    void escribirLinea(EscritorTexto& salida, IdProceso id) const;
+    void escribirLinea(std::ostream& salida, IdProceso id) const;
+    
+    // Construye un Proceso con el estado actual (para mostrar o reportar)
+    Proceso obtenerProceso(IdProceso id) const;
+    
+    // Checkpoint de todas las columnas, las etiquetas, las rafagas y los ids libres.
+    // Al cargar, las etiquetas se copian a 'memoria' (la tabla debe estar vacia).
+    void guardar(EscritorBinario& escritor) const;
+    bool cargar(LectorBinario& lector);
+};
+
+#endif
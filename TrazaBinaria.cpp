@@ -0,0 +1,261 @@
+#include "TrazaBinaria.h"
+#include <cstring>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+const char MAGIA_TRAZA[8] = {'M', 'L', 'F', 'Q', 'T', 'R', 'Z', '1'};
+const char MAGIA_PIE[8] = {'F', 'I', 'N', 'T', 'R', 'Z', '0', '1'};
+const std::uint32_t VERSION_TRAZA = 1;
+
+// Magia, version y cantidad de niveles
+const std::size_t TAMANO_ENCABEZADO = 8 + 4 + 4;
+
+// Inicio de las etiquetas, cantidad de registros y magia
+const std::size_t TAMANO_PIE = 8 + 8 + 8;
+
+// Mas niveles que esto no caben en el campo del registro
+const std::uint32_t MAX_NIVELES_TRAZA = UINT16_MAX + 1;
+
+// Lee un valor sin importar la alineacion
+template<typename T>
+T leerEn(const char* p) {
+    T valor;
+    std::memcpy(&valor, p, sizeof(T));
+    return valor;
+}
+
+}
+
+const char* nombreMotivo(std::uint8_t motivo) {
+    switch ((MotivoRebanada)motivo) {
+        case MotivoRebanada::QUANTUM: return "quantum";
+        case MotivoRebanada::FIN: return "fin";
+        case MotivoRebanada::EXPROPIACION: return "expropiacion";
+        case MotivoRebanada::BLOQUEO: return "es";
+    }
+    return "desconocido";
+}
+
+/*
+  Constructor del escritor
+  
+  Crea el archivo y escribe el encabezado con la politica y el quantum de
+  cada nivel. Si el archivo no se pudo crear, abierto() da false y lo que
+  se agregue se descarta.
+ */
+EscritorTrazaBinaria::EscritorTrazaBinaria(const std::string& ruta, const std::vector<NivelTraza>& niveles)
+    : archivo(ruta, std::ios::binary | std::ios::trunc), escritor(archivo), cantidad(0), posicion(0) {
+    std::uint32_t cantidadNiveles = (std::uint32_t)niveles.size();
+    escribirBytes(MAGIA_TRAZA, sizeof(MAGIA_TRAZA));
+    escribirBytes(&VERSION_TRAZA, sizeof(VERSION_TRAZA));
+    escribirBytes(&cantidadNiveles, sizeof(cantidadNiveles));
+    escribirBytes(niveles.data(), niveles.size() * sizeof(NivelTraza));
+}
+
+void EscritorTrazaBinaria::escribirBytes(const void* datos, std::size_t bytes) {
+    escritor.escribir(std::string_view(static_cast<const char*>(datos), bytes));
+    posicion += bytes;
+}
+
+/*
+  Cierra la traza
+  
+  Despues del ultimo registro van las etiquetas de todos los procesos de
+  la tabla (el id de cada registro es su indice aqui) y el pie. Se espera
+  a que el hilo escritor vacie todo antes de revisar el archivo.
+ */
+bool EscritorTrazaBinaria::terminar(const TablaProcesos& tabla) {
+    std::uint64_t inicioEtiquetas = posicion;
+    std::uint64_t procesos = tabla.tamano();
+    escribirBytes(&procesos, sizeof(procesos));
+    for (IdProceso id = 0; id < procesos; id++) {
+        std::uint32_t largo = (std::uint32_t)tabla.getEtiqueta(id).size();
+        escribirBytes(&largo, sizeof(largo));
+    }
+    for (IdProceso id = 0; id < procesos; id++) {
+        std::string_view etiqueta = tabla.getEtiqueta(id);
+        escribirBytes(etiqueta.data(), etiqueta.size());
+    }
+    
+    escribirBytes(&inicioEtiquetas, sizeof(inicioEtiquetas));
+    escribirBytes(&cantidad, sizeof(cantidad));
+    escribirBytes(MAGIA_PIE, sizeof(MAGIA_PIE));
+    
+    escritor.terminar();
+    archivo.flush();
+    bool ok = archivo.good();
+    archivo.close();
+    return ok;
+}
+
+TrazaBinaria::TrazaBinaria()
+    : datos(nullptr), tamano(0), mapeado(false), registros(nullptr), cantidad(0) {
+}
+
+TrazaBinaria::~TrazaBinaria() {
+    cerrar();
+}
+
+void TrazaBinaria::cerrar() {
+#ifndef _WIN32
+    if (mapeado) {
+        munmap(const_cast<char*>(datos), tamano);
+    }
+#endif
+    datos = nullptr;
+    tamano = 0;
+    mapeado = false;
+    buffer.clear();
+    niveles.clear();
+    registros = nullptr;
+    cantidad = 0;
+    etiquetas.clear();
+}
+
+/*
+  Abre una traza binaria
+  
+  Mapea el archivo en memoria (o lo lee completo si no se puede) y lo
+  valida. Los registros no se copian: getRegistro los lee del mapeo.
+ */
+bool TrazaBinaria::abrir(const std::string& ruta) {
+    cerrar();
+    error.clear();
+
+#ifndef _WIN32
+    int fd = open(ruta.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "no se pudo abrir el archivo";
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        error = "no se pudo abrir el archivo";
+        return false;
+    }
+    
+    tamano = (std::size_t)info.st_size;
+    if (tamano > 0) {
+        void* mapa = mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            madvise(mapa, tamano, MADV_SEQUENTIAL);
+            datos = static_cast<const char*>(mapa);
+            mapeado = true;
+        }
+    }
+    close(fd);
+#endif
+    
+    // Sin mmap (Windows o si fallo el mapeo) se lee el archivo completo a memoria
+    if (!mapeado) {
+        std::ifstream entrada(ruta, std::ios::binary);
+        if (!entrada.is_open()) {
+            error = "no se pudo abrir el archivo";
+            return false;
+        }
+        std::ostringstream contenido;
+        contenido << entrada.rdbuf();
+        buffer = contenido.str();
+        datos = buffer.data();
+        tamano = buffer.size();
+    }
+    
+    if (!validar()) {
+        std::string motivo = error;
+        cerrar();
+        error = motivo;
+        return false;
+    }
+    return true;
+}
+
+/*
+  Revisa que el archivo sea una traza completa
+  
+  Todas las posiciones se calculan a partir del pie y se comparan con el
+  tamano del archivo antes de leer, asi un archivo cortado o ajeno se
+  rechaza sin leer fuera del mapeo.
+ */
+bool TrazaBinaria::validar() {
+    if (tamano < TAMANO_ENCABEZADO + TAMANO_PIE || std::memcmp(datos, MAGIA_TRAZA, sizeof(MAGIA_TRAZA)) != 0) {
+        error = "no es una traza binaria";
+        return false;
+    }
+    if (leerEn<std::uint32_t>(datos + 8) != VERSION_TRAZA) {
+        error = "version de traza no soportada";
+        return false;
+    }
+    
+    const char* pie = datos + tamano - TAMANO_PIE;
+    if (std::memcmp(pie + 16, MAGIA_PIE, sizeof(MAGIA_PIE)) != 0) {
+        error = "la traza esta incompleta (falta el pie)";
+        return false;
+    }
+    std::uint64_t inicioEtiquetas = leerEn<std::uint64_t>(pie);
+    std::uint64_t registrosPie = leerEn<std::uint64_t>(pie + 8);
+    
+    // Niveles
+    std::uint32_t cantidadNiveles = leerEn<std::uint32_t>(datos + 12);
+    std::size_t finNiveles = TAMANO_ENCABEZADO + (std::size_t)cantidadNiveles * sizeof(NivelTraza);
+    if (cantidadNiveles == 0 || cantidadNiveles > MAX_NIVELES_TRAZA || finNiveles > tamano - TAMANO_PIE) {
+        error = "encabezado de traza corrupto";
+        return false;
+    }
+    niveles.resize(cantidadNiveles);
+    std::memcpy(niveles.data(), datos + TAMANO_ENCABEZADO, cantidadNiveles * sizeof(NivelTraza));
+    
+    // Registros: tienen que llenar justo el espacio hasta las etiquetas
+    if (inicioEtiquetas < finNiveles || inicioEtiquetas > tamano - TAMANO_PIE ||
+        (inicioEtiquetas - finNiveles) % sizeof(RegistroRebanada) != 0 ||
+        (inicioEtiquetas - finNiveles) / sizeof(RegistroRebanada) != registrosPie) {
+        error = "la cantidad de registros no coincide con el archivo";
+        return false;
+    }
+    registros = datos + finNiveles;
+    cantidad = (std::size_t)registrosPie;
+    
+    // Etiquetas: cantidad, largos y texto, que deben terminar justo en el pie
+    std::size_t p = (std::size_t)inicioEtiquetas;
+    std::size_t finEtiquetas = tamano - TAMANO_PIE;
+    if (finEtiquetas - p < sizeof(std::uint64_t)) {
+        error = "tabla de etiquetas corrupta";
+        return false;
+    }
+    std::uint64_t procesos = leerEn<std::uint64_t>(datos + p);
+    p += sizeof(std::uint64_t);
+    if (procesos > (finEtiquetas - p) / sizeof(std::uint32_t)) {
+        error = "tabla de etiquetas corrupta";
+        return false;
+    }
+    const char* largos = datos + p;
+    std::size_t texto = p + (std::size_t)procesos * sizeof(std::uint32_t);
+    etiquetas.reserve((std::size_t)procesos);
+    for (std::uint64_t i = 0; i < procesos; i++) {
+        std::uint32_t largo = leerEn<std::uint32_t>(largos + i * sizeof(std::uint32_t));
+        if (largo > finEtiquetas - texto) {
+            error = "tabla de etiquetas corrupta";
+            return false;
+        }
+        etiquetas.push_back(std::string_view(datos + texto, largo));
+        texto += largo;
+    }
+    if (texto != finEtiquetas) {
+        error = "tabla de etiquetas corrupta";
+        return false;
+    }
+    return true;
+}
+
+RegistroRebanada TrazaBinaria::getRegistro(std::size_t i) const {
+    return leerEn<RegistroRebanada>(registros + i * sizeof(RegistroRebanada));
+}
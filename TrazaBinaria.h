@@ -0,0 +1,148 @@
+#ifndef TRAZABINARIA_H
+#define TRAZABINARIA_H
+
+#include "ColaNivel.h"
+#include "EscritorAsincrono.h"
+#include "TablaProcesos.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+  Traza binaria de rebanadas
+  
+  Cada rebanada se guarda como un registro de 16 bytes, todos del mismo
+  ancho, asi el archivo se puede mapear y leer el registro i sin recorrer
+  los anteriores. El archivo tiene cuatro partes:
+  
+  1. Encabezado: magia "MLFQTRZ1", version, cantidad de niveles y, por
+     cada nivel, su politica y su quantum.
+  2. Registros: uno por rebanada, en el orden en que se ejecutaron.
+  3. Etiquetas: cantidad de procesos, el largo de cada etiqueta y despues
+     todo el texto seguido (se escriben al final porque con la traza
+     abierta todavia pueden llegar procesos nuevos).
+  4. Pie: donde empiezan las etiquetas, cuantos registros hay y la magia
+     "FINTRZ01". Un archivo sin pie quedo cortado y no se acepta.
+  
+  Los enteros van en el orden de bytes de la maquina, igual que los
+  checkpoints.
+ */
+
+// Por que termino una rebanada
+enum class MotivoRebanada : std::uint8_t {
+    QUANTUM = 0,        // Se acabo el quantum (RR) y el proceso bajo de cola
+    FIN = 1,            // El proceso termino
+    EXPROPIACION = 2,   // STCF lo saco porque podia cambiar quien ejecuta
+    BLOQUEO = 3         // Termino una rafaga de CPU y se bloqueo en E/S
+};
+
+// Una rebanada de ejecucion
+struct RegistroRebanada {
+    std::int32_t inicio;     // Tiempo en que empezo
+    std::int32_t duracion;   // Unidades que ejecuto
+    std::uint32_t proceso;   // Id del proceso (indice en la tabla de etiquetas)
+    std::uint16_t nivel;     // Cola en la que ejecuto (desde 0)
+    std::uint8_t motivo;     // MotivoRebanada
+    std::uint8_t reservado;  // Siempre 0
+};
+static_assert(sizeof(RegistroRebanada) == 16, "RegistroRebanada debe medir 16 bytes");
+
+// Politica y quantum de un nivel, como quedan en el encabezado
+struct NivelTraza {
+    std::int32_t politica;   // TipoPolitica
+    std::int32_t quantum;    // -1 si no es RR
+};
+
+// Nombre corto de un motivo ("quantum", "fin", "expropiacion")
+const char* nombreMotivo(std::uint8_t motivo);
+
+/*
+  Clase EscritorTrazaBinaria
+  
+  Escribe la traza binaria mientras corre la simulacion. Los registros se
+  copian al buffer de un EscritorAsincrono, asi que agregar una rebanada
+  no toca el disco. terminar() agrega las etiquetas y el pie; si no se
+  llama, el archivo queda sin pie y el lector lo rechaza.
+ */
+class EscritorTrazaBinaria {
+private:
+    std::ofstream archivo;
+    EscritorAsincrono escritor;     // Escribe al archivo en otro hilo
+    std::uint64_t cantidad;         // Registros escritos
+    std::uint64_t posicion;         // Bytes escritos hasta ahora
+    
+    // Copia bytes crudos al escritor
+    void escribirBytes(const void* datos, std::size_t bytes);
+
+public:
+    EscritorTrazaBinaria(const std::string& ruta, const std::vector<NivelTraza>& niveles);
+    
+    EscritorTrazaBinaria(const EscritorTrazaBinaria&) = delete;
+    EscritorTrazaBinaria& operator=(const EscritorTrazaBinaria&) = delete;
+    
+    // false si el archivo no se pudo crear
+    bool abierto() const { return archivo.is_open(); }
+    
+    void agregar(const RegistroRebanada& registro) {
+        escribirBytes(&registro, sizeof(registro));
+        cantidad++;
+    }
+    
+    // Escribe las etiquetas de la tabla y el pie, y cierra el archivo.
+    // Retorna false si algo no se pudo escribir
+    bool terminar(const TablaProcesos& tabla);
+};
+
+/*
+  Clase TrazaBinaria
+  
+  Lee una traza binaria. El archivo se mapea a memoria (con copia
+  completa como respaldo, como ArchivoTrazas) y los registros se leen
+  directo del mapeo. Las etiquetas son vistas al archivo, asi que la
+  TrazaBinaria tiene que seguir viva mientras se usen.
+ */
+class TrazaBinaria {
+private:
+    const char* datos;                       // Contenido del archivo
+    std::size_t tamano;                      // Bytes del archivo
+    bool mapeado;                            // true si datos viene de mmap
+    std::string buffer;                      // Copia del archivo si no se pudo mapear
+    std::vector<NivelTraza> niveles;         // Politica y quantum de cada nivel
+    const char* registros;                   // Primer registro
+    std::size_t cantidad;                    // Cantidad de registros
+    std::vector<std::string_view> etiquetas; // Etiqueta de cada proceso
+    std::string error;                       // Por que fallo abrir()
+    
+    // Revisa el encabezado, el pie y las etiquetas
+    bool validar();
+    
+    // Libera el mapeo o el buffer actual
+    void cerrar();
+
+public:
+    TrazaBinaria();
+    ~TrazaBinaria();
+    
+    TrazaBinaria(const TrazaBinaria&) = delete;
+    TrazaBinaria& operator=(const TrazaBinaria&) = delete;
+    
+    // Mapea y valida el archivo; si falla, getError() dice por que
+    bool abrir(const std::string& ruta);
+    
+    std::size_t getCantidad() const { return cantidad; }
+    const std::vector<NivelTraza>& getNiveles() const { return niveles; }
+    const std::string& getError() const { return error; }
+    
+    // Registro i (0 <= i < getCantidad())
+    RegistroRebanada getRegistro(std::size_t i) const;
+    
+    // Etiqueta de un proceso; vacia si el id no esta en la tabla
+    std::string_view getEtiqueta(std::uint32_t proceso) const {
+        return proceso < etiquetas.size() ? etiquetas[proceso] : std::string_view();
+    }
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include "../GeneradorCargas.h"
+#include "../MLFQScheduler.h"
+#include "../MLFQEstatico.h"
+#include "../Esquemas.h"
+#include "../ArchivosSalida.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+  Benchmark del scheduler
+  
+  Para cada esquema y cada tamano de carga (10^3, 10^4, ... hasta el
+  maximo pedido) mide por separado cuanto tardan agregar los procesos,
+  ejecutarSimulacion y escribirSalida, y reporta procesos por segundo.
+  La columna 'escala' compara el tiempo de simulacion con el del tamano
+  anterior: 1.00 es crecimiento lineal, valores mayores indican que el
+  costo por proceso sube con el tamano.
+  
+  Uso: benchmark [max_procesos] [esquemas...]
+  Por defecto llega a 10^6 procesos con los esquemas 1, 2 y 3. La carga
+  es Poisson con carga cercana a 1 (semilla fija), asi que las corridas
+  son comparables entre versiones.
+  
+  Los esquemas predefinidos se miden dos veces: con MLFQScheduler y con
+  su version compilada de MLFQEstatico.h (filas "1c", "2c", "3c").
+ */
+
+typedef std::chrono::steady_clock Reloj;
+
+// Segundos transcurridos desde 'inicio'
+static double segundosDesde(Reloj::time_point inicio) {
+    return std::chrono::duration<double>(Reloj::now() - inicio).count();
+}
+
+// Tiempos de una corrida (el mejor de las repeticiones en cada fase)
+struct Medicion {
+    double agregar = 1e300;
+    double simular = 1e300;
+    double escribir = 1e300;
+};
+
+template <typename Scheduler>
+static Medicion medir(Scheduler& scheduler, const std::vector<RegistroProceso>& registros,
+                      const std::string& archivoSalida, int repeticiones) {
+    Medicion mejor;
+    
+    for (int r = 0; r < repeticiones; r++) {
+        if (r > 0) {
+            scheduler.reiniciar();
+        }
+        
+        Reloj::time_point inicio = Reloj::now();
+        scheduler.agregarProcesos(registros);
+        mejor.agregar = std::min(mejor.agregar, segundosDesde(inicio));
+        
+        inicio = Reloj::now();
+        scheduler.ejecutarSimulacion();
+        mejor.simular = std::min(mejor.simular, segundosDesde(inicio));
+        
+        inicio = Reloj::now();
+        scheduler.escribirSalida(archivoSalida);
+        mejor.escribir = std::min(mejor.escribir, segundosDesde(inicio));
+    }
+    return mejor;
+}
+
+// Mide un esquema con el scheduler de tiempo de ejecucion o con su
+// version compilada
+static Medicion medirEsquema(int numero, bool compilado, const std::vector<EsquemaCola>& esquemas,
+                             const std::vector<RegistroProceso>& registros,
+                             const std::string& archivoSalida, int repeticiones) {
+    if (compilado) {
+        switch (numero) {
+            case 1: { MLFQEsquema1 scheduler; return medir(scheduler, registros, archivoSalida, repeticiones); }
+            case 2: { MLFQEsquema2 scheduler; return medir(scheduler, registros, archivoSalida, repeticiones); }
+            case 3: { MLFQEsquema3 scheduler; return medir(scheduler, registros, archivoSalida, repeticiones); }
+        }
+    }
+    MLFQScheduler scheduler(esquemas);
+    scheduler.setVerbosidad(Verbosidad::NINGUNA);
+    return medir(scheduler, registros, archivoSalida, repeticiones);
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t maxProcesos = argc >= 2 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::vector<int> numerosEsquema;
+    for (int i = 2; i < argc; i++) {
+        numerosEsquema.push_back(std::atoi(argv[i]));
+    }
+    if (numerosEsquema.empty()) {
+        numerosEsquema = {1, 2, 3};
+    }
+    
+    crearCarpetaSalida();
+    std::string archivoSalida = nombreArchivoSalida("benchmark");
+    
+    std::cout << "# esquema; procesos; agregar(s); simular(s); escribir(s); "
+              << "agregar(proc/s); simular(proc/s); escribir(proc/s); escala" << std::endl;
+    
+    // Las cargas se generan una sola vez y se comparten entre esquemas
+    std::vector<std::size_t> tamanos;
+    for (std::size_t n = 1000; n <= maxProcesos; n *= 10) {
+        tamanos.push_back(n);
+    }
+    
+    std::vector<std::string> etiquetas(tamanos.size());
+    std::vector<std::vector<RegistroProceso>> cargas(tamanos.size());
+    for (std::size_t i = 0; i < tamanos.size(); i++) {
+        ConfiguracionCarga config;
+        config.cantidad = tamanos[i];
+        config.tasaLlegada = 0.09;
+        generarCarga(config, etiquetas[i], cargas[i]);
+    }
+    
+    for (int numero : numerosEsquema) {
+        std::vector<EsquemaCola> esquemas = obtenerEsquema(numero, false);
+        if (esquemas.empty()) {
+            return 1;
+        }
+        
+        for (int version = 0; version < (numero >= 1 && numero <= 3 ? 2 : 1); version++) {
+            bool compilado = version == 1;
+            double simularAnterior = 0.0;
+            
+            for (std::size_t i = 0; i < tamanos.size(); i++) {
+                std::size_t n = tamanos[i];
+                // Repetir mas las cargas pequenas para que el tiempo sea medible
+                int repeticiones = n <= 10000 ? 5 : (n <= 100000 ? 3 : 1);
+                Medicion m = medirEsquema(numero, compilado, esquemas, cargas[i], archivoSalida, repeticiones);
+                
+                std::cout << std::fixed << std::setprecision(4)
+                          << numero << (compilado ? "c" : "") << "; " << n << "; "
+                          << m.agregar << "; " << m.simular << "; " << m.escribir << "; "
+                          << std::setprecision(0)
+                          << n / m.agregar << "; " << n / m.simular << "; " << n / m.escribir << "; ";
+                if (simularAnterior > 0) {
+                    std::cout << std::setprecision(2) << m.simular / (simularAnterior * 10);
+                } else {
+                    std::cout << "-";
+                }
+                std::cout << std::endl;
+                simularAnterior = m.simular;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "../SalidaColumnar.h"
+#include "../EscritorTexto.h"
+#include "../OrdenExterno.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/*
+  Conversor de archivos columnares a texto
+  
+  Lee un archivo guardado con --columnas y escribe el mismo formato del
+  archivo de salida: encabezado, una linea por fila y los promedios de
+  WT, CT, RT y TAT calculados de las columnas. Sirve para revisar el
+  archivo o para pasarlo a herramientas que solo leen texto.
+  
+  Uso: columnas <archivo> [--salida archivo] [--ordenado MB]
+    --salida    archivo de texto (por defecto, la pantalla)
+    --ordenado  ordena las lineas por etiqueta con hasta MB megabytes en
+                memoria (el resto en temporales); sin esta opcion salen
+                en el orden del archivo, que es el de finalizacion
+  
+  Los grupos se leen de a uno, asi la memoria no depende de la cantidad
+  de filas.
+ */
+
+static void mostrarUso(const char* programa) {
+    std::cerr << "Uso: " << programa << " <archivo> [--salida archivo] [--ordenado MB]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+    
+    std::string rutaColumnas = argv[1];
+    std::string rutaSalida;
+    long long megasOrden = 0;
+    
+    for (int i = 2; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (i + 1 >= argc) {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+        std::string valor = argv[++i];
+        
+        if (opcion == "--salida") rutaSalida = valor;
+        else if (opcion == "--ordenado") megasOrden = std::max(1LL, std::atoll(valor.c_str()));
+        else { mostrarUso(argv[0]); return 1; }
+    }
+    
+    LectorColumnar lector;
+    if (!lector.abrir(rutaColumnas)) {
+        std::cerr << "Error al leer " << rutaColumnas << ": " << lector.getError() << std::endl;
+        return 1;
+    }
+    
+    std::ofstream archivo;
+    if (!rutaSalida.empty()) {
+        archivo.open(rutaSalida, std::ios::binary);
+        if (!archivo.is_open()) {
+            std::cerr << "Error al abrir el archivo de salida: " << rutaSalida << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& destino = rutaSalida.empty() ? std::cout : archivo;
+    
+    std::unique_ptr<OrdenadorExterno> ordenador;
+    if (megasOrden > 0) {
+        ordenador = std::make_unique<OrdenadorExterno>((std::size_t)megasOrden << 20);
+    }
+    
+    bool ok = true;
+    {
+        EscritorTexto salida(destino);
+        EscritorTexto linea(nullptr, 256);
+        salida.texto("# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n");
+        
+        // Sumas de WT, CT, RT y TAT para los promedios
+        long long sumas[4] = {0, 0, 0, 0};
+        std::array<std::vector<std::int32_t>, COLUMNAS_RESULTADO> columnas;
+        while (lector.siguienteGrupo(columnas)) {
+            for (std::size_t f = 0; f < columnas[0].size(); f++) {
+                std::string_view etiqueta = lector.getEtiqueta((std::uint32_t)columnas[0][f]);
+                EscritorTexto& destinoLinea = ordenador ? linea : salida;
+                destinoLinea.texto(etiqueta);
+                for (std::size_t c = 1; c < COLUMNAS_RESULTADO; c++) {
+                    destinoLinea.caracter(';');
+                    destinoLinea.entero(columnas[c][f]);
+                }
+                destinoLinea.caracter('\n');
+                if (ordenador) {
+                    ordenador->agregar(etiqueta, linea.contenido());
+                    linea.limpiar();
+                }
+                for (std::size_t m = 0; m < 4; m++) {
+                    sumas[m] += columnas[5 + m][f];
+                }
+            }
+        }
+        if (!lector.getError().empty()) {
+            std::cerr << "Error al leer " << rutaColumnas << ": " << lector.getError() << std::endl;
+            ok = false;
+        }
+        if (ordenador && !ordenador->terminar(salida)) {
+            std::cerr << "Error al ordenar la salida: " << ordenador->getError() << std::endl;
+            ok = false;
+        }
+        
+        // Mismo formato que la ultima linea del archivo de salida
+        const char* nombres[4] = {"WT=", ";CT=", ";RT=", ";TAT="};
+        double filas = (double)std::max<std::uint64_t>(1, lector.getFilas());
+        for (std::size_t m = 0; m < 4; m++) {
+            salida.texto(nombres[m]);
+            salida.decimal(lector.getFilas() == 0 ? 0.0 : sumas[m] / filas, 1);
+        }
+        salida.texto(";\n");
+    }
+    
+    destino.flush();
+    if (!destino) {
+        std::cerr << "Error al escribir el texto" << std::endl;
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
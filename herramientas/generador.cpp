@@ -0,0 +1,71 @@
+#include "../GeneradorCargas.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/*
+  Generador de cargas sinteticas
+  
+  Escribe un archivo de procesos en el formato de entrada del simulador.
+  
+  Uso: generador <cantidad> [opciones]
+    --salida <archivo>                              (por defecto, la pantalla)
+    --llegadas simultaneas|uniformes|poisson|rafagas
+    --tasa <procesos por unidad de tiempo>
+    --grupo <procesos por rafaga de llegadas>
+    --rafaga constante|uniforme|exponencial|bimodal|lognormal|pareto
+    --min <BT minimo>  --max <BT maximo>  --media <BT medio>
+    --cortos <fraccion de procesos cortos en bimodal>
+    --sigma <desviacion del logaritmo en lognormal>  --alfa <forma de pareto>
+    --colas <peso1,peso2,...>                       (mezcla de colas iniciales)
+    --prioridad <prioridad maxima>
+    --ciclos <pares E/S,CPU por proceso>  --es <E/S media>
+    --semilla <n>
+ */
+
+static void mostrarUso(const char* programa) {
+    std::cerr << "Uso: " << programa << " <cantidad> [--salida archivo]"
+              << " [--llegadas simultaneas|uniformes|poisson|rafagas] [--tasa x] [--grupo n]"
+              << " [--rafaga constante|uniforme|exponencial|bimodal|lognormal|pareto] [--min n] [--max n] [--media n]"
+              << " [--cortos f] [--sigma f] [--alfa f] [--colas p1,p2,...] [--prioridad n] [--ciclos n] [--es n] [--semilla n]" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+    
+    ConfiguracionCarga config;
+    config.cantidad = std::strtoull(argv[1], nullptr, 10);
+    std::string rutaSalida;
+    
+    for (int i = 2; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (i + 1 >= argc) {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+        std::string valor = argv[++i];
+        
+        if (opcion == "--salida") rutaSalida = valor;
+        else if (!leerOpcionCarga(opcion, valor, config)) {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (rutaSalida.empty()) {
+        escribirCarga(std::cout, config);
+        return 0;
+    }
+    
+    std::ofstream salida(rutaSalida);
+    if (!salida.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << rutaSalida << std::endl;
+        return 1;
+    }
+    escribirCarga(salida, config);
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "../TrazaBinaria.h"
+#include "../EscritorTexto.h"
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+/*
+  Conversor de trazas binarias a JSON de Chrome
+  
+  Lee una traza guardada con --traza-binaria y escribe el formato de
+  eventos de Chrome ({"traceEvents": [...]}), que abren chrome://tracing
+  y ui.perfetto.dev. Cada rebanada es un evento completo ("ph": "X") en
+  la pista de su cola, con la etiqueta del proceso como nombre y el
+  motivo de fin como argumento. Una unidad de tiempo de la simulacion se
+  muestra como un microsegundo.
+  
+  Uso: trazajson <traza> [--salida archivo] [--desde t] [--hasta t]
+    --salida   archivo JSON (por defecto, la pantalla)
+    --desde    solo rebanadas que terminan despues de t
+    --hasta    solo rebanadas que empiezan antes de t
+  
+  Como los registros estan en orden de tiempo y todos miden lo mismo,
+  el inicio de la ventana se busca por biseccion sobre el archivo mapeado
+  sin recorrer lo anterior.
+ */
+
+static void mostrarUso(const char* programa) {
+    std::cerr << "Uso: " << programa << " <traza> [--salida archivo] [--desde t] [--hasta t]" << std::endl;
+}
+
+/*
+  Texto entre comillas, escapando lo que JSON no acepta tal cual
+ */
+static void cadenaJSON(EscritorTexto& salida, std::string_view t) {
+    static const char HEX[] = "0123456789abcdef";
+    salida.caracter('"');
+    for (char c : t) {
+        unsigned char u = (unsigned char)c;
+        if (c == '"' || c == '\\') {
+            salida.caracter('\\');
+            salida.caracter(c);
+        } else if (u < 0x20) {
+            salida.texto("\\u00");
+            salida.caracter(HEX[u >> 4]);
+            salida.caracter(HEX[u & 0xf]);
+        } else {
+            salida.caracter(c);
+        }
+    }
+    salida.caracter('"');
+}
+
+// Nombre de la pista de un nivel, como en la traza de texto: "Cola 1 (RR-2)"
+static std::string nombreNivel(std::size_t nivel, const NivelTraza& datos) {
+    std::string nombre = "Cola " + std::to_string(nivel + 1);
+    switch ((TipoPolitica)datos.politica) {
+        case TipoPolitica::ROUND_ROBIN: return nombre + " (RR-" + std::to_string(datos.quantum) + ")";
+        case TipoPolitica::SJF: return nombre + " (SJF)";
+        case TipoPolitica::STCF: return nombre + " (STCF)";
+    }
+    return nombre;
+}
+
+// Primer registro que termina despues de t (los fines crecen con el indice)
+static std::size_t buscarDesde(const TrazaBinaria& traza, long long t) {
+    std::size_t bajo = 0, alto = traza.getCantidad();
+    while (bajo < alto) {
+        std::size_t medio = bajo + (alto - bajo) / 2;
+        RegistroRebanada r = traza.getRegistro(medio);
+        if ((long long)r.inicio + r.duracion <= t) bajo = medio + 1;
+        else alto = medio;
+    }
+    return bajo;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+    
+    std::string rutaTraza = argv[1];
+    std::string rutaSalida;
+    long long desde = LLONG_MIN;
+    long long hasta = LLONG_MAX;
+    
+    for (int i = 2; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (i + 1 >= argc) {
+            mostrarUso(argv[0]);
+            return 1;
+        }
+        std::string valor = argv[++i];
+        
+        if (opcion == "--salida") rutaSalida = valor;
+        else if (opcion == "--desde") desde = std::atoll(valor.c_str());
+        else if (opcion == "--hasta") hasta = std::atoll(valor.c_str());
+        else { mostrarUso(argv[0]); return 1; }
+    }
+    
+    TrazaBinaria traza;
+    if (!traza.abrir(rutaTraza)) {
+        std::cerr << "Error al leer la traza " << rutaTraza << ": " << traza.getError() << std::endl;
+        return 1;
+    }
+    
+    std::ofstream archivo;
+    if (!rutaSalida.empty()) {
+        archivo.open(rutaSalida, std::ios::binary);
+        if (!archivo.is_open()) {
+            std::cerr << "Error al abrir el archivo de salida: " << rutaSalida << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& destino = rutaSalida.empty() ? std::cout : archivo;
+    
+    {
+        EscritorTexto salida(destino);
+        salida.texto("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        
+        // Metadatos: un proceso "MLFQ" con una pista por cola, en orden
+        salida.texto("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"MLFQ\"}}");
+        const std::vector<NivelTraza>& niveles = traza.getNiveles();
+        for (std::size_t n = 0; n < niveles.size(); n++) {
+            salida.texto(",\n{\"ph\":\"M\",\"pid\":1,\"tid\":");
+            salida.entero((long long)n + 1);
+            salida.texto(",\"name\":\"thread_name\",\"args\":{\"name\":");
+            cadenaJSON(salida, nombreNivel(n, niveles[n]));
+            salida.texto("}},\n{\"ph\":\"M\",\"pid\":1,\"tid\":");
+            salida.entero((long long)n + 1);
+            salida.texto(",\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":");
+            salida.entero((long long)n);
+            salida.texto("}}");
+        }
+        
+        // Una rebanada por evento
+        for (std::size_t i = buscarDesde(traza, desde); i < traza.getCantidad(); i++) {
+            RegistroRebanada r = traza.getRegistro(i);
+            if (r.inicio >= hasta) break;
+            
+            salida.texto(",\n{\"ph\":\"X\",\"pid\":1,\"tid\":");
+            salida.entero((long long)r.nivel + 1);
+            salida.texto(",\"ts\":");
+            salida.entero(r.inicio);
+            salida.texto(",\"dur\":");
+            salida.entero(r.duracion);
+            salida.texto(",\"name\":");
+            cadenaJSON(salida, traza.getEtiqueta(r.proceso));
+            salida.texto(",\"cat\":\"");
+            salida.texto(nombreMotivo(r.motivo));
+            salida.texto("\",\"args\":{\"proceso\":");
+            salida.entero(r.proceso);
+            salida.texto(",\"motivo\":\"");
+            salida.texto(nombreMotivo(r.motivo));
+            salida.texto("\"}}");
+        }
+        salida.texto("\n]}\n");
+    }
+    
+    destino.flush();
+    if (!destino) {
+        std::cerr << "Error al escribir el JSON" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,10 +1,24 @@
 #include "MLFQScheduler.h"
 #include "Proceso.h"
+#include "LectorTrazas.h"
+#include "Esquemas.h"
+#include "ArchivosSalida.h"
+#include "ModoLote.h"
+#include "Explorador.h"
+#include "MLFQMultinucleo.h"
+#include "Replicas.h"
+#include "EjecutorTareas.h"
+#include "SalidaColumnar.h"
+#include "OrdenExterno.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <chrono>
 
 /*
   Programa principal del simulador MLFQ
@@ -21,151 +35,590 @@
   Lee el archivo de entrada y crea los procesos
   
   El archivo debe tener el formato:
-  # etiqueta;BT;AT;Q;Pr
+  # etiqueta;BT;AT;Q;Pr[;E/S,CPU,...]
   A;6;0;3;5
-  B;9;0;4;4
+  B;9;0;4;4;3,2,5,1
   
   Donde cada linea (excepto comentarios con #) representa un proceso
   con su etiqueta, burst time, arrival time, cola inicial y prioridad.
+  El sexto campo, opcional, sigue la primera rafaga de CPU (BT) con pares
+  de E/S y CPU: B ejecuta 9, espera E/S 3, ejecuta 2, espera 5 y ejecuta 1.
+  
+  La lectura la hace ArchivoTrazas (archivo mapeado y parseo en paralelo);
+  aqui solo se reportan los procesos cargados y las lineas con error.
+  Las etiquetas apuntan al archivo mapeado, asi que 'trazas' debe vivir
+  mientras se use el scheduler.
+  
+  Cada proceso cargado solo se lista con verbosidad TRAZA; los errores
+  siempre se reportan.
  */
-std::vector<Proceso*> leerArchivo(const std::string& rutaArchivo) {
-    std::vector<Proceso*> procesos;
-    std::ifstream archivo(rutaArchivo);
+const std::vector<RegistroProceso>& leerArchivo(const std::string& rutaArchivo, ArchivoTrazas& trazas,
+                                                Verbosidad verbosidad) {
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "Leyendo archivo: " << rutaArchivo << std::endl;
+    }
     
-    if (!archivo.is_open()) {
+    if (!trazas.cargar(rutaArchivo)) {
         std::cerr << "Error: No se pudo abrir el archivo " << rutaArchivo << std::endl;
-        return procesos;
+        return trazas.getRegistros();
+    }
+    
+    for (std::string_view linea : trazas.getLineasInvalidas()) {
+        std::cerr << "Error al parsear linea: " << linea << std::endl;
+    }
+    
+    if (verbosidad == Verbosidad::TRAZA) {
+        for (const RegistroProceso& registro : trazas.getRegistros()) {
+            std::cout << "Proceso cargado: " << registro.etiqueta 
+                      << " (BT=" << registro.tiempoRafaga << ", AT=" << registro.tiempoLlegada 
+                      << ", Q=" << registro.cola << ", Pr=" << registro.prioridad;
+            if (!registro.rafagas.empty()) {
+                std::cout << ", E/S=" << registro.rafagas;
+            }
+            std::cout << ")" << std::endl;
+        }
+    }
+    
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "Total de procesos cargados: " << trazas.getRegistros().size() << std::endl;
+    }
+    return trazas.getRegistros();
+}
+
+/*
+  Explora configuraciones de colas para un archivo de entrada
+  
+  Argumentos opcionales despues del archivo: la metrica (wt, rt o tat) y
+  el estadistico (promedio, p95, p99 o max). Muestra los 20 mejores
+  esquemas y guarda el ranking completo en output/<archivo>_exploracion_out.txt.
+ */
+int modoExploracion(const std::string& archivoEntrada, const std::vector<std::string>& opciones) {
+    ConfiguracionExploracion config;
+    
+    for (const std::string& opcion : opciones) {
+        if (opcion == "wt") config.metrica = MetricaExploracion::WT;
+        else if (opcion == "rt") config.metrica = MetricaExploracion::RT;
+        else if (opcion == "tat") config.metrica = MetricaExploracion::TAT;
+        else if (opcion == "promedio") config.percentil = 0.0;
+        else if (opcion == "p95") config.percentil = 0.95;
+        else if (opcion == "p99") config.percentil = 0.99;
+        else if (opcion == "max") config.percentil = 1.0;
+        else {
+            std::cerr << "Error: Opcion de exploracion no valida: " << opcion << std::endl;
+            return 1;
+        }
+    }
+    
+    ArchivoTrazas trazas;
+    if (!trazas.cargar(archivoEntrada) || trazas.getRegistros().empty()) {
+        std::cerr << "Error: No se pudieron cargar procesos del archivo." << std::endl;
+        return 1;
     }
     
-    std::string linea;
-    std::cout << "Leyendo archivo: " << rutaArchivo << std::endl;
+    std::cout << "Explorando esquemas para " << archivoEntrada << " ("
+              << trazas.getRegistros().size() << " procesos)..." << std::endl;
+    std::vector<ResultadoExploracion> resultados = explorarEsquemas(trazas.getRegistros(), config);
+    
+    std::size_t podados = std::count_if(resultados.begin(), resultados.end(),
+                                        [](const ResultadoExploracion& r) { return r.podado; });
+    std::cout << "Candidatos evaluados: " << resultados.size() << " (" << podados << " podados)" << std::endl;
+    escribirRanking(std::cout, resultados, 20);
     
-    // Leer linea por linea
-    while (std::getline(archivo, linea)) {
-        // Saltar comentarios y lineas vacias
-        if (linea.empty() || linea[0] == '#') {
+    crearCarpetaSalida();
+    std::string archivoSalida = nombreArchivoSalida(archivoEntrada, "_exploracion");
+    std::ofstream salida(archivoSalida);
+    if (!salida.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << archivoSalida << std::endl;
+        return 1;
+    }
+    escribirRanking(salida, resultados);
+    std::cout << "Ranking completo en: " << archivoSalida << std::endl;
+    return 0;
+}
+
+/*
+  Modo de replicas Monte Carlo
+  
+  Los argumentos que no empiezan con "--" son esquemas (por defecto 1, 2
+  y 3); --procesos fija los procesos por replica, --hilos el tamano del
+  pool y el resto son las opciones del generador de cargas (--llegadas,
+  --rafaga, --colas, --semilla...). Muestra la media y el intervalo del
+  95% de WT, RT y TAT de cada esquema; output/replicas_out.txt guarda
+  cada replica y output/replicas_resumen_out.txt el resumen.
+ */
+int modoReplicas(const std::string& cantidad, const std::vector<std::string>& argumentos) {
+    ConfiguracionReplicas config;
+    config.replicas = std::strtoull(cantidad.c_str(), nullptr, 10);
+    if (config.replicas < 2) {
+        std::cerr << "Error: Se necesitan al menos 2 replicas para el intervalo de confianza" << std::endl;
+        return 1;
+    }
+    
+    std::vector<std::string> esquemas;
+    for (std::size_t i = 0; i < argumentos.size(); i++) {
+        const std::string& opcion = argumentos[i];
+        if (opcion.rfind("--", 0) != 0) {
+            esquemas.push_back(opcion);
             continue;
         }
-        
-        // Parsear la linea separando por punto y coma
-        std::istringstream iss(linea);
-        std::string etiqueta, bt_str, at_str, q_str, pr_str;
-        
-        if (std::getline(iss, etiqueta, ';') &&
-            std::getline(iss, bt_str, ';') &&
-            std::getline(iss, at_str, ';') &&
-            std::getline(iss, q_str, ';') &&
-            std::getline(iss, pr_str)) {
-            
-            try {
-                // Convertir strings a numeros
-                int tiempoRafaga = std::stoi(bt_str);
-                int tiempoLlegada = std::stoi(at_str);
-                int cola = std::stoi(q_str);
-                int prioridad = std::stoi(pr_str);
-                
-                // Crear el proceso y agregarlo a la lista
-                Proceso* proceso = new Proceso(etiqueta, tiempoRafaga, tiempoLlegada, cola, prioridad);
-                procesos.push_back(proceso);
-                
-                std::cout << "Proceso cargado: " << etiqueta 
-                          << " (BT=" << tiempoRafaga << ", AT=" << tiempoLlegada 
-                          << ", Q=" << cola << ", Pr=" << prioridad << ")" << std::endl;
-                          
-            } catch (const std::exception& e) {
-                std::cerr << "Error al parsear linea: " << linea << std::endl;
+        if (i + 1 >= argumentos.size()) {
+            std::cerr << "Error: Falta el valor de " << opcion << std::endl;
+            return 1;
+        }
+        const std::string& valor = argumentos[++i];
+        if (opcion == "--procesos") config.carga.cantidad = std::strtoull(valor.c_str(), nullptr, 10);
+        else if (opcion == "--hilos") config.hilos = std::strtoull(valor.c_str(), nullptr, 10);
+        else if (!leerOpcionCarga(opcion, valor, config.carga)) {
+            std::cerr << "Error: Opcion de replicas no valida: " << opcion << " " << valor << std::endl;
+            return 1;
+        }
+    }
+    if (!esquemas.empty()) {
+        config.esquemas = esquemas;
+    }
+    
+    std::cout << "Simulando " << config.replicas << " replicas de " << config.carga.cantidad
+              << " procesos con " << config.esquemas.size() << " esquemas..." << std::endl;
+    std::vector<ResumenEsquema> resumenes = ejecutarReplicas(config);
+    if (resumenes.empty()) {
+        return 1;
+    }
+    
+    std::cout << "\nMedia e intervalo de confianza del 95%:" << std::endl;
+    escribirResumenReplicas(std::cout, resumenes);
+    
+    crearCarpetaSalida();
+    std::string archivoSalida = "output/replicas_out.txt";
+    std::ofstream salida(archivoSalida);
+    if (!salida.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << archivoSalida << std::endl;
+        return 1;
+    }
+    escribirReplicas(salida, resumenes);
+    
+    std::string archivoResumen = "output/replicas_resumen_out.txt";
+    std::ofstream resumen(archivoResumen);
+    if (!resumen.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << archivoResumen << std::endl;
+        return 1;
+    }
+    escribirResumenReplicas(resumen, resumenes);
+    std::cout << "Replicas escritas en: " << archivoSalida << " (resumen en " << archivoResumen << ")" << std::endl;
+    return 0;
+}
+
+/*
+  Modo de envios concurrentes
+  
+  Cada archivo se carga y lo reproduce su propio hilo productor, que
+  envia sus procesos al scheduler mientras la simulacion corre en otro
+  hilo. Cuando todos los productores terminan se cierran los envios y
+  se espera el fin de la simulacion. Escribe
+  output/<primer archivo>_envios_out.txt y cuantos envios llegaron tarde
+  (entraron con el tiempo de la simulacion en vez de su llegada).
+ */
+int modoEnvios(const std::string& esquema, const std::vector<std::string>& archivos) {
+    std::vector<EsquemaCola> esquemas = obtenerEsquema(esquema, false);
+    if (esquemas.empty()) {
+        return 1;
+    }
+    
+    std::vector<std::unique_ptr<ArchivoTrazas>> cargas;
+    for (const std::string& archivo : archivos) {
+        cargas.emplace_back(new ArchivoTrazas());
+        if (!cargas.back()->cargar(archivo) || cargas.back()->getRegistros().empty()) {
+            std::cerr << "Error: No se pudieron cargar procesos de " << archivo << std::endl;
+            return 1;
+        }
+    }
+    
+    MLFQScheduler scheduler(esquemas);
+    scheduler.setVerbosidad(Verbosidad::NINGUNA);
+    scheduler.abrirEnvios();
+    std::thread simulacion([&scheduler] { scheduler.ejecutarSimulacion(); });
+    
+    std::vector<std::thread> productores;
+    for (const std::unique_ptr<ArchivoTrazas>& carga : cargas) {
+        productores.emplace_back([&scheduler, &carga] {
+            for (const RegistroProceso& registro : carga->getRegistros()) {
+                scheduler.enviarProceso(registro);
             }
+        });
+    }
+    for (std::thread& productor : productores) {
+        productor.join();
+    }
+    scheduler.cerrarEnvios();
+    simulacion.join();
+    
+    const ContadoresScheduler& contadores = scheduler.getContadores();
+    std::cout << "Simulacion completada en tiempo: " << scheduler.getTiempoGlobal() << std::endl;
+    std::cout << "Envios recibidos: " << contadores.enviosRecibidos
+              << " (tardios: " << contadores.enviosTardios << ")" << std::endl;
+    
+    double promWT, promCT, promRT, promTAT;
+    scheduler.calcularPromedios(promWT, promCT, promRT, promTAT);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "WT promedio: " << promWT << ", CT promedio: " << promCT
+              << ", RT promedio: " << promRT << ", TAT promedio: " << promTAT << std::endl;
+    
+    crearCarpetaSalida();
+    std::string archivoSalida = nombreArchivoSalida(archivos.front(), "_envios");
+    scheduler.escribirSalida(archivoSalida);
+    std::cout << "Resultados guardados en: " << archivoSalida << std::endl;
+    return 0;
+}
+
+// Trabajo de ejemplo: 'unidades' pasos de CPU real de 'unidad' cada uno,
+// cediendo entre un paso y el siguiente
+static Tarea trabajoSintetico(int unidades, std::chrono::microseconds unidad) {
+    for (int i = 0; i < unidades; i++) {
+        std::chrono::steady_clock::time_point fin = std::chrono::steady_clock::now() + unidad;
+        while (std::chrono::steady_clock::now() < fin) {
+        }
+        if (i + 1 < unidades) {
+            co_await ceder();
         }
     }
+}
+
+/*
+  Modo de corrutinas
+  
+  Ejecuta cada proceso del archivo como una tarea real en un
+  EjecutorTareas con el esquema dado: la tarea hace BT pasos de CPU de
+  una unidad de tiempo cada uno (cediendo entre pasos), se lanza cuando
+  pasan AT unidades desde el inicio, entra a su cola Q y declara BT como
+  estimacion para los niveles SJF/STCF. Opciones:
+  --hilos <n>                hilos trabajadores (1 por defecto)
+  --medida cedidas|tiempo    como se mide el quantum (cedidas por defecto)
+  --unidad <microsegundos>   duracion de una unidad (1000 por defecto)
+  Escribe output/<archivo>_corrutinas_out.txt con los tiempos medidos en
+  microsegundos.
+ */
+int modoCorrutinas(const std::string& esquema, const std::string& archivoEntrada,
+                   const std::vector<std::string>& argumentos) {
+    ConfiguracionEjecutor config;
+    config.hilos = 1;
+    for (std::size_t i = 0; i < argumentos.size(); i++) {
+        const std::string& opcion = argumentos[i];
+        if (i + 1 >= argumentos.size()) {
+            std::cerr << "Error: Falta el valor de " << opcion << std::endl;
+            return 1;
+        }
+        const std::string& valor = argumentos[++i];
+        if (opcion == "--hilos") {
+            config.hilos = std::strtoull(valor.c_str(), nullptr, 10);
+        } else if (opcion == "--medida" && (valor == "cedidas" || valor == "tiempo")) {
+            config.medida = valor == "tiempo" ? MedidaQuantum::TIEMPO : MedidaQuantum::CEDIDAS;
+        } else if (opcion == "--unidad" && std::atoi(valor.c_str()) > 0) {
+            config.unidad = std::chrono::microseconds(std::atoi(valor.c_str()));
+        } else {
+            std::cerr << "Error: Opcion de corrutinas no valida: " << opcion << " " << valor << std::endl;
+            return 1;
+        }
+    }
+    
+    std::vector<EsquemaCola> esquemas = obtenerEsquema(esquema, false);
+    if (esquemas.empty()) {
+        return 1;
+    }
+    ArchivoTrazas trazas;
+    if (!trazas.cargar(archivoEntrada) || trazas.getRegistros().empty()) {
+        std::cerr << "Error: No se pudieron cargar procesos de " << archivoEntrada << std::endl;
+        return 1;
+    }
+    if (trazas.tieneRafagasES()) {
+        std::cerr << "Error: El modo de corrutinas no ejecuta rafagas de E/S." << std::endl;
+        return 1;
+    }
+    
+    std::vector<RegistroProceso> registros = trazas.getRegistros();
+    std::stable_sort(registros.begin(), registros.end(), [](const RegistroProceso& a, const RegistroProceso& b) {
+        return a.tiempoLlegada < b.tiempoLlegada;
+    });
+    
+    EjecutorTareas ejecutor(esquemas, config);
+    std::cout << "Ejecutando " << registros.size() << " tareas en " << ejecutor.getCantidadHilos()
+              << " hilos..." << std::endl;
     
-    archivo.close();
-    std::cout << "Total de procesos cargados: " << procesos.size() << std::endl;
-    return procesos;
+    // Cada tarea se lanza cuando llega su tiempo
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    for (const RegistroProceso& registro : registros) {
+        std::this_thread::sleep_until(inicio + config.unidad * registro.tiempoLlegada);
+        ejecutor.lanzar(std::string(registro.etiqueta), trabajoSintetico(registro.tiempoRafaga, config.unidad),
+                        registro.cola, registro.tiempoRafaga);
+    }
+    ejecutor.esperar();
+    
+    double promWT, promCT, promRT, promTAT;
+    ejecutor.calcularPromedios(promWT, promCT, promRT, promTAT);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "WT promedio: " << promWT << " us, CT promedio: " << promCT
+              << " us, RT promedio: " << promRT << " us, TAT promedio: " << promTAT << " us" << std::endl;
+    
+    crearCarpetaSalida();
+    std::string archivoSalida = nombreArchivoSalida(archivoEntrada, "_corrutinas");
+    std::ofstream salida(archivoSalida);
+    if (!salida.is_open()) {
+        std::cerr << "Error al abrir el archivo de salida: " << archivoSalida << std::endl;
+        return 1;
+    }
+    ejecutor.escribirResultados(salida);
+    std::cout << "Resultados guardados en: " << archivoSalida << std::endl;
+    return 0;
 }
 
 /*
-  Genera el nombre del archivo de salida
+  Modo multinucleo
   
-  Crea la carpeta 'output' si no existe y genera el nombre del archivo
-  de salida basado en el archivo de entrada, agregando '_out' antes
-  de la extension.
+  Simula el archivo en K CPUs con el esquema y la politica de balanceo
+  dados (por defecto "dos"). Escribe output/<archivo>_smp_out.txt, con el
+  nucleo y las migraciones de cada proceso, y muestra los promedios y el
+  resumen por nucleo.
  */
-std::string generarNombreArchivoSalida(const std::string& archivoEntrada) {
-    // Crear carpeta output si no existe
-    #ifdef _WIN32
-        system("mkdir output 2>nul || echo."); 
-    #else
-        system("mkdir -p output");
-    #endif
-    
-    // Extraer solo el nombre del archivo sin directorio
-    std::string nombreArchivo = archivoEntrada;
-    size_t pos = nombreArchivo.find_last_of("\\/");
-    if (pos != std::string::npos) {
-        nombreArchivo = nombreArchivo.substr(pos + 1);
-    }
-    
-    // Cambiar la extension a _out.txt
-    std::string nombreSalida = "output/";
-    pos = nombreArchivo.find_last_of('.');
-    if (pos != std::string::npos) {
-        nombreSalida += nombreArchivo.substr(0, pos) + "_out.txt";
-    } else {
-        nombreSalida += nombreArchivo + "_out.txt";
-    }
-    
-    return nombreSalida;
+int modoMultinucleo(int cantidadNucleos, const std::string& archivoEntrada, const std::string& esquema,
+                    const std::string& nombreBalanceo) {
+    if (cantidadNucleos < 1 || cantidadNucleos > MapaOcupacion::MAX_NIVELES) {
+        std::cerr << "Error: Cantidad de nucleos no valida: " << cantidadNucleos << std::endl;
+        return 1;
+    }
+    std::unique_ptr<PoliticaBalanceo> balanceo = crearBalanceo(nombreBalanceo);
+    if (!balanceo) {
+        std::cerr << "Error: Balanceo no valido: " << nombreBalanceo << " (use circular o dos)" << std::endl;
+        return 1;
+    }
+    std::vector<EsquemaCola> esquemas = obtenerEsquema(esquema);
+    if (esquemas.empty()) {
+        return 1;
+    }
+    
+    ArchivoTrazas trazas;
+    if (!trazas.cargar(archivoEntrada) || trazas.getRegistros().empty()) {
+        std::cerr << "Error: No se pudieron cargar procesos del archivo." << std::endl;
+        return 1;
+    }
+    if (trazas.tieneRafagasES()) {
+        std::cerr << "Error: El modo multinucleo no simula rafagas de E/S." << std::endl;
+        return 1;
+    }
+    
+    std::cout << "Simulando " << trazas.getRegistros().size() << " procesos en " << cantidadNucleos
+              << " nucleos (balanceo " << balanceo->getNombre() << ")..." << std::endl;
+    MLFQMultinucleo simulador(esquemas, cantidadNucleos, std::move(balanceo));
+    simulador.agregarProcesos(trazas.getRegistros());
+    simulador.ejecutarSimulacion();
+    std::cout << "Simulacion completada en tiempo: " << simulador.getTiempoGlobal() << std::endl;
+    
+    double promWT, promCT, promRT, promTAT;
+    simulador.calcularPromedios(promWT, promCT, promRT, promTAT);
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "WT promedio: " << promWT << ", CT promedio: " << promCT
+              << ", RT promedio: " << promRT << ", TAT promedio: " << promTAT << std::endl;
+    std::cout << "\nNucleos:" << std::endl;
+    simulador.escribirResumenNucleos(std::cout);
+    
+    crearCarpetaSalida();
+    std::string archivoSalida = nombreArchivoSalida(archivoEntrada, "_smp");
+    if (!simulador.escribirSalida(archivoSalida)) {
+        return 1;
+    }
+    std::cout << "Resultados guardados en: " << archivoSalida << std::endl;
+    return 0;
 }
 
 /*
-  Define los esquemas de configuracion predefinidos
+  Modo en linea: procesos por la entrada estandar
   
-  Cada esquema tiene una configuracion diferente de colas y algoritmos:
+  Lee los procesos de la entrada estandar (en orden de llegada) a medida
+  que la simulacion los necesita, y escribe la linea de cada proceso
+  apenas termina, en orden de finalizacion. Al final escribe los
+  promedios. Los procesos terminados se liberan enseguida, asi la memoria
+  depende de cuantos procesos estan vivos a la vez y no del total. Los
+  percentiles se escriben al final por la salida de errores.
   
-  Esquema 1: RR(1), RR(3), RR(4), SJF
-  - Quantums pequenos en las primeras colas para detectar trabajos interactivos
-  - SJF en la ultima cola para trabajos largos
+  La salida se vacia cuando ya no hay mas entrada en el buffer (antes de
+  que la lectura tenga que esperar), para que quien lee por una tuberia
+  vea cada resultado sin hacer una escritura por linea.
   
-  Esquema 2: RR(2), RR(3), RR(4), STCF  
-  - Similar al 1 pero con STCF en lugar de SJF
+  Opciones (ademas del archivo de salida):
+  --ordenado <MB>         escribe las lineas ordenadas por etiqueta como
+                          el archivo de salida normal; se ordenan con
+                          hasta MB megabytes en memoria y lo que no cabe
+                          va a archivos temporales (ver OrdenExterno.h)
+  --columnas <archivo>    guarda tambien las filas en formato columnar
+ */
+int modoFlujo(const std::string& esquema, const std::vector<std::string>& argumentos) {
+    std::string rutaSalida;
+    std::string rutaColumnas;
+    long long megasOrden = 0;  // 0 = en orden de finalizacion
+    for (std::size_t i = 0; i < argumentos.size(); i++) {
+        if (argumentos[i] == "--ordenado" && i + 1 < argumentos.size()) {
+            megasOrden = std::max(1LL, std::atoll(argumentos[++i].c_str()));
+        } else if (argumentos[i] == "--columnas" && i + 1 < argumentos.size()) {
+            rutaColumnas = argumentos[++i];
+        } else if (rutaSalida.empty() && argumentos[i].rfind("--", 0) != 0) {
+            rutaSalida = argumentos[i];
+        } else {
+            std::cerr << "Error: Opcion no valida: " << argumentos[i] << std::endl;
+            return 1;
+        }
+    }
+    
+    std::vector<EsquemaCola> esquemas = obtenerEsquema(esquema, false);
+    if (esquemas.empty()) {
+        return 1;
+    }
+    
+    std::ofstream archivo;
+    if (!rutaSalida.empty()) {
+        archivo.open(rutaSalida);
+        if (!archivo.is_open()) {
+            std::cerr << "Error al abrir el archivo de salida: " << rutaSalida << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& destino = rutaSalida.empty() ? std::cout : archivo;
+    EscritorTexto salida(destino);
+    
+    std::unique_ptr<EscritorColumnar> columnas;
+    if (!rutaColumnas.empty()) {
+        columnas = std::make_unique<EscritorColumnar>(rutaColumnas);
+        if (!columnas->abierto()) {
+            std::cerr << "Error al abrir el archivo columnar: " << rutaColumnas << std::endl;
+            return 1;
+        }
+    }
+    std::unique_ptr<OrdenadorExterno> ordenador;
+    EscritorTexto linea(nullptr, 256);
+    if (megasOrden > 0) {
+        ordenador = std::make_unique<OrdenadorExterno>((std::size_t)megasOrden << 20);
+    }
+    
+    // Sin sincronizar con stdio, std::cin tiene buffer propio y se puede
+    // saber si la siguiente lectura va a esperar
+    std::ios::sync_with_stdio(false);
+    LectorFlujo lector(std::cin);
+    
+    MLFQScheduler scheduler(esquemas, true);
+    scheduler.setVerbosidad(Verbosidad::NINGUNA);
+    scheduler.setFuente([&](RegistroProceso& registro) {
+        if (std::cin.rdbuf()->in_avail() <= 0) {
+            salida.vaciar();
+            destino.flush();
+        }
+        return lector.siguiente(registro);
+    });
+    
+    scheduler.setAlFinalizar([&](IdProceso id) {
+        if (columnas) {
+            columnas->agregar(scheduler.getTabla(), id);
+        }
+        if (ordenador) {
+            linea.limpiar();
+            scheduler.escribirLinea(linea, id);
+            ordenador->agregar(scheduler.getTabla().getEtiqueta(id), linea.contenido());
+        } else {
+            scheduler.escribirLinea(salida, id);
+        }
+        return true;
+    });
+    
+    escribirEncabezadoSalida(salida);
+    scheduler.ejecutarSimulacion();
+    
+    int codigo = 0;
+    if (ordenador && !ordenador->terminar(salida)) {
+        std::cerr << "Error al ordenar la salida: " << ordenador->getError() << std::endl;
+        codigo = 1;
+    }
+    escribirPromediosSalida(salida, scheduler.getMetricas());
+    salida.vaciar();
+    destino.flush();
+    if (columnas && !columnas->terminar()) {
+        std::cerr << "Error al escribir el archivo columnar: " << rutaColumnas << std::endl;
+        codigo = 1;
+    }
+    
+    // Los percentiles van por la salida de errores para no mezclarlos con las lineas
+    scheduler.getMetricas().escribirPercentiles(std::cerr);
+    return codigo;
+}
+
+// Opciones de una simulacion normal (despues del archivo y el esquema)
+struct OpcionesSimulacion {
+    Verbosidad verbosidad = Verbosidad::TRAZA;
+    std::string archivoTraza;           // Vacio = la traza va a la pantalla
+    int periodoBoost = 0;               // 0 = sin boost
+    int periodoCheckpoint = 0;          // 0 = sin checkpoints
+    std::string archivoCheckpoint;
+    std::string archivoRestaurar;       // Checkpoint desde el que seguir (vacio = desde 0)
+    std::string archivoTrazaBinaria;    // Vacio = sin traza binaria
+    std::string archivoColumnas;        // Vacio = sin salida columnar
+    bool escribirContadores = false;
+    FormatoContadores formatoContadores = FormatoContadores::JSON;
+};
+
+/*
+  Lee las opciones que van despues del archivo y el esquema
   
-  Esquema 3: RR(3), RR(5), RR(6), RR(20)
-  - Solo Round Robin con quantums crecientes
+  --verbosidad ninguna|resumen|traza  cuanto se imprime (traza por defecto)
+  --traza <archivo>                   escribe la traza de rebanadas en un
+                                      archivo en vez de la pantalla
+  --boost <periodo>                   sube todo al nivel 0 cada 'periodo'
+                                      unidades de tiempo (0 = nunca)
+  --checkpoint <periodo> <archivo>    guarda el estado cada 'periodo'
+                                      unidades de tiempo
+  --restaurar <archivo>               sigue desde un checkpoint en vez de
+                                      empezar en 0
+  --traza-binaria <archivo>           guarda cada rebanada en binario
+                                      (ver herramientas/trazajson.cpp)
+  --contadores json|prometheus        escribe los contadores del motor
+                                      junto al archivo de salida
+  --columnas <archivo>                guarda tambien los resultados por
+                                      columnas (ver SalidaColumnar.h)
+  Retorna false si alguna opcion no es valida.
  */
-std::vector<EsquemaCola> obtenerEsquema(int numeroEsquema) {
-    std::vector<EsquemaCola> esquemas;
-    
-    switch (numeroEsquema) {
-        case 1:
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 1));
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 3));
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 4));
-            esquemas.push_back(EsquemaCola(TipoPolitica::SJF));
-            std::cout << "Usando Esquema 1: RR(1), RR(3), RR(4), SJF" << std::endl;
-            break;
-            
-        case 2:
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 2));
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 3));
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 4));
-            esquemas.push_back(EsquemaCola(TipoPolitica::STCF));
-            std::cout << "Usando Esquema 2: RR(2), RR(3), RR(4), STCF" << std::endl;
-            break;
-            
-        case 3:
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 3));
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 5));
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 6));
-            esquemas.push_back(EsquemaCola(TipoPolitica::ROUND_ROBIN, 20));
-            std::cout << "Usando Esquema 3: RR(3), RR(5), RR(6), RR(20)" << std::endl;
-            break;
-            
-        default:
-            std::cerr << "Error: Esquema " << numeroEsquema << " no valido. Use 1, 2 o 3." << std::endl;
-            break;
-    }
-    
-    return esquemas;
+bool leerOpciones(int argc, char* argv[], OpcionesSimulacion& opciones) {
+    for (int i = 3; i < argc; i++) {
+        std::string opcion = argv[i];
+        if (opcion == "--verbosidad" && i + 1 < argc) {
+            std::string valor = argv[++i];
+            if (valor == "ninguna") opciones.verbosidad = Verbosidad::NINGUNA;
+            else if (valor == "resumen") opciones.verbosidad = Verbosidad::RESUMEN;
+            else if (valor == "traza") opciones.verbosidad = Verbosidad::TRAZA;
+            else {
+                std::cerr << "Error: Verbosidad no valida: " << valor << std::endl;
+                return false;
+            }
+        } else if (opcion == "--traza" && i + 1 < argc) {
+            opciones.archivoTraza = argv[++i];
+        } else if (opcion == "--boost" && i + 1 < argc) {
+            opciones.periodoBoost = std::atoi(argv[++i]);
+        } else if (opcion == "--checkpoint" && i + 2 < argc) {
+            opciones.periodoCheckpoint = std::atoi(argv[++i]);
+            opciones.archivoCheckpoint = argv[++i];
+        } else if (opcion == "--restaurar" && i + 1 < argc) {
+            opciones.archivoRestaurar = argv[++i];
+        } else if (opcion == "--traza-binaria" && i + 1 < argc) {
+            opciones.archivoTrazaBinaria = argv[++i];
+        } else if (opcion == "--columnas" && i + 1 < argc) {
+            opciones.archivoColumnas = argv[++i];
+        } else if (opcion == "--contadores" && i + 1 < argc) {
+            std::string valor = argv[++i];
+            if (valor == "json") opciones.formatoContadores = FormatoContadores::JSON;
+            else if (valor == "prometheus") opciones.formatoContadores = FormatoContadores::PROMETHEUS;
+            else {
+                std::cerr << "Error: Formato de contadores no valido: " << valor << std::endl;
+                return false;
+            }
+            opciones.escribirContadores = true;
+        } else {
+            std::cerr << "Error: Opcion no valida: " << opcion << std::endl;
+            return false;
+        }
+    }
+    return true;
 }
 
 /*
@@ -174,39 +627,124 @@ std::vector<EsquemaCola> obtenerEsquema(int numeroEsquema) {
   Lee los argumentos de linea de comandos, carga los procesos del archivo,
   configura el scheduler segun el esquema seleccionado, ejecuta la simulacion
   y genera el archivo de resultados.
+  
+  Con --lote <directorio> [esquemas...] corre todos los archivos del
+  directorio contra los esquemas dados (por defecto 1, 2 y 3) en paralelo.
+  Con --explorar <archivo> [metrica] [estadistico] busca el mejor esquema.
+  Con --flujo <esquema> [salida] [opciones] simula en linea desde la
+  entrada estandar.
+  Con --smp <nucleos> <archivo> <esquema> [balanceo] simula varias CPUs.
+  Con --replicas <K> [esquemas...] [opciones] compara esquemas sobre K
+  cargas sinteticas.
+  Con --envios <esquema> <archivos...> cada archivo lo envia un hilo
+  mientras la simulacion corre.
+  Con --corrutinas <esquema> <archivo> [opciones] ejecuta los procesos
+  como corrutinas reales con la politica del esquema.
  */
 int main(int argc, char* argv[]) {
-    std::cout << "=== SIMULADOR MLFQ - SISTEMAS OPERATIVOS ===" << std::endl;
-    std::cout << "Universidad Pontificia Javeriana Cali" << std::endl;
-    std::cout << "=============================================" << std::endl;
+    // El modo en linea no imprime nada mas, para poder usarse en una tuberia
+    if (argc >= 3 && std::string(argv[1]) == "--flujo") {
+        return modoFlujo(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+    
+    bool modoSimulacion = argc >= 3 && std::string(argv[1]) != "--lote" && std::string(argv[1]) != "--explorar" &&
+                          std::string(argv[1]) != "--smp" && std::string(argv[1]) != "--replicas" &&
+                          std::string(argv[1]) != "--envios" && std::string(argv[1]) != "--corrutinas";
+    OpcionesSimulacion opciones;
+    if (modoSimulacion && !leerOpciones(argc, argv, opciones)) {
+        return 1;
+    }
+    Verbosidad verbosidad = opciones.verbosidad;
+    
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "=== SIMULADOR MLFQ - SISTEMAS OPERATIVOS ===" << std::endl;
+        std::cout << "Universidad Pontificia Javeriana Cali" << std::endl;
+        std::cout << "=============================================" << std::endl;
+    }
+    
+    // Modo lote: varios archivos y esquemas en paralelo
+    if (argc >= 3 && std::string(argv[1]) == "--lote") {
+        std::vector<int> numerosEsquema;
+        for (int i = 3; i < argc; i++) {
+            numerosEsquema.push_back(std::atoi(argv[i]));
+        }
+        if (numerosEsquema.empty()) {
+            numerosEsquema = {1, 2, 3};
+        }
+        return ejecutarLote(argv[2], numerosEsquema);
+    }
+    
+    // Exploracion de esquemas
+    if (argc >= 3 && std::string(argv[1]) == "--explorar") {
+        return modoExploracion(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+    
+    // Simulacion de varias CPUs
+    if (argc >= 5 && std::string(argv[1]) == "--smp") {
+        return modoMultinucleo(std::atoi(argv[2]), argv[3], argv[4], argc >= 6 ? argv[5] : "dos");
+    }
+    
+    // Replicas Monte Carlo sobre cargas sinteticas
+    if (argc >= 3 && std::string(argv[1]) == "--replicas") {
+        return modoReplicas(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+    
+    // Envios concurrentes desde varios hilos productores
+    if (argc >= 4 && std::string(argv[1]) == "--envios") {
+        return modoEnvios(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+    
+    // Tareas reales (corrutinas) planificadas con el esquema
+    if (argc >= 4 && std::string(argv[1]) == "--corrutinas") {
+        return modoCorrutinas(argv[2], argv[3], std::vector<std::string>(argv + 4, argv + argc));
+    }
     
     // Verificar argumentos
-    if (argc != 3) {
-        std::cerr << "Uso: " << argv[0] << " <archivo_entrada> <numero_esquema>" << std::endl;
+    if (!modoSimulacion) {
+        std::cerr << "Uso: " << argv[0] << " <archivo_entrada> <numero_esquema|archivo_esquema>"
+                  << " [--verbosidad ninguna|resumen|traza] [--traza <archivo>] [--boost <periodo>]"
+                  << " [--checkpoint <periodo> <archivo>] [--restaurar <archivo>] [--traza-binaria <archivo>]"
+                  << " [--contadores json|prometheus] [--columnas <archivo>]" << std::endl;
+        std::cerr << "     " << argv[0] << " --lote <directorio> [esquemas...]" << std::endl;
+        std::cerr << "     " << argv[0] << " --explorar <archivo> [wt|rt|tat] [promedio|p95|p99|max]" << std::endl;
+        std::cerr << "     " << argv[0] << " --flujo <numero_esquema|archivo_esquema> [archivo_salida]"
+                  << " [--ordenado MB] [--columnas archivo] < procesos" << std::endl;
+        std::cerr << "     " << argv[0] << " --smp <nucleos> <archivo> <esquema> [circular|dos]" << std::endl;
+        std::cerr << "     " << argv[0] << " --replicas <K> [esquemas...] [--procesos n] [--hilos n] [opciones del generador]" << std::endl;
+        std::cerr << "     " << argv[0] << " --envios <numero_esquema|archivo_esquema> <archivo> [archivos...]" << std::endl;
+        std::cerr << "     " << argv[0] << " --corrutinas <numero_esquema|archivo_esquema> <archivo>"
+                  << " [--hilos n] [--medida cedidas|tiempo] [--unidad microsegundos]" << std::endl;
         std::cerr << "Esquemas disponibles:" << std::endl;
         std::cerr << "  1: RR(1), RR(3), RR(4), SJF" << std::endl;
         std::cerr << "  2: RR(2), RR(3), RR(4), STCF" << std::endl;
         std::cerr << "  3: RR(3), RR(5), RR(6), RR(20)" << std::endl;
+        std::cerr << "  o un archivo con los niveles, por ejemplo: RR(1)*16, RR(2)*16, RR(4)*31, STCF" << std::endl;
         return 1;
     }
     
     std::string archivoEntrada = argv[1];
-    int numeroEsquema = std::atoi(argv[2]);
+    std::string esquema = argv[2];
     
-    std::cout << "\nParametros de simulacion:" << std::endl;
-    std::cout << "Archivo de entrada: " << archivoEntrada << std::endl;
-    std::cout << "Numero de esquema: " << numeroEsquema << std::endl;
+    if (verbosidad >= Verbosidad::RESUMEN) {
+        std::cout << "\nParametros de simulacion:" << std::endl;
+        std::cout << "Archivo de entrada: " << archivoEntrada << std::endl;
+        std::cout << "Esquema: " << esquema << std::endl;
+    }
     
     try {
-        // Cargar procesos del archivo
-        std::vector<Proceso*> procesos = leerArchivo(archivoEntrada);
-        if (procesos.empty()) {
-            std::cerr << "Error: No se pudieron cargar procesos del archivo." << std::endl;
-            return 1;
+        // Cargar procesos del archivo (al restaurar salen del checkpoint)
+        ArchivoTrazas trazas;
+        const std::vector<RegistroProceso>* procesos = nullptr;
+        if (opciones.archivoRestaurar.empty()) {
+            procesos = &leerArchivo(archivoEntrada, trazas, verbosidad);
+            if (procesos->empty()) {
+                std::cerr << "Error: No se pudieron cargar procesos del archivo." << std::endl;
+                return 1;
+            }
         }
         
         // Obtener configuracion del esquema
-        std::vector<EsquemaCola> esquemas = obtenerEsquema(numeroEsquema);
+        std::vector<EsquemaCola> esquemas = obtenerEsquema(esquema, verbosidad >= Verbosidad::RESUMEN);
         if (esquemas.empty()) {
             std::cerr << "Error: Esquema no valido." << std::endl;
             return 1;
@@ -214,15 +752,47 @@ int main(int argc, char* argv[]) {
         
         // Crear el scheduler con la configuracion
         MLFQScheduler scheduler(esquemas);
+        scheduler.setVerbosidad(verbosidad);
+        scheduler.setPeriodoBoost(opciones.periodoBoost);
+        if (opciones.periodoCheckpoint > 0) {
+            scheduler.setCheckpoint(opciones.periodoCheckpoint, opciones.archivoCheckpoint);
+        }
+        if (!opciones.archivoTrazaBinaria.empty()) {
+            scheduler.setTrazaBinaria(opciones.archivoTrazaBinaria);
+        }
         
-        // Agregar todos los procesos al scheduler
-        std::cout << "\nAgregando procesos al scheduler..." << std::endl;
-        for (Proceso* proceso : procesos) {
-            scheduler.agregarProceso(proceso);
+        // La traza puede ir a un archivo en vez de la pantalla
+        std::ofstream salidaTraza;
+        if (!opciones.archivoTraza.empty()) {
+            salidaTraza.open(opciones.archivoTraza);
+            if (!salidaTraza.is_open()) {
+                std::cerr << "Error al abrir el archivo de traza: " << opciones.archivoTraza << std::endl;
+                return 1;
+            }
+            scheduler.setDestinoTraza(salidaTraza);
+        }
+        
+        if (procesos) {
+            // Agregar todos los procesos al scheduler de una sola vez
+            if (verbosidad >= Verbosidad::RESUMEN) {
+                std::cout << "\nAgregando procesos al scheduler..." << std::endl;
+            }
+            scheduler.agregarProcesos(*procesos);
+        } else {
+            // Seguir desde el checkpoint (con el boost con el que se guardo)
+            if (!scheduler.cargarCheckpoint(opciones.archivoRestaurar)) {
+                return 1;
+            }
+            if (verbosidad >= Verbosidad::RESUMEN) {
+                std::cout << "\nRestaurado desde " << opciones.archivoRestaurar << " en tiempo "
+                          << scheduler.getTiempoGlobal() << std::endl;
+            }
         }
         
         // Ejecutar la simulacion
-        std::cout << "\n=== INICIANDO SIMULACION ===" << std::endl;
+        if (verbosidad >= Verbosidad::RESUMEN) {
+            std::cout << "\n=== INICIANDO SIMULACION ===" << std::endl;
+        }
         scheduler.ejecutarSimulacion();
         
         // Mostrar resultados
@@ -231,9 +801,19 @@ int main(int argc, char* argv[]) {
         // Generar archivo de salida
         std::string archivoSalida = generarNombreArchivoSalida(archivoEntrada);
         scheduler.escribirSalida(archivoSalida);
+        if (!opciones.archivoColumnas.empty()) {
+            scheduler.escribirColumnas(opciones.archivoColumnas);
+        }
+        scheduler.escribirMetricas(nombreArchivoSalida(archivoEntrada, "_metricas"));
+        if (opciones.escribirContadores) {
+            scheduler.escribirContadores(nombreArchivoSalida(archivoEntrada, "_contadores"),
+                                         opciones.formatoContadores);
+        }
         
-        std::cout << "\n=== SIMULACION COMPLETADA EXITOSAMENTE ===" << std::endl;
-        std::cout << "Resultados guardados en: " << archivoSalida << std::endl;
+        if (verbosidad >= Verbosidad::RESUMEN) {
+            std::cout << "\n=== SIMULACION COMPLETADA EXITOSAMENTE ===" << std::endl;
+            std::cout << "Resultados guardados en: " << archivoSalida << std::endl;
+        }
         
     } catch (const std::exception& e) {
         std::cerr << "Error durante la simulacion: " << e.what() << std::endl;
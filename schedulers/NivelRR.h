@@ -0,0 +1,27 @@
+#ifndef NIVELRR_H
+#define NIVELRR_H
+
+#include "PoliticaNivel.h"
+#include <algorithm>
+
+/*
+  Politica NivelRR<Q>
+  
+  Round Robin con quantum fijo Q. Los procesos se atienden en orden FIFO,
+  cada uno ejecuta maximo Q unidades (o lo que le falte, si es menos), y
+  si no termina baja al siguiente nivel del MLFQ.
+ */
+template <int Q>
+struct NivelRR {
+    static_assert(Q > 0, "El quantum de Round Robin debe ser positivo");
+    
+    typedef ColaFIFO Cola;
+    static constexpr TipoPolitica politica = TipoPolitica::ROUND_ROBIN;
+    static constexpr bool expropiativa = false;
+    static constexpr bool degrada = true;
+    static constexpr int quantum = Q;
+    
+    static int rebanada(int restante, int) { return std::min(Q, restante); }
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef NIVELSJF_H
+#define NIVELSJF_H
+
+#include "PoliticaNivel.h"
+
+/*
+  Politica NivelSJF
+  
+  Shortest Job First no expropiativo: siempre escoge el proceso con menor
+  tiempo restante (desempatando por llegada) y lo ejecuta hasta terminar.
+ */
+struct NivelSJF {
+    typedef ColaPorRestante Cola;
+    static constexpr TipoPolitica politica = TipoPolitica::SJF;
+    static constexpr bool expropiativa = false;
+    static constexpr bool degrada = false;
+    
+    static int rebanada(int restante, int) { return restante; }
+};
+
+#endif
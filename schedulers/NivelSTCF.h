@@ -0,0 +1,33 @@
+#ifndef NIVELSTCF_H
+#define NIVELSTCF_H
+
+#include "PoliticaNivel.h"
+#include <algorithm>
+
+/*
+  Politica NivelSTCF
+  
+  Shortest Time-to-Completion First: como SJF pero expropiativo. El
+  proceso con menor tiempo restante ejecuta hasta terminar o hasta el
+  limite de expropiacion (el primer evento que lo desplazaria), y si no
+  termina vuelve a esta misma cola para competir con el que llego.
+ */
+struct NivelSTCF {
+    typedef ColaPorRestante Cola;
+    static constexpr TipoPolitica politica = TipoPolitica::STCF;
+    static constexpr bool expropiativa = true;
+    static constexpr bool degrada = false;
+    
+    static int rebanada(int restante, int limite) { return std::min(restante, limite); }
+    
+    // true si un proceso que entra a este nivel con (restante, llegada)
+    // debe ejecutar antes que el que esta ejecutando, al que en ese
+    // instante le quedan 'restantePropio' unidades: el orden de
+    // ColaPorRestante, y a igual clave gana el que ya estaba (volvio a la
+    // cola antes)
+    static bool desplaza(int restante, int llegada, int restantePropio, int llegadaPropia) {
+        return restante < restantePropio || (restante == restantePropio && llegada < llegadaPropia);
+    }
+};
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef POLITICANIVEL_H
+#define POLITICANIVEL_H
+
+#include "../ColaNivel.h"
+#include <concepts>
+#include <memory_resource>
+
+/*
+  Concepto PoliticaNivel
+  
+  Lo que el MLFQ en tiempo de compilacion (MLFQ<Niveles...>) necesita de
+  la politica de un nivel. Todo es estatico: la politica es solo un tipo,
+  asi que el despacho de cada rebanada se resuelve al compilar y no se
+  crea ningun objeto por rebanada.
+  
+  - Cola: estructura de procesos listos, construible con un memory_resource.
+  - politica: el TipoPolitica equivalente del scheduler en tiempo de ejecucion.
+  - expropiativa: la rebanada se corta en la primera llegada que
+    desplazaria al proceso (STCF); estas politicas tambien dan
+    desplaza(restante, llegada, restantePropio, llegadaPropia).
+  - degrada: si el proceso no termina baja al siguiente nivel; si no,
+    vuelve a este mismo.
+  - rebanada(restante, limite): cuanto ejecuta el proceso, dado su tiempo
+    restante y el limite de expropiacion (solo lo usan las expropiativas).
+ */
+template <typename P>
+concept PoliticaNivel = requires(int restante, int limite) {
+    typename P::Cola;
+    { P::politica } -> std::convertible_to<TipoPolitica>;
+    { P::expropiativa } -> std::convertible_to<bool>;
+    { P::degrada } -> std::convertible_to<bool>;
+    { P::rebanada(restante, limite) } -> std::same_as<int>;
+} && std::constructible_from<typename P::Cola, std::pmr::memory_resource*>;
+
+#endif